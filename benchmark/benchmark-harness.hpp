@@ -0,0 +1,423 @@
+//
+// Copyright (c) 2018 CNRS
+//
+
+#ifndef __pinocchio_benchmark_harness_hpp__
+#define __pinocchio_benchmark_harness_hpp__
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "perf-counters.hpp"
+
+namespace pinocchio
+{
+  namespace benchmark
+  {
+    ///
+    /// \brief Summary statistics of a set of timing samples.
+    ///
+    struct Statistics
+    {
+      Statistics()
+      : min(0.), median(0.), mean(0.), p99(0.), max(0.), stddev(0.)
+      {}
+
+      static Statistics compute(std::vector<double> samples)
+      {
+        Statistics stats;
+        if(samples.empty()) return stats;
+
+        std::sort(samples.begin(),samples.end());
+        const size_t n = samples.size();
+
+        stats.min = samples.front();
+        stats.max = samples.back();
+        stats.median = (n % 2) ? samples[n/2] : 0.5*(samples[n/2-1] + samples[n/2]);
+        stats.p99 = samples[percentileIndex(n,0.99)];
+
+        double sum = 0.;
+        for(size_t k = 0; k < n; ++k) sum += samples[k];
+        stats.mean = sum / (double)n;
+
+        double sq_sum = 0.;
+        for(size_t k = 0; k < n; ++k) sq_sum += (samples[k] - stats.mean)*(samples[k] - stats.mean);
+        stats.stddev = n > 1 ? std::sqrt(sq_sum / (double)(n-1)) : 0.;
+
+        return stats;
+      }
+
+      /// \brief Nearest-rank index of the percentile p in a sorted set of n samples.
+      static size_t percentileIndex(const size_t n, const double p)
+      {
+        const size_t rank = (size_t)std::ceil(p * (double)n);
+        return std::min(std::max(rank,(size_t)1),n) - 1;
+      }
+
+      double min, median, mean, p99, max, stddev;
+    };
+
+    ///
+    /// \brief Timings of one algorithm on one model. All the times are given in nanoseconds per call.
+    ///
+    struct Result
+    {
+      Result() : nq(0), nv(0), njoints(0), batch(0), has_perf(false) {}
+
+      std::string model;
+      std::string algorithm;
+      int nq, nv, njoints;
+
+      /// \brief Number of calls timed together within a single sample.
+      size_t batch;
+
+      Statistics time;
+
+      /// \brief Hardware counters per call, only filled when has_perf is true.
+      bool has_perf;
+      PerfSample perf;
+
+      ///
+      /// \brief Hardware counters per call divided by the number of joints of the model (njoints-1).
+      ///        It is a normalisation to compare models of different sizes, not the cost of a joint visit:
+      ///        it includes the work done outside the joint loops.
+      ///
+      PerfSample perfPerCallOverJoints() const { return perf / (double)std::max(njoints-1,1); }
+
+      std::string name() const { return model + "/" + algorithm; }
+    };
+
+    ///
+    /// \brief Options of the benchmark runner, parsed from the command line.
+    ///
+    struct Options
+    {
+      Options()
+      : warmup(50), samples(500), min_sample_time(2000.)
+      , threshold(0.1), perf(false)
+      {}
+
+      static void usage(const char * application_name, std::ostream & os = std::cerr)
+      {
+        os << "Usage: " << application_name << " [options]" << std::endl;
+        os << "  --samples <n>             number of timing samples per benchmark (default 500)" << std::endl;
+        os << "  --warmup <n>              number of discarded samples before timing (default 50)" << std::endl;
+        os << "  --min-sample-time <ns>    minimal duration of a sample, calls are batched to reach it (default 2000)" << std::endl;
+        os << "  --filter <pattern>        only runs the benchmarks whose name model/algorithm contains pattern" << std::endl;
+        os << "  --json <file>             writes the results in JSON format" << std::endl;
+        os << "  --compare <file>          compares the medians against a JSON file written by --json" << std::endl;
+        os << "  --threshold <ratio>       relative slow down considered as a regression (default 0.1)" << std::endl;
+        os << "  --perf                    also reads the hardware performance counters (Linux only)" << std::endl;
+      }
+
+      ///
+      /// \brief Parses the command line. Unknown arguments are appended to remaining_arguments.
+      ///
+      bool parse(int argc, const char ** argv)
+      {
+        for(int i = 1; i < argc; ++i)
+        {
+          const std::string arg(argv[i]);
+          const bool has_value = i+1 < argc;
+          if(arg == "-h" || arg == "--help")
+            return false;
+          else if(arg == "--samples" && has_value)
+            samples = (size_t)std::atol(argv[++i]);
+          else if(arg == "--warmup" && has_value)
+            warmup = (size_t)std::atol(argv[++i]);
+          else if(arg == "--min-sample-time" && has_value)
+            min_sample_time = std::atof(argv[++i]);
+          else if(arg == "--filter" && has_value)
+            filter = argv[++i];
+          else if(arg == "--json" && has_value)
+            json = argv[++i];
+          else if(arg == "--compare" && has_value)
+            compare = argv[++i];
+          else if(arg == "--threshold" && has_value)
+            threshold = std::atof(argv[++i]);
+          else if(arg == "--perf")
+            perf = true;
+          else
+            remaining_arguments.push_back(arg);
+        }
+        return samples > 0;
+      }
+
+      size_t warmup, samples;
+      double min_sample_time;
+      std::string filter, json, compare;
+      double threshold;
+      bool perf;
+      std::vector<std::string> remaining_arguments;
+    };
+
+    ///
+    /// \brief Times a set of algorithms and reports robust statistics of their latency.
+    ///
+    /// \details Each benchmark is a functor taking the index of the input to use, so that the timed calls
+    ///          cycle through a set of precomputed inputs. Calls are grouped into batches long enough to
+    ///          make the clock resolution negligible, and each batch gives one sample of the time per call.
+    ///          With options.perf, the hardware counters are then read over a separate run of the same
+    ///          number of calls, without any clock read in between.
+    ///
+    struct Runner
+    {
+      typedef std::chrono::steady_clock Clock;
+
+      Runner(const Options & options, const size_t num_inputs)
+      : options(options), num_inputs(num_inputs)
+      {
+        if(options.perf && !counters.open())
+          std::cerr << "Warning: the hardware performance counters are not available "
+                    << "(check /proc/sys/kernel/perf_event_paranoid)" << std::endl;
+      }
+
+      /// \brief Whether the hardware counters are read and reported.
+      bool perfEnabled() const { return counters.isOpen(); }
+
+      bool enabled(const std::string & name) const
+      { return options.filter.empty() || name.find(options.filter) != std::string::npos; }
+
+      ///
+      /// \brief Runs and records the benchmark of algorithm on model.
+      ///
+      /// \param[in] f Functor called as f(k) with k the index of the input (k < num_inputs).
+      ///
+      template<typename Model, typename Functor>
+      void run(const std::string & model_name, const Model & model,
+               const std::string & algorithm, Functor f)
+      {
+        Result res;
+        res.model = model_name; res.algorithm = algorithm;
+        res.nq = model.nq; res.nv = model.nv; res.njoints = model.njoints;
+
+        if(!enabled(res.name())) return;
+
+        size_t k = 0;
+        res.batch = calibrate(f,k);
+
+        for(size_t s = 0; s < options.warmup; ++s)
+          sample(f,k,res.batch);
+
+        std::vector<double> samples(options.samples);
+        for(size_t s = 0; s < options.samples; ++s)
+          samples[s] = sample(f,k,res.batch) / (double)res.batch;
+
+        res.time = Statistics::compute(samples);
+
+        if(perfEnabled())
+        {
+          const size_t num_calls = options.samples * res.batch;
+          counters.start();
+          for(size_t c = 0; c < num_calls; ++c)
+          {
+            f(k);
+            if(++k == num_inputs) k = 0;
+          }
+          res.perf = counters.stop() / (double)num_calls;
+          res.has_perf = true;
+        }
+
+        results.push_back(res);
+
+        print(std::cout,res);
+      }
+
+      void printHeader(std::ostream & os) const
+      {
+        os << std::left << std::setw(28) << "model" << std::setw(36) << "algorithm"
+           << std::right << std::setw(12) << "median (us)" << std::setw(12) << "p99 (us)"
+           << std::setw(12) << "min (us)" << std::setw(12) << "stddev (us)";
+        if(perfEnabled())
+          os << std::setw(12) << "cycles" << std::setw(14) << "cycles/njoints" << std::setw(8) << "IPC"
+             << std::setw(12) << "L1D miss" << std::setw(12) << "LLC miss" << std::setw(12) << "br miss";
+        os << std::endl;
+      }
+
+      static void print(std::ostream & os, const Result & res)
+      {
+        os << std::left << std::setw(28) << res.model << std::setw(36) << res.algorithm
+           << std::right << std::fixed << std::setprecision(3)
+           << std::setw(12) << res.time.median*1e-3 << std::setw(12) << res.time.p99*1e-3
+           << std::setw(12) << res.time.min*1e-3 << std::setw(12) << res.time.stddev*1e-3;
+        if(res.has_perf)
+        {
+          // Counters per call (and per call divided by njoints), unavailable events are printed as -
+          os << std::setprecision(1);
+          printCounter(os,res.perf,PERF_CYCLES,12);
+          printCounter(os,res.perfPerCallOverJoints(),PERF_CYCLES,14);
+          if(res.perf.ipc() >= 0.) os << std::setw(8) << std::setprecision(2) << res.perf.ipc() << std::setprecision(1);
+          else os << std::setw(8) << "-";
+          printCounter(os,res.perf,PERF_L1D_MISSES,12);
+          printCounter(os,res.perf,PERF_LLC_MISSES,12);
+          printCounter(os,res.perf,PERF_BRANCH_MISSES,12);
+        }
+        os << std::endl;
+      }
+
+      ///
+      /// \brief Writes the results in JSON format, one benchmark per line.
+      ///
+      void writeJSON(std::ostream & os) const
+      {
+        os << "{" << std::endl;
+        os << "  \"context\": { \"samples\": " << options.samples
+           << ", \"warmup\": " << options.warmup
+           << ", \"min_sample_time_ns\": " << options.min_sample_time << " }," << std::endl;
+        os << "  \"benchmarks\": [" << std::endl;
+        for(size_t k = 0; k < results.size(); ++k)
+        {
+          const Result & res = results[k];
+          os << std::setprecision(17)
+             << "    { \"model\": \"" << res.model << "\", \"algorithm\": \"" << res.algorithm << "\""
+             << ", \"nq\": " << res.nq << ", \"nv\": " << res.nv << ", \"njoints\": " << res.njoints
+             << ", \"batch\": " << res.batch
+             << ", \"min_ns\": " << res.time.min << ", \"median_ns\": " << res.time.median
+             << ", \"mean_ns\": " << res.time.mean << ", \"p99_ns\": " << res.time.p99
+             << ", \"max_ns\": " << res.time.max << ", \"stddev_ns\": " << res.time.stddev;
+          if(res.has_perf)
+          {
+            const PerfSample per_njoints = res.perfPerCallOverJoints();
+            for(int e = 0; e < PERF_NUM_EVENTS; ++e)
+            {
+              if(!res.perf.available((PerfEvent)e)) continue;
+              os << ", \"" << perfEventName((PerfEvent)e) << "\": " << res.perf.values[e]
+                 << ", \"" << perfEventName((PerfEvent)e) << "_over_njoints\": " << per_njoints.values[e];
+            }
+          }
+          os << " }" << (k+1 < results.size() ? "," : "") << std::endl;
+        }
+        os << "  ]" << std::endl;
+        os << "}" << std::endl;
+      }
+
+      ///
+      /// \brief Reads the results written by writeJSON.
+      ///
+      /// \remarks This is not a general JSON parser: it relies on the one benchmark per line layout of writeJSON.
+      ///
+      static std::vector<Result> readJSON(std::istream & is)
+      {
+        std::vector<Result> res;
+        std::string line;
+        while(std::getline(is,line))
+        {
+          if(line.find("\"algorithm\"") == std::string::npos) continue;
+
+          Result r;
+          r.model = readString(line,"model");
+          r.algorithm = readString(line,"algorithm");
+          r.nq = (int)readNumber(line,"nq");
+          r.nv = (int)readNumber(line,"nv");
+          r.njoints = (int)readNumber(line,"njoints");
+          r.batch = (size_t)readNumber(line,"batch");
+          r.time.min = readNumber(line,"min_ns");
+          r.time.median = readNumber(line,"median_ns");
+          r.time.mean = readNumber(line,"mean_ns");
+          r.time.p99 = readNumber(line,"p99_ns");
+          r.time.max = readNumber(line,"max_ns");
+          r.time.stddev = readNumber(line,"stddev_ns");
+          res.push_back(r);
+        }
+        return res;
+      }
+
+      ///
+      /// \brief Compares the medians of the current results with the ones of a baseline.
+      ///
+      /// \return The number of benchmarks whose median is slower than the baseline by more than options.threshold.
+      ///
+      size_t compare(const std::vector<Result> & baseline, std::ostream & os) const
+      {
+        std::map<std::string,const Result *> reference;
+        for(size_t k = 0; k < baseline.size(); ++k)
+          reference[baseline[k].name()] = &baseline[k];
+
+        size_t num_regressions = 0;
+        for(size_t k = 0; k < results.size(); ++k)
+        {
+          const Result & res = results[k];
+          const std::map<std::string,const Result *>::const_iterator it = reference.find(res.name());
+          if(it == reference.end() || it->second->time.median <= 0.) continue;
+
+          const double ratio = res.time.median / it->second->time.median - 1.;
+          if(ratio > options.threshold)
+          {
+            ++num_regressions;
+            os << "REGRESSION " << res.name() << ": median " << std::fixed << std::setprecision(3)
+               << res.time.median*1e-3 << " us vs " << it->second->time.median*1e-3 << " us ("
+               << std::showpos << 100.*ratio << std::noshowpos << "%)" << std::endl;
+          }
+        }
+        return num_regressions;
+      }
+
+      const Options options;
+      const size_t num_inputs;
+      std::vector<Result> results;
+
+    protected:
+
+      PerfCounters counters;
+
+      static void printCounter(std::ostream & os, const PerfSample & perf, const PerfEvent event, const int width)
+      {
+        if(perf.available(event)) os << std::setw(width) << perf.values[event];
+        else os << std::setw(width) << "-";
+      }
+
+      /// \brief Duration in nanoseconds of batch calls of f, cycling through the inputs from k.
+      template<typename Functor>
+      double sample(Functor & f, size_t & k, const size_t batch)
+      {
+        const Clock::time_point t0 = Clock::now();
+        for(size_t b = 0; b < batch; ++b)
+        {
+          f(k);
+          if(++k == num_inputs) k = 0;
+        }
+        const Clock::time_point t1 = Clock::now();
+        return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1-t0).count();
+      }
+
+      /// \brief Smallest power of two number of calls lasting at least options.min_sample_time.
+      template<typename Functor>
+      size_t calibrate(Functor & f, size_t & k)
+      {
+        size_t batch = 1;
+        while(batch < (1 << 20) && sample(f,k,batch) < options.min_sample_time)
+          batch *= 2;
+        return batch;
+      }
+
+      static std::string readString(const std::string & line, const std::string & key)
+      {
+        const std::string pattern = "\"" + key + "\": \"";
+        const size_t begin = line.find(pattern);
+        if(begin == std::string::npos) return "";
+        const size_t end = line.find('"',begin + pattern.size());
+        return line.substr(begin + pattern.size(), end - begin - pattern.size());
+      }
+
+      static double readNumber(const std::string & line, const std::string & key)
+      {
+        const std::string pattern = "\"" + key + "\": ";
+        const size_t begin = line.find(pattern);
+        if(begin == std::string::npos) return 0.;
+        return std::atof(line.c_str() + begin + pattern.size());
+      }
+    };
+
+  } // namespace benchmark
+} // namespace pinocchio
+
+#endif // ifndef __pinocchio_benchmark_harness_hpp__
@@ -0,0 +1,200 @@
+//
+// Copyright (c) 2018 CNRS
+//
+
+#ifndef __pinocchio_benchmark_perf_counters_hpp__
+#define __pinocchio_benchmark_perf_counters_hpp__
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+  #include <unistd.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <linux/perf_event.h>
+#endif
+
+namespace pinocchio
+{
+  namespace benchmark
+  {
+    ///
+    /// \brief Hardware events counted by PerfCounters.
+    ///
+    enum PerfEvent
+    {
+      PERF_CYCLES = 0,
+      PERF_INSTRUCTIONS,
+      PERF_L1D_MISSES,
+      PERF_LLC_MISSES,
+      PERF_BRANCH_MISSES,
+      PERF_NUM_EVENTS
+    };
+
+    inline const char * perfEventName(const PerfEvent event)
+    {
+      static const char * names[PERF_NUM_EVENTS] =
+      { "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses" };
+      return names[event];
+    }
+
+    ///
+    /// \brief Values of the hardware counters accumulated over a measurement.
+    ///
+    /// \details A negative value means that the event is not supported by the processor or the kernel.
+    ///
+    struct PerfSample
+    {
+      PerfSample() { for(int k = 0; k < PERF_NUM_EVENTS; ++k) values[k] = -1.; }
+
+      bool available(const PerfEvent event) const { return values[event] >= 0.; }
+
+      /// \brief Instructions per cycle, or a negative value when not available.
+      double ipc() const
+      {
+        if(!available(PERF_CYCLES) || !available(PERF_INSTRUCTIONS) || values[PERF_CYCLES] <= 0.) return -1.;
+        return values[PERF_INSTRUCTIONS] / values[PERF_CYCLES];
+      }
+
+      /// \brief Counters divided by n, e.g. the number of calls or of visited joints.
+      PerfSample operator/(const double n) const
+      {
+        PerfSample res;
+        for(int k = 0; k < PERF_NUM_EVENTS; ++k)
+          res.values[k] = values[k] >= 0. ? values[k] / n : -1.;
+        return res;
+      }
+
+      double values[PERF_NUM_EVENTS];
+    };
+
+    ///
+    /// \brief Reads the hardware performance counters of the calling thread through perf_event_open.
+    ///
+    /// \details The events are opened as a single group, the first available one being the leader, so that
+    ///          the kernel schedules them together on the processor and all the values cover the same instructions.
+    ///          Ratios such as the IPC are thus meaningful. The counters only count in user space. When the group is
+    ///          multiplexed with other groups, the values are scaled by the ratio between the time the group was
+    ///          enabled and the time it was actually counted.
+    ///
+    /// \remarks Only available on Linux. Depending on /proc/sys/kernel/perf_event_paranoid, some or all of the
+    ///          events may not be accessible; open() then returns false and the unavailable events are reported
+    ///          with negative values. If the processor has not enough counters to schedule the whole group,
+    ///          all the events are reported as unavailable.
+    ///
+    class PerfCounters
+    {
+    public:
+
+      PerfCounters() : m_leader(-1) { for(int k = 0; k < PERF_NUM_EVENTS; ++k) m_fd[k] = -1; }
+      ~PerfCounters() { close(); }
+
+      /// \brief Opens the counters. Returns true if at least one of them is available.
+      bool open()
+      {
+#ifdef __linux__
+        close();
+        const uint64_t l1d_read_miss = PERF_COUNT_HW_CACHE_L1D
+                                     | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                     | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        openEvent(PERF_CYCLES,PERF_TYPE_HARDWARE,PERF_COUNT_HW_CPU_CYCLES);
+        openEvent(PERF_INSTRUCTIONS,PERF_TYPE_HARDWARE,PERF_COUNT_HW_INSTRUCTIONS);
+        openEvent(PERF_L1D_MISSES,PERF_TYPE_HW_CACHE,l1d_read_miss);
+        openEvent(PERF_LLC_MISSES,PERF_TYPE_HARDWARE,PERF_COUNT_HW_CACHE_MISSES);
+        openEvent(PERF_BRANCH_MISSES,PERF_TYPE_HARDWARE,PERF_COUNT_HW_BRANCH_MISSES);
+#endif
+        return isOpen();
+      }
+
+      bool isOpen() const { return m_leader >= 0; }
+
+      void close()
+      {
+#ifdef __linux__
+        // the members of the group first, then the leader
+        for(size_t k = m_group.size(); k > 0; --k)
+          ::close(m_fd[m_group[k-1]]);
+#endif
+        for(int k = 0; k < PERF_NUM_EVENTS; ++k) m_fd[k] = -1;
+        m_group.clear();
+        m_leader = -1;
+      }
+
+      /// \brief Resets and starts the counters.
+      void start()
+      {
+#ifdef __linux__
+        if(!isOpen()) return;
+        ioctl(m_leader,PERF_EVENT_IOC_RESET,PERF_IOC_FLAG_GROUP);
+        ioctl(m_leader,PERF_EVENT_IOC_ENABLE,PERF_IOC_FLAG_GROUP);
+#endif
+      }
+
+      /// \brief Stops the counters and returns their values since the last call to start().
+      PerfSample stop()
+      {
+        PerfSample res;
+#ifdef __linux__
+        if(!isOpen()) return res;
+        ioctl(m_leader,PERF_EVENT_IOC_DISABLE,PERF_IOC_FLAG_GROUP);
+
+        // number of events, time enabled, time running, then the values in the order the events joined the group
+        // (PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING)
+        uint64_t buffer[3+PERF_NUM_EVENTS];
+        const ssize_t size = (ssize_t)((3+m_group.size())*sizeof(uint64_t));
+        if(read(m_leader,buffer,sizeof(buffer)) != size || buffer[0] != m_group.size() || buffer[2] == 0)
+          return res;
+
+        const double scaling = buffer[2] < buffer[1] ? (double)buffer[1] / (double)buffer[2] : 1.;
+        for(size_t k = 0; k < m_group.size(); ++k)
+          res.values[m_group[k]] = (double)buffer[3+k] * scaling;
+#endif
+        return res;
+      }
+
+    protected:
+
+#ifdef __linux__
+      /// \brief Opens the event in the group of the leader, or as the leader if there is none yet.
+      void openEvent(const PerfEvent event, const uint32_t type, const uint64_t config)
+      {
+        struct perf_event_attr attr;
+        std::memset(&attr,0,sizeof(attr));
+        attr.type = type;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        // only the leader is disabled: the other members are then enabled and disabled with it
+        attr.disabled = m_leader < 0 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        const int fd = (int)syscall(__NR_perf_event_open,&attr,0,-1,m_leader,0);
+        if(fd < 0) return;
+
+        m_fd[event] = fd;
+        if(m_leader < 0) m_leader = fd;
+        m_group.push_back(event);
+      }
+#endif
+
+      int m_fd[PERF_NUM_EVENTS];
+
+      /// \brief File descriptor of the group leader, or -1 if no event is available.
+      int m_leader;
+
+      /// \brief Opened events, in the order they joined the group (the leader first).
+      std::vector<PerfEvent> m_group;
+
+    private:
+      PerfCounters(const PerfCounters &);
+      PerfCounters & operator=(const PerfCounters &);
+    };
+
+  } // namespace benchmark
+} // namespace pinocchio
+
+#endif // ifndef __pinocchio_benchmark_perf_counters_hpp__
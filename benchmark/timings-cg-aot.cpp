@@ -0,0 +1,138 @@
+//
+// Copyright (c) 2018 CNRS
+//
+
+#include "pinocchio/algorithm/crba.hpp"
+#include "pinocchio/algorithm/aba.hpp"
+#include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/rnea-derivatives.hpp"
+#include "pinocchio/parsers/urdf.hpp"
+#include "pinocchio/container/aligned-vector.hpp"
+
+// Generated at build time by ADD_PINOCCHIO_CODEGEN_LIBRARY
+#include "cg_aot_simple_humanoid.hpp"
+
+#include <iostream>
+
+#include "pinocchio/utils/timer.hpp"
+
+int main()
+{
+  using namespace Eigen;
+  using namespace pinocchio;
+  namespace cg = cg_aot_simple_humanoid;
+
+  PinocchioTicToc timer(PinocchioTicToc::US);
+  #ifdef NDEBUG
+  const int NBT = 1000*100;
+  #else
+    const int NBT = 1;
+    std::cout << "(the time score in debug mode is not relevant) " << std::endl;
+  #endif
+
+  pinocchio::Model model;
+  const std::string filename = PINOCCHIO_SOURCE_DIR"/models/simple_humanoid.urdf";
+  pinocchio::urdf::buildModel(filename,JointModelFreeFlyer(),model);
+
+  assert(model.nq == cg::nq && model.nv == cg::nv);
+  std::cout << "nq = " << model.nq << std::endl;
+  std::cout << "nv = " << model.nv << std::endl;
+  std::cout << "--" << std::endl;
+
+  pinocchio::Data data(model);
+
+  pinocchio::container::aligned_vector<VectorXd> qs     (NBT);
+  pinocchio::container::aligned_vector<VectorXd> qdots  (NBT);
+  pinocchio::container::aligned_vector<VectorXd> qddots (NBT);
+  pinocchio::container::aligned_vector<VectorXd> taus (NBT);
+  
+  MatrixXd rnea_inputs(cg::rnea::input_dim,NBT), aba_inputs(cg::aba::input_dim,NBT);
+  MatrixXd crba_inputs(cg::crba::input_dim,NBT);
+  for(int i=0;i<NBT;++i)
+  {
+    qs[i]     = Eigen::VectorXd::Random(model.nq);
+    qs[i].segment<4>(3) /= qs[i].segment<4>(3).norm();
+    qdots[i]  = Eigen::VectorXd::Random(model.nv);
+    qddots[i] = Eigen::VectorXd::Random(model.nv);
+    taus[i] = Eigen::VectorXd::Random(model.nv);
+    
+    rnea_inputs.col(i) << qs[i], qdots[i], qddots[i];
+    aba_inputs.col(i) << qs[i], qdots[i], taus[i];
+    crba_inputs.col(i) = qs[i];
+  }
+  
+  MatrixXd rnea_outputs(cg::rnea::output_dim,NBT), aba_outputs(cg::aba::output_dim,NBT);
+  MatrixXd crba_outputs(cg::crba::output_dim,NBT);
+  typedef Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> RowMatrixXd;
+  RowMatrixXd rnea_jacobian(cg::rnea::output_dim,cg::rnea::input_dim);
+  VectorXd partial_rnea(cg::partial_rnea::output_dim);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    rnea(model,data,qs[_smooth],qdots[_smooth],qddots[_smooth]);
+  }
+  std::cout << "RNEA = \t\t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    cg::rnea::eval(rnea_inputs.col(_smooth).data(),rnea_outputs.col(_smooth).data());
+  }
+  std::cout << "RNEA generated ahead of time = \t\t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  cg::rnea::batch(rnea_inputs.data(),rnea_outputs.data(),(unsigned long)NBT);
+  std::cout << "RNEA generated ahead of time batch = \t\t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    computeRNEADerivatives(model,data,qs[_smooth],qdots[_smooth],qddots[_smooth]);
+  }
+  std::cout << "RNEA partial derivatives = \t\t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    cg::rnea::jacobian(rnea_inputs.col(_smooth).data(),rnea_jacobian.data());
+  }
+  std::cout << "RNEA partial derivatives auto diff generated ahead of time = \t\t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    cg::partial_rnea::eval(rnea_inputs.col(_smooth).data(),partial_rnea.data());
+  }
+  std::cout << "RNEA partial derivatives generated ahead of time = \t\t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    aba(model,data,qs[_smooth],qdots[_smooth],taus[_smooth]);
+  }
+  std::cout << "ABA = \t\t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    cg::aba::eval(aba_inputs.col(_smooth).data(),aba_outputs.col(_smooth).data());
+  }
+  std::cout << "ABA generated ahead of time = \t\t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    crba(model,data,qs[_smooth]);
+  }
+  std::cout << "CRBA = \t\t"; timer.toc(std::cout,NBT);
+
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    cg::crba::eval(crba_inputs.col(_smooth).data(),crba_outputs.col(_smooth).data());
+  }
+  std::cout << "CRBA generated ahead of time = \t\t"; timer.toc(std::cout,NBT);
+
+  return 0;
+}
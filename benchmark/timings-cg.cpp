@@ -11,6 +11,8 @@
 #include "pinocchio/algorithm/center-of-mass.hpp"
 #include "pinocchio/algorithm/compute-all-terms.hpp"
 #include "pinocchio/algorithm/kinematics.hpp"
+#include "pinocchio/algorithm/frames.hpp"
+#include "pinocchio/algorithm/centroidal-derivatives.hpp"
 #include "pinocchio/parsers/urdf.hpp"
 #include "pinocchio/parsers/sample-models.hpp"
 #include "pinocchio/container/aligned-vector.hpp"
@@ -62,6 +64,7 @@ int main(int argc, const char ** argv)
   pinocchio::Data data(model);
   
   CodeGenRNEA<double> rnea_code_gen(model);
+  rnea_code_gen.setBuildBatch(true);
   rnea_code_gen.initLib();
   rnea_code_gen.loadLib();
   
@@ -84,6 +87,41 @@ int main(int argc, const char ** argv)
   CodeGenABADerivatives<double> aba_derivatives_code_gen(model);
   aba_derivatives_code_gen.initLib();
   aba_derivatives_code_gen.loadLib();
+  
+  std::vector<Model::FrameIndex> frame_ids;
+  for(Model::FrameIndex frame_id = 1; frame_id < (Model::FrameIndex)model.nframes; ++frame_id)
+  {
+    if(model.frames[frame_id].type == BODY)
+      frame_ids.push_back(frame_id);
+  }
+  
+  CodeGenFramesForwardKinematics<double> frames_fk_code_gen(model,frame_ids);
+  frames_fk_code_gen.initLib();
+  frames_fk_code_gen.loadLib();
+  
+  CodeGenFrameJacobians<double> frame_jacobians_code_gen(model,frame_ids,LOCAL);
+  frame_jacobians_code_gen.initLib();
+  frame_jacobians_code_gen.loadLib();
+  
+  CodeGenFrameJacobiansTimeVariation<double> frame_jacobians_time_variation_code_gen(model,frame_ids,LOCAL);
+  frame_jacobians_time_variation_code_gen.initLib();
+  frame_jacobians_time_variation_code_gen.loadLib();
+  
+  CodeGenCCRBA<double> ccrba_code_gen(model);
+  ccrba_code_gen.initLib();
+  ccrba_code_gen.loadLib();
+  
+  CodeGenDCCRBA<double> dccrba_code_gen(model);
+  dccrba_code_gen.initLib();
+  dccrba_code_gen.loadLib();
+  
+  CodeGenJacobianCenterOfMass<double> jacobian_com_code_gen(model);
+  jacobian_com_code_gen.initLib();
+  jacobian_com_code_gen.loadLib();
+  
+  CodeGenCentroidalDynamicsDerivatives<double> centroidal_derivatives_code_gen(model);
+  centroidal_derivatives_code_gen.initLib();
+  centroidal_derivatives_code_gen.loadLib();
 
   pinocchio::container::aligned_vector<VectorXd> qs     (NBT);
   pinocchio::container::aligned_vector<VectorXd> qdots  (NBT);
@@ -112,6 +150,24 @@ int main(int argc, const char ** argv)
     rnea_code_gen.evalFunction(qs[_smooth],qdots[_smooth],qddots[_smooth]);
   }
   std::cout << "RNEA generated = \t\t"; timer.toc(std::cout,NBT);
+  
+  MatrixXd rnea_inputs(rnea_code_gen.getInputDimension(),NBT);
+  MatrixXd rnea_outputs(rnea_code_gen.getOutputDimension(),NBT);
+  for(int i=0;i<NBT;++i)
+  {
+    rnea_inputs.col(i) << qs[i], qdots[i], qddots[i];
+  }
+  
+  timer.tic();
+  rnea_code_gen.evalFunctionBatch(rnea_inputs,rnea_outputs);
+  std::cout << "RNEA generated batch = \t\t"; timer.toc(std::cout,NBT);
+  
+#ifdef PINOCCHIO_WITH_OPENMP
+  const int num_threads = omp_get_max_threads();
+  timer.tic();
+  rnea_code_gen.evalFunctionBatch(rnea_inputs,rnea_outputs,num_threads);
+  std::cout << "RNEA generated batch (" << num_threads << " threads) = \t\t"; timer.toc(std::cout,NBT);
+#endif
 
   timer.tic();
   SMOOTH(NBT)
@@ -190,5 +246,112 @@ int main(int argc, const char ** argv)
   }
   std::cout << "ABA partial derivatives code gen = \t\t"; timer.toc(std::cout,NBT);
   
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    framesForwardKinematics(model,data,qs[_smooth]);
+  }
+  std::cout << "Frames FK = \t\t"; timer.toc(std::cout,NBT);
+  
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    frames_fk_code_gen.evalFunction(qs[_smooth]);
+  }
+  std::cout << "Frames FK generated = \t\t"; timer.toc(std::cout,NBT);
+  
+  Data::Matrix6x J(Data::Matrix6x::Zero(6,model.nv));
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    computeJointJacobians(model,data,qs[_smooth]);
+    updateFramePlacements(model,data);
+    for(size_t k = 0; k < frame_ids.size(); ++k)
+      getFrameJacobian(model,data,frame_ids[k],LOCAL,J);
+  }
+  std::cout << "Frame Jacobians = \t\t"; timer.toc(std::cout,NBT);
+  
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    frame_jacobians_code_gen.evalFunction(qs[_smooth]);
+  }
+  std::cout << "Frame Jacobians generated = \t\t"; timer.toc(std::cout,NBT);
+  
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    computeJointJacobiansTimeVariation(model,data,qs[_smooth],qdots[_smooth]);
+    updateFramePlacements(model,data);
+    for(size_t k = 0; k < frame_ids.size(); ++k)
+      getFrameJacobianTimeVariation(model,data,frame_ids[k],LOCAL,J);
+  }
+  std::cout << "Frame Jacobians time variation = \t\t"; timer.toc(std::cout,NBT);
+  
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    frame_jacobians_time_variation_code_gen.evalFunction(qs[_smooth],qdots[_smooth]);
+  }
+  std::cout << "Frame Jacobians time variation generated = \t\t"; timer.toc(std::cout,NBT);
+  
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    ccrba(model,data,qs[_smooth],qdots[_smooth]);
+  }
+  std::cout << "CCRBA = \t\t"; timer.toc(std::cout,NBT);
+  
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    ccrba_code_gen.evalFunction(qs[_smooth],qdots[_smooth]);
+  }
+  std::cout << "CCRBA generated = \t\t"; timer.toc(std::cout,NBT);
+  
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    dccrba(model,data,qs[_smooth],qdots[_smooth]);
+  }
+  std::cout << "DCCRBA = \t\t"; timer.toc(std::cout,NBT);
+  
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    dccrba_code_gen.evalFunction(qs[_smooth],qdots[_smooth]);
+  }
+  std::cout << "DCCRBA generated = \t\t"; timer.toc(std::cout,NBT);
+  
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    jacobianCenterOfMass(model,data,qs[_smooth],false);
+  }
+  std::cout << "Jcom = \t\t"; timer.toc(std::cout,NBT);
+  
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    jacobian_com_code_gen.evalFunction(qs[_smooth]);
+  }
+  std::cout << "Jcom generated = \t\t"; timer.toc(std::cout,NBT);
+  
+  Data::Matrix6x dhdot_dq(6,model.nv), dhdot_dv(6,model.nv), dhdot_da(6,model.nv);
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    computeCentroidalDynamicsDerivatives(model,data,qs[_smooth],qdots[_smooth],qddots[_smooth],
+                                         dhdot_dq,dhdot_dv,dhdot_da);
+  }
+  std::cout << "Centroidal dynamics partial derivatives = \t\t"; timer.toc(std::cout,NBT);
+  
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    centroidal_derivatives_code_gen.evalFunction(qs[_smooth],qdots[_smooth],qddots[_smooth]);
+  }
+  std::cout << "Centroidal dynamics partial derivatives code gen = \t\t"; timer.toc(std::cout,NBT);
+  
   return 0;
 }
@@ -117,6 +117,15 @@ int main(int argc, const char ** argv)
   }
   std::cout << "Cholesky solve column = \t\t"; timer.toc(std::cout,NBT);
   
+  MatrixXd X(model.nv,model.nv);
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    X = B;
+    cholesky::solve(model,data,X);
+  }
+  std::cout << "Cholesky solve matrix (nv columns) = \t\t"; timer.toc(std::cout,NBT);
+  
   timer.tic();
   SMOOTH(NBT)
   {
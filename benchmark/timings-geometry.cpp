@@ -82,6 +82,14 @@ int main()
   double update_col_time = timer.toc(PinocchioTicToc::US)/NBT - geom_time;
   std::cout << "Update Collision Geometry < false > = \t" << update_col_time << " " << PinocchioTicToc::unitName(PinocchioTicToc::US) << std::endl;
 
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    updateGeometryPlacementsQuaternion(model,data,geom_model,geom_data,qs_romeo[_smooth]);
+  }
+  double update_col_quat_time = timer.toc(PinocchioTicToc::US)/NBT;
+  std::cout << "Update Collision Geometry (quaternion, including the kinematics) = \t" << update_col_quat_time << " " << PinocchioTicToc::unitName(PinocchioTicToc::US) << std::endl;
+
 #ifdef PINOCCHIO_WITH_HPP_FCL
   timer.tic();
   SMOOTH(NBT)
@@ -0,0 +1,213 @@
+//
+// Copyright (c) 2018 CNRS
+//
+
+#include "pinocchio/multibody/joint/joint-spherical.hpp"
+#include "pinocchio/multibody/joint/joint-free-flyer.hpp"
+#include "pinocchio/multibody/joint/joint-generic.hpp"
+#include "pinocchio/spatial/inertia.hpp"
+#include "pinocchio/container/aligned-vector.hpp"
+
+#include "benchmark-harness.hpp"
+
+#include <iostream>
+#include <fstream>
+
+using namespace pinocchio;
+
+/// \brief Number of random inputs the timed calls cycle through.
+static const size_t NUM_INPUTS = 64;
+
+typedef Inertia::Matrix6 Matrix6;
+
+///
+/// \brief Dimensions reported by the runner for a single joint.
+///
+template<typename JointModel>
+struct JointDims
+{
+  JointDims() : nq(JointModel::NQ), nv(JointModel::NV), njoints(2) {}
+  int nq, nv, njoints;
+};
+
+///
+/// \brief Dimensions reported by the runner for a joint of dynamic size.
+///
+struct DynamicJointDims
+{
+  template<typename JointModel>
+  explicit DynamicJointDims(const JointModelBase<JointModel> & jmodel)
+  : nq(jmodel.nq()), nv(jmodel.nv()), njoints(2) {}
+  int nq, nv, njoints;
+};
+
+/// \brief Random articulated inertias, obtained by adding a random SPD matrix to random rigid inertias.
+static void randomArticulatedInertias(container::aligned_vector<Matrix6> & Is)
+{
+  for(size_t k = 0; k < Is.size(); ++k)
+  {
+    const Matrix6 A(Matrix6::Random());
+    Is[k] = Inertia::Random().matrix() + A*A.transpose();
+  }
+}
+
+template<typename JointModel, typename ConfigVectors>
+static void randomConfigurations(const JointModel & jmodel, ConfigVectors & qs)
+{
+  for(size_t k = 0; k < qs.size(); ++k)
+  {
+    qs[k].setRandom();
+    qs[k].template segment<4>(jmodel.nq()-4).normalize();
+  }
+}
+
+void benchmarkFreeFlyer(benchmark::Runner & runner)
+{
+  typedef JointModelFreeFlyer JointModel;
+  typedef JointModel::JointDataDerived JointData;
+  typedef Eigen::Map<const Eigen::Quaterniond> ConstQuaternionMap;
+  const std::string name("JointModelFreeFlyer");
+  const JointDims<JointModel> dims;
+
+  JointModel jmodel; jmodel.setIndexes(1,0,0);
+  JointData jdata(jmodel.createData());
+
+  container::aligned_vector<JointModel::ConfigVector_t> qs(NUM_INPUTS);
+  randomConfigurations(jmodel,qs);
+  container::aligned_vector<Matrix6> Is(NUM_INPUTS);
+  randomArticulatedInertias(Is);
+  Matrix6 Ia;
+
+  // Previous generic implementation, for reference
+  runner.run(name,dims,"calc_generic",[&](size_t k)
+             {
+               jdata.M.translation(qs[k].head<3>());
+               ConstQuaternionMap quat(qs[k].tail<4>().data());
+               jdata.M.rotation(quat.matrix());
+             });
+  runner.run(name,dims,"calc",[&](size_t k){ jmodel.calc(jdata,qs[k]); });
+
+  runner.run(name,dims,"calc_aba_generic",[&](size_t k)
+             {
+               Ia = Is[k];
+               jdata.U = Ia;
+               jdata.Dinv.setIdentity();
+               Ia.llt().solveInPlace(jdata.Dinv);
+               Ia.setZero();
+             });
+  runner.run(name,dims,"calc_aba",[&](size_t k){ Ia = Is[k]; jmodel.calc_aba(jdata,Ia,true); });
+}
+
+void benchmarkSpherical(benchmark::Runner & runner)
+{
+  typedef JointModelSpherical JointModel;
+  typedef JointModel::JointDataDerived JointData;
+  typedef Eigen::Map<const Eigen::Quaterniond> ConstQuaternionMap;
+  const std::string name("JointModelSpherical");
+  const JointDims<JointModel> dims;
+
+  JointModel jmodel; jmodel.setIndexes(1,0,0);
+  JointData jdata(jmodel.createData());
+
+  container::aligned_vector<JointModel::ConfigVector_t> qs(NUM_INPUTS);
+  randomConfigurations(jmodel,qs);
+  container::aligned_vector<Matrix6> Is(NUM_INPUTS);
+  randomArticulatedInertias(Is);
+  Matrix6 Ia;
+
+  // Previous generic implementation, for reference
+  runner.run(name,dims,"calc_generic",[&](size_t k)
+             {
+               ConstQuaternionMap quat(qs[k].data());
+               jdata.M.rotation(quat.matrix());
+             });
+  runner.run(name,dims,"calc",[&](size_t k){ jmodel.calc(jdata,qs[k]); });
+
+  runner.run(name,dims,"calc_aba_generic",[&](size_t k)
+             {
+               Ia = Is[k];
+               jdata.U = Ia.block<6,3>(0,Inertia::ANGULAR);
+               jdata.Dinv.setIdentity();
+               jdata.U.middleRows<3>(Inertia::ANGULAR).llt().solveInPlace(jdata.Dinv);
+               jdata.UDinv.middleRows<3>(Inertia::ANGULAR).setIdentity();
+               jdata.UDinv.middleRows<3>(Inertia::LINEAR).noalias() = jdata.U.block<3,3>(Inertia::LINEAR,0) * jdata.Dinv;
+               Ia.block<3,3>(Inertia::LINEAR,Inertia::LINEAR)
+               -= jdata.UDinv.middleRows<3>(Inertia::LINEAR) * Ia.block<3,3>(Inertia::ANGULAR,Inertia::LINEAR);
+               Ia.block<6,3>(0,Inertia::ANGULAR).setZero();
+               Ia.block<3,3>(Inertia::ANGULAR,Inertia::LINEAR).setZero();
+             });
+  runner.run(name,dims,"calc_aba",[&](size_t k){ Ia = Is[k]; jmodel.calc_aba(jdata,Ia,true); });
+}
+
+void benchmarkGimbal(benchmark::Runner & runner)
+{
+  typedef JointModelComposite JointModel;
+  typedef JointModel::JointDataDerived JointData;
+  const std::string name("JointModelComposite_RZRYRX");
+
+  JointModel jmodel((JointModelRZ()));
+  jmodel.addJoint(JointModelRY(),SE3::Random()).addJoint(JointModelRX(),SE3::Random());
+  jmodel.setIndexes(1,0,0);
+  JointData jdata(jmodel.createData());
+  const DynamicJointDims dims(jmodel);
+
+  container::aligned_vector<Eigen::VectorXd> qs(NUM_INPUTS), vs(NUM_INPUTS);
+  for(size_t k = 0; k < NUM_INPUTS; ++k)
+  {
+    qs[k] = Eigen::VectorXd::Random(jmodel.nq());
+    vs[k] = Eigen::VectorXd::Random(jmodel.nv());
+  }
+  container::aligned_vector<Matrix6> Is(NUM_INPUTS);
+  randomArticulatedInertias(Is);
+  Matrix6 Ia;
+
+  runner.run(name,dims,"calc_q",[&](size_t k){ jmodel.calc(jdata,qs[k]); });
+  runner.run(name,dims,"calc_qv",[&](size_t k){ jmodel.calc(jdata,qs[k],vs[k]); });
+  runner.run(name,dims,"calc_aba",[&](size_t k){ Ia = Is[k]; jmodel.calc_aba(jdata,Ia,true); });
+}
+
+int main(int argc, const char ** argv)
+{
+  benchmark::Options options;
+  if(!options.parse(argc,argv))
+  {
+    benchmark::Options::usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  #ifndef NDEBUG
+    std::cout << "(the time score in debug mode is not relevant) " << std::endl;
+  #endif
+
+  benchmark::Runner runner(options,NUM_INPUTS);
+  runner.printHeader(std::cout);
+
+  benchmarkFreeFlyer(runner);
+  benchmarkSpherical(runner);
+  benchmarkGimbal(runner);
+
+  if(!options.json.empty())
+  {
+    std::ofstream file(options.json.c_str());
+    runner.writeJSON(file);
+  }
+
+  if(!options.compare.empty())
+  {
+    std::ifstream file(options.compare.c_str());
+    if(!file.good())
+    {
+      std::cerr << "Unable to read " << options.compare << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    const size_t num_regressions = runner.compare(benchmark::Runner::readJSON(file),std::cout);
+    if(num_regressions > 0)
+    {
+      std::cout << num_regressions << " regression(s) above " << 100.*options.threshold << "%" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
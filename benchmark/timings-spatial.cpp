@@ -0,0 +1,135 @@
+//
+// Copyright (c) 2018 CNRS
+//
+
+#include "pinocchio/spatial/se3.hpp"
+#include "pinocchio/spatial/motion.hpp"
+#include "pinocchio/spatial/force.hpp"
+#include "pinocchio/spatial/inertia.hpp"
+#include "pinocchio/spatial/act-on-set.hpp"
+#include "pinocchio/container/aligned-vector.hpp"
+
+#include "benchmark-harness.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+using namespace pinocchio;
+
+/// \brief Number of random inputs the timed calls cycle through.
+static const size_t NUM_INPUTS = 64;
+
+typedef Eigen::Matrix<double,6,Eigen::Dynamic> Matrix6x;
+
+///
+/// \brief Dimensions reported by the runner for a set of width columns.
+///        The counters divided by njoints are then given per column (njoints-1 == width).
+///
+struct SetWidth
+{
+  explicit SetWidth(const int width) : nq(width), nv(width), njoints(width+1) {}
+  int nq, nv, njoints;
+};
+
+void benchmarkWidth(benchmark::Runner & runner, const int width)
+{
+  std::ostringstream name; name << "width_" << width;
+  const SetWidth dims(width);
+
+  container::aligned_vector<SE3> Ms(NUM_INPUTS);
+  container::aligned_vector<Motion> vs(NUM_INPUTS);
+  container::aligned_vector<Force> fs(NUM_INPUTS);
+  container::aligned_vector<Inertia> Is(NUM_INPUTS);
+  container::aligned_vector<Matrix6x> sets(NUM_INPUTS);
+  for(size_t k = 0; k < NUM_INPUTS; ++k)
+  {
+    Ms[k].setRandom();
+    vs[k].setRandom();
+    fs[k].setRandom();
+    Is[k].setRandom();
+    sets[k] = Matrix6x::Random(6,width);
+  }
+  Matrix6x res(Matrix6x::Zero(6,width));
+
+  // Column by column application of the single vector actions, for reference
+  runner.run(name.str(),dims,"motion_se3Action_colwise",[&](size_t k)
+             {
+               for(int col = 0; col < width; ++col)
+                 res.col(col) = Ms[k].act(Motion(sets[k].col(col))).toVector();
+             });
+  runner.run(name.str(),dims,"force_se3Action_colwise",[&](size_t k)
+             {
+               for(int col = 0; col < width; ++col)
+                 res.col(col) = Ms[k].act(Force(sets[k].col(col))).toVector();
+             });
+
+  // Motion sets
+  runner.run(name.str(),dims,"motionSet::se3Action",[&](size_t k){ motionSet::se3Action(Ms[k],sets[k],res); });
+  runner.run(name.str(),dims,"motionSet::se3Action_ADDTO",[&](size_t k){ motionSet::se3Action<ADDTO>(Ms[k],sets[k],res); });
+  runner.run(name.str(),dims,"motionSet::se3ActionInverse",[&](size_t k){ motionSet::se3ActionInverse(Ms[k],sets[k],res); });
+  runner.run(name.str(),dims,"motionSet::motionAction",[&](size_t k){ motionSet::motionAction(vs[k],sets[k],res); });
+  runner.run(name.str(),dims,"motionSet::inertiaAction",[&](size_t k){ motionSet::inertiaAction(Is[k],sets[k],res); });
+  runner.run(name.str(),dims,"motionSet::act",[&](size_t k){ motionSet::act(sets[k],fs[k],res); });
+
+  // Force sets
+  runner.run(name.str(),dims,"forceSet::se3Action",[&](size_t k){ forceSet::se3Action(Ms[k],sets[k],res); });
+  runner.run(name.str(),dims,"forceSet::se3ActionInverse",[&](size_t k){ forceSet::se3ActionInverse(Ms[k],sets[k],res); });
+  runner.run(name.str(),dims,"forceSet::motionAction",[&](size_t k){ forceSet::motionAction(vs[k],sets[k],res); });
+}
+
+int main(int argc, const char ** argv)
+{
+  benchmark::Options options;
+  if(!options.parse(argc,argv))
+  {
+    benchmark::Options::usage(argv[0]);
+    std::cerr << "  <width> ...                numbers of columns of the sets (default 1 2 3 4 6 8 12 16 24 32 50 100)" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  #ifndef NDEBUG
+    std::cout << "(the time score in debug mode is not relevant) " << std::endl;
+  #endif
+
+  std::vector<int> widths;
+  for(size_t k = 0; k < options.remaining_arguments.size(); ++k)
+    widths.push_back(std::atoi(options.remaining_arguments[k].c_str()));
+  if(widths.empty())
+  {
+    const int default_widths[] = {1,2,3,4,6,8,12,16,24,32,50,100};
+    widths.assign(default_widths,default_widths+sizeof(default_widths)/sizeof(int));
+  }
+
+  benchmark::Runner runner(options,NUM_INPUTS);
+  runner.printHeader(std::cout);
+
+  for(size_t k = 0; k < widths.size(); ++k)
+    if(widths[k] > 0)
+      benchmarkWidth(runner,widths[k]);
+
+  if(!options.json.empty())
+  {
+    std::ofstream file(options.json.c_str());
+    runner.writeJSON(file);
+  }
+
+  if(!options.compare.empty())
+  {
+    std::ifstream file(options.compare.c_str());
+    if(!file.good())
+    {
+      std::cerr << "Unable to read " << options.compare << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    const size_t num_regressions = runner.compare(benchmark::Runner::readJSON(file),std::cout);
+    if(num_regressions > 0)
+    {
+      std::cout << num_regressions << " regression(s) above " << 100.*options.threshold << "%" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,255 @@
+//
+// Copyright (c) 2018 CNRS
+//
+
+#include "pinocchio/algorithm/joint-configuration.hpp"
+#include "pinocchio/algorithm/kinematics.hpp"
+#include "pinocchio/algorithm/kinematics-derivatives.hpp"
+#include "pinocchio/algorithm/frames.hpp"
+#include "pinocchio/algorithm/jacobian.hpp"
+#include "pinocchio/algorithm/crba.hpp"
+#include "pinocchio/algorithm/centroidal.hpp"
+#include "pinocchio/algorithm/centroidal-derivatives.hpp"
+#include "pinocchio/algorithm/aba.hpp"
+#include "pinocchio/algorithm/aba-derivatives.hpp"
+#include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/rnea-derivatives.hpp"
+#include "pinocchio/algorithm/cholesky.hpp"
+#include "pinocchio/algorithm/center-of-mass.hpp"
+#include "pinocchio/algorithm/compute-all-terms.hpp"
+#include "pinocchio/algorithm/energy.hpp"
+#include "pinocchio/algorithm/regressor.hpp"
+#include "pinocchio/algorithm/dynamics.hpp"
+#include "pinocchio/algorithm/finite-differences.hpp"
+#include "pinocchio/parsers/sample-models.hpp"
+#include "pinocchio/container/aligned-vector.hpp"
+
+#ifdef PINOCCHIO_WITH_URDFDOM
+  #include "pinocchio/parsers/urdf.hpp"
+#endif
+
+#include "benchmark-harness.hpp"
+
+#include <iostream>
+#include <fstream>
+
+using namespace pinocchio;
+using Eigen::VectorXd;
+using Eigen::MatrixXd;
+
+/// \brief Number of random inputs the timed calls cycle through.
+static const size_t NUM_INPUTS = 64;
+
+///
+/// \brief Serial chain made of num_arms manipulators (6 revolute joints each) attached one after the other.
+///
+void buildManipulatorChain(Model & model, const int num_arms)
+{
+  const SE3 Marm(SE3::Matrix3::Identity(),SE3::Vector3::UnitZ());
+  for(int k = 0; k < num_arms; ++k)
+  {
+    std::ostringstream prefix; prefix << "arm" << k << "_";
+    const JointIndex root = (JointIndex)model.njoints-1;
+    buildModels::details::addManipulator(model,root,k == 0 ? SE3::Identity() : Marm,prefix.str());
+  }
+}
+
+void benchmarkModel(benchmark::Runner & runner, const std::string & name, const Model & model)
+{
+  Data data(model);
+
+  container::aligned_vector<VectorXd> qs(NUM_INPUTS), qs_bis(NUM_INPUTS);
+  container::aligned_vector<VectorXd> vs(NUM_INPUTS), as(NUM_INPUTS), taus(NUM_INPUTS);
+  const VectorXd lower = -VectorXd::Ones(model.nq), upper = VectorXd::Ones(model.nq);
+  for(size_t k = 0; k < NUM_INPUTS; ++k)
+  {
+    qs[k] = randomConfiguration(model,lower,upper);
+    qs_bis[k] = randomConfiguration(model,lower,upper);
+    vs[k] = VectorXd::Random(model.nv);
+    as[k] = VectorXd::Random(model.nv);
+    taus[k] = VectorXd::Random(model.nv);
+  }
+
+  const Model::FrameIndex frame_id = (Model::FrameIndex)model.nframes-1;
+  Data::Matrix6x J(6,model.nv); J.setZero();
+  Data::Matrix6x dh_dq(6,model.nv), dh_dv(6,model.nv), dh_da(6,model.nv);
+  MatrixXd dq_dq(model.nv,model.nv), dq_dv(model.nv,model.nv);
+  EIGEN_PLAIN_ROW_MAJOR_TYPE(MatrixXd) drnea_dq(MatrixXd::Zero(model.nv,model.nv));
+  EIGEN_PLAIN_ROW_MAJOR_TYPE(MatrixXd) drnea_dv(MatrixXd::Zero(model.nv,model.nv));
+  MatrixXd drnea_da(MatrixXd::Zero(model.nv,model.nv));
+  MatrixXd daba_dq(MatrixXd::Zero(model.nv,model.nv));
+  MatrixXd daba_dv(MatrixXd::Zero(model.nv,model.nv));
+  Data::RowMatrixXs daba_dtau(Data::RowMatrixXs::Zero(model.nv,model.nv));
+  VectorXd res(model.nv);
+
+  // Contact of the last joint, used by the constrained dynamics
+  Data::Matrix6x J_contact(6,model.nv); J_contact.setZero();
+  computeJointJacobians(model,data,qs[0]);
+  getJointJacobian(model,data,(JointIndex)model.njoints-1,LOCAL,J_contact);
+  const VectorXd gamma = VectorXd::Zero(6);
+
+  // Kinematics
+  runner.run(name,model,"forwardKinematics_q",[&](size_t k){ forwardKinematics(model,data,qs[k]); });
+  runner.run(name,model,"forwardKinematics_qv",[&](size_t k){ forwardKinematics(model,data,qs[k],vs[k]); });
+  runner.run(name,model,"forwardKinematics_qva",[&](size_t k){ forwardKinematics(model,data,qs[k],vs[k],as[k]); });
+  runner.run(name,model,"framesForwardKinematics",[&](size_t k){ framesForwardKinematics(model,data,qs[k]); });
+  runner.run(name,model,"forwardKinematicsQuaternion",[&](size_t k){ forwardKinematicsQuaternion(model,data,qs[k]); });
+  runner.run(name,model,"framesForwardKinematicsQuaternion",[&](size_t k){ framesForwardKinematicsQuaternion(model,data,qs[k]); });
+  runner.run(name,model,"computeForwardKinematicsDerivatives",
+             [&](size_t k){ computeForwardKinematicsDerivatives(model,data,qs[k],vs[k],as[k]); });
+
+  // Jacobians
+  runner.run(name,model,"computeJointJacobians",[&](size_t k){ computeJointJacobians(model,data,qs[k]); });
+  runner.run(name,model,"computeJointJacobiansTimeVariation",
+             [&](size_t k){ computeJointJacobiansTimeVariation(model,data,qs[k],vs[k]); });
+  computeJointJacobians(model,data,qs[0]); framesForwardKinematics(model,data,qs[0]);
+  runner.run(name,model,"getFrameJacobian",[&](size_t){ getFrameJacobian(model,data,frame_id,LOCAL,J); });
+  std::vector<Model::FrameIndex> body_ids;
+  for(Model::FrameIndex k = 0; k < (Model::FrameIndex)model.nframes; ++k)
+    if(model.frames[k].type == BODY) body_ids.push_back(k);
+  MatrixXd J_bodies(6*(Eigen::DenseIndex)body_ids.size(),model.nv); J_bodies.setZero();
+  runner.run(name,model,"getFrameJacobian_bodies",[&](size_t)
+             {
+               for(size_t i = 0; i < body_ids.size(); ++i)
+                 getFrameJacobian(model,data,body_ids[i],LOCAL,J_bodies.middleRows<6>(6*(Eigen::DenseIndex)i));
+             });
+  runner.run(name,model,"getFrameJacobians_bodies",[&](size_t){ getFrameJacobians(model,data,body_ids,LOCAL,J_bodies); });
+
+  // Dynamics
+  runner.run(name,model,"rnea",[&](size_t k){ rnea(model,data,qs[k],vs[k],as[k]); });
+  runner.run(name,model,"nonLinearEffects",[&](size_t k){ nonLinearEffects(model,data,qs[k],vs[k]); });
+  runner.run(name,model,"computeGeneralizedGravity",[&](size_t k){ computeGeneralizedGravity(model,data,qs[k]); });
+  runner.run(name,model,"computeCoriolisMatrix",[&](size_t k){ computeCoriolisMatrix(model,data,qs[k],vs[k]); });
+  runner.run(name,model,"crba",[&](size_t k){ crba(model,data,qs[k]); });
+  runner.run(name,model,"aba",[&](size_t k){ aba(model,data,qs[k],vs[k],taus[k]); });
+  runner.run(name,model,"computeMinverse",[&](size_t k){ computeMinverse(model,data,qs[k]); });
+  runner.run(name,model,"computeAllTerms",[&](size_t k){ computeAllTerms(model,data,qs[k],vs[k]); });
+  runner.run(name,model,"forwardDynamics",
+             [&](size_t k){ forwardDynamics(model,data,qs[k],vs[k],taus[k],J_contact,gamma,1e-12); });
+
+  // Cholesky
+  crba(model,data,qs[0]);
+  data.M.triangularView<Eigen::StrictlyLower>() = data.M.transpose().triangularView<Eigen::StrictlyLower>();
+  runner.run(name,model,"cholesky::decompose",[&](size_t){ cholesky::decompose(model,data); });
+  runner.run(name,model,"cholesky::solve",[&](size_t k){ res = taus[k]; cholesky::solve(model,data,res); });
+
+  // Derivatives
+  runner.run(name,model,"computeRNEADerivatives",
+             [&](size_t k){ computeRNEADerivatives(model,data,qs[k],vs[k],as[k],drnea_dq,drnea_dv,drnea_da); });
+  runner.run(name,model,"computeABADerivatives",
+             [&](size_t k){ computeABADerivatives(model,data,qs[k],vs[k],taus[k],daba_dq,daba_dv,daba_dtau); });
+
+  // Centroidal and center of mass
+  runner.run(name,model,"centerOfMass",[&](size_t k){ centerOfMass(model,data,qs[k],vs[k],as[k]); });
+  runner.run(name,model,"jacobianCenterOfMass",[&](size_t k){ jacobianCenterOfMass(model,data,qs[k]); });
+  runner.run(name,model,"ccrba",[&](size_t k){ ccrba(model,data,qs[k],vs[k]); });
+  runner.run(name,model,"dccrba",[&](size_t k){ dccrba(model,data,qs[k],vs[k]); });
+  runner.run(name,model,"computeCentroidalDynamicsDerivatives",
+             [&](size_t k){ computeCentroidalDynamicsDerivatives(model,data,qs[k],vs[k],as[k],dh_dq,dh_dv,dh_da); });
+
+  // Energy and regressors
+  runner.run(name,model,"kineticEnergy",[&](size_t k){ kineticEnergy(model,data,qs[k],vs[k]); });
+  runner.run(name,model,"potentialEnergy",[&](size_t k){ potentialEnergy(model,data,qs[k]); });
+  runner.run(name,model,"computeStaticRegressor",[&](size_t k){ regressor::computeStaticRegressor(model,data,qs[k]); });
+
+  // Configuration space
+  runner.run(name,model,"integrate",[&](size_t k){ integrate(model,qs[k],vs[k]); });
+  runner.run(name,model,"difference",[&](size_t k){ difference(model,qs[k],qs_bis[k]); });
+  runner.run(name,model,"interpolate",[&](size_t k){ interpolate(model,qs[k],qs_bis[k],0.5); });
+  runner.run(name,model,"squaredDistance",[&](size_t k){ squaredDistance(model,qs[k],qs_bis[k]); });
+  runner.run(name,model,"dIntegrate",[&](size_t k){ dIntegrate(model,qs[k],vs[k],dq_dq,ARG0); });
+  runner.run(name,model,"dDifference",[&](size_t k){ dDifference(model,qs[k],qs_bis[k],dq_dq,ARG0); });
+  const VectorXd fd_increment = finiteDifferenceIncrement(model);
+  runner.run(name,model,"dDifference_finite_differences",[&](size_t k)
+             {
+               const VectorXd d = difference(model,qs[k],qs_bis[k]);
+               VectorXd v_eps(VectorXd::Zero(model.nv));
+               for(Eigen::DenseIndex i = 0; i < model.nv; ++i)
+               {
+                 v_eps[i] = fd_increment[i];
+                 dq_dq.col(i) = (difference(model,integrate(model,qs[k],v_eps),qs_bis[k]) - d) / fd_increment[i];
+                 v_eps[i] = 0.;
+               }
+             });
+}
+
+int main(int argc, const char ** argv)
+{
+  benchmark::Options options;
+  if(!options.parse(argc,argv))
+  {
+    benchmark::Options::usage(argv[0]);
+    std::cerr << "  <model.urdf> ...           additional URDF models, with a free flyer root joint" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  #ifndef NDEBUG
+    std::cout << "(the time score in debug mode is not relevant) " << std::endl;
+  #endif
+
+  benchmark::Runner runner(options,NUM_INPUTS);
+  runner.printHeader(std::cout);
+
+  std::vector< std::pair<std::string,Model> > models;
+
+#ifdef PINOCCHIO_WITH_URDFDOM
+  std::vector<std::string> filenames;
+  filenames.push_back(PINOCCHIO_SOURCE_DIR"/models/simple_humanoid.urdf");
+  filenames.push_back(PINOCCHIO_SOURCE_DIR"/models/romeo/romeo_description/urdf/romeo.urdf");
+  filenames.insert(filenames.end(),options.remaining_arguments.begin(),options.remaining_arguments.end());
+  for(size_t k = 0; k < filenames.size(); ++k)
+  {
+    if(!std::ifstream(filenames[k].c_str()).good()) continue;
+
+    Model model;
+    urdf::buildModel(filenames[k],JointModelFreeFlyer(),model);
+
+    const size_t begin = filenames[k].find_last_of('/') + 1;
+    const size_t end = filenames[k].find_last_of('.');
+    models.push_back(std::make_pair(filenames[k].substr(begin,end-begin),model));
+  }
+#endif
+
+  {
+    Model model; buildModels::humanoidRandom(model,true);
+    models.push_back(std::make_pair(std::string("humanoid_random"),model));
+  }
+  {
+    Model model; buildModels::humanoidRandom(model,false);
+    models.push_back(std::make_pair(std::string("humanoid_random_fixed"),model));
+  }
+  for(int num_arms = 1; num_arms <= 8; num_arms *= 2)
+  {
+    Model model; buildManipulatorChain(model,num_arms);
+    std::ostringstream name; name << "manipulator_x" << num_arms;
+    models.push_back(std::make_pair(name.str(),model));
+  }
+
+  for(size_t k = 0; k < models.size(); ++k)
+    benchmarkModel(runner,models[k].first,models[k].second);
+
+  if(!options.json.empty())
+  {
+    std::ofstream file(options.json.c_str());
+    runner.writeJSON(file);
+  }
+
+  if(!options.compare.empty())
+  {
+    std::ifstream file(options.compare.c_str());
+    if(!file.good())
+    {
+      std::cerr << "Unable to read " << options.compare << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    const size_t num_regressions = runner.compare(benchmark::Runner::readJSON(file),std::cout);
+    if(num_regressions > 0)
+    {
+      std::cout << num_regressions << " regression(s) above " << 100.*options.threshold << "%" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -181,6 +181,13 @@ int main(int argc, const char ** argv)
     forwardKinematics(model,data,qs[_smooth]);
   }
   std::cout << "Zero Order Kinematics = \t"; timer.toc(std::cout,NBT);
+  
+  timer.tic();
+  SMOOTH(NBT)
+  {
+    forwardKinematicsQuaternion(model,data,qs[_smooth]);
+  }
+  std::cout << "Zero Order Kinematics (quaternion) = \t"; timer.toc(std::cout,NBT);
 
 
   timer.tic();
@@ -44,6 +44,42 @@ namespace pinocchio
                                     const Eigen::MatrixBase<MatrixType1> & aba_partial_dq,
                                     const Eigen::MatrixBase<MatrixType2> & aba_partial_dv,
                                     const Eigen::MatrixBase<MatrixType3> & aba_partial_dtau);
+
+  ///
+  /// \brief The derivatives of the Articulated-Body algorithm, with the independent branches of the kinematic
+  ///        tree handled by different threads (see forwardPassParallel and backwardPassParallel).
+  ///
+  /// \tparam JointCollection Collection of Joint types.
+  /// \tparam ConfigVectorType Type of the joint configuration vector.
+  /// \tparam TangentVectorType1 Type of the joint velocity vector.
+  /// \tparam TangentVectorType2 Type of the joint torque vector.
+  /// \tparam MatrixType1 Type of the matrix containing the partial derivative with respect to the joint configuration vector.
+  /// \tparam MatrixType2 Type of the matrix containing the partial derivative with respect to the joint velocity vector.
+  /// \tparam MatrixType3 Type of the matrix containing the partial derivative with respect to the joint torque vector.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration vector (dim model.nq).
+  /// \param[in] v The joint velocity vector (dim model.nv).
+  /// \param[in] tau The joint torque vector (dim model.nv).
+  /// \param[out] aba_partial_dq Partial derivative of the generalized torque vector with respect to the joint configuration.
+  /// \param[out] aba_partial_dv Partial derivative of the generalized torque vector with respect to the joint velocity.
+  /// \param[out] aba_partial_dtau Partial derivative of the generalized torque vector with respect to the joint torque.
+  /// \param[in] num_threads Number of threads. It is only effective when Pinocchio is built with OpenMP support.
+  ///            With more than one thread, the model must be numbered in depth-first order (see finalizeModel).
+  ///
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType, typename TangentVectorType1, typename TangentVectorType2,
+           typename MatrixType1, typename MatrixType2, typename MatrixType3>
+  inline void computeABADerivativesParallel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                            DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                            const Eigen::MatrixBase<ConfigVectorType> & q,
+                                            const Eigen::MatrixBase<TangentVectorType1> & v,
+                                            const Eigen::MatrixBase<TangentVectorType2> & tau,
+                                            const Eigen::MatrixBase<MatrixType1> & aba_partial_dq,
+                                            const Eigen::MatrixBase<MatrixType2> & aba_partial_dv,
+                                            const Eigen::MatrixBase<MatrixType3> & aba_partial_dtau,
+                                            const int num_threads);
+
   ///
   /// \brief The derivatives of the Articulated-Body algorithm with external forces.
   ///
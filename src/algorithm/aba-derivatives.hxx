@@ -8,6 +8,7 @@
 #include "pinocchio/multibody/visitor.hpp"
 #include "pinocchio/algorithm/check.hpp"
 #include "pinocchio/algorithm/aba.hpp"
+#include "pinocchio/algorithm/subtree-parallel.hpp"
 
 namespace pinocchio
 {
@@ -95,7 +96,6 @@ namespace pinocchio
       jmodel.calc_aba(jdata.derived(), Ia, parent > 0);
       
       typename Data::Matrix6x & Fcrb = data.Fcrb[0];
-      typename Data::Matrix6x & FcrbTmp = data.Fcrb.back();
 
       typedef typename SizeDepType<JointModel::NV>::template ColsReturn<typename Data::Matrix6x>::Type ColsBlock;
 
@@ -117,9 +117,8 @@ namespace pinocchio
         
         if(parent > 0)
         {
-          FcrbTmp.leftCols(data.nvSubtree[i]).noalias()
-          = U_cols * Minv_.block(jmodel.idx_v(),jmodel.idx_v(),jmodel.nv(),data.nvSubtree[i]);
-          Fcrb.middleCols(jmodel.idx_v(),data.nvSubtree[i]) += FcrbTmp.leftCols(data.nvSubtree[i]);
+          Fcrb.middleCols(jmodel.idx_v(),data.nvSubtree[i]).noalias()
+          += U_cols * Minv_.block(jmodel.idx_v(),jmodel.idx_v(),jmodel.nv(),data.nvSubtree[i]);
         }
       }
       else // This a leaf of the kinematic tree
@@ -177,8 +176,6 @@ namespace pinocchio
       oa = data.oMi[i].act(data.a[i]);
       of = data.oYcrb[i] * oa + ov.cross(data.oh[i]);
 
-      typename Data::Matrix6x & FcrbTmp = data.Fcrb.back();
-      
       typedef typename SizeDepType<JointModel::NV>::template ColsReturn<typename Data::Matrix6x>::Type ColsBlock;
       ColsBlock UDinv_cols = jmodel.jointCols(data.UDinv);
       forceSet::se3Action(data.oMi[i],jdata.UDinv(),UDinv_cols); // expressed in the world frame
@@ -187,10 +184,8 @@ namespace pinocchio
       
       if(parent > 0)
       {
-        FcrbTmp.topRows(jmodel.nv()).rightCols(model.nv - jmodel.idx_v()).noalias()
-        = UDinv_cols.transpose() * data.Fcrb[parent].rightCols(model.nv - jmodel.idx_v());
-        Minv_.middleRows(jmodel.idx_v(),jmodel.nv()).rightCols(model.nv - jmodel.idx_v())
-        -= FcrbTmp.topRows(jmodel.nv()).rightCols(model.nv - jmodel.idx_v());
+        Minv_.middleRows(jmodel.idx_v(),jmodel.nv()).rightCols(model.nv - jmodel.idx_v()).noalias()
+        -= UDinv_cols.transpose() * data.Fcrb[parent].rightCols(model.nv - jmodel.idx_v());
       }
       
       ColsBlock J_cols = jmodel.jointCols(data.J);
@@ -253,7 +248,8 @@ namespace pinocchio
       const JointIndex & i = jmodel.id();
       const JointIndex & parent = model.parents[i];
       
-      typename Data::RowMatrix6 & M6tmpR = data.M6tmpR;
+      // Local buffer, so that independent branches can be processed concurrently.
+      typename Data::RowMatrix6 M6tmpR;
       
       typename Data::MatrixXs & rnea_partial_dq = data.dtau_dq;
       typename Data::MatrixXs & rnea_partial_dv = data.dtau_dv;
@@ -336,6 +332,21 @@ namespace pinocchio
                                     const Eigen::MatrixBase<MatrixType1> & aba_partial_dq,
                                     const Eigen::MatrixBase<MatrixType2> & aba_partial_dv,
                                     const Eigen::MatrixBase<MatrixType3> & aba_partial_dtau)
+  {
+    computeABADerivativesParallel(model,data,q,v,tau,aba_partial_dq,aba_partial_dv,aba_partial_dtau,1);
+  }
+  
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType, typename TangentVectorType1, typename TangentVectorType2,
+  typename MatrixType1, typename MatrixType2, typename MatrixType3>
+  inline void computeABADerivativesParallel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                            DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                            const Eigen::MatrixBase<ConfigVectorType> & q,
+                                            const Eigen::MatrixBase<TangentVectorType1> & v,
+                                            const Eigen::MatrixBase<TangentVectorType2> & tau,
+                                            const Eigen::MatrixBase<MatrixType1> & aba_partial_dq,
+                                            const Eigen::MatrixBase<MatrixType2> & aba_partial_dv,
+                                            const Eigen::MatrixBase<MatrixType3> & aba_partial_dtau,
+                                            const int num_threads)
   {
     assert(q.size() == model.nq && "The joint configuration vector is not of right size");
     assert(v.size() == model.nv && "The joint velocity vector is not of right size");
@@ -348,7 +359,8 @@ namespace pinocchio
     assert(aba_partial_dtau.rows() == model.nv);
     assert(model.check(data) && "data is not consistent with model.");
     
-    typedef typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex JointIndex;
+    typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
+    typedef DataTpl<Scalar,Options,JointCollectionTpl> Data;
     
     data.a[0] = -model.gravity;
     data.oa[0] = -model.gravity;
@@ -359,33 +371,21 @@ namespace pinocchio
     
     /// First, compute Minv and a, the joint acceleration vector
     typedef ComputeABADerivativesForwardStep1<Scalar,Options,JointCollectionTpl,ConfigVectorType,TangentVectorType1> Pass1;
-    for(JointIndex i=1; i<(JointIndex) model.njoints; ++i)
-    {
-      Pass1::run(model.joints[i],data.joints[i],
-                 typename Pass1::ArgsType(model,data,q.derived(),v.derived()));
-    }
+    typename Pass1::ArgsType arg1(model,data,q.derived(),v.derived());
+    forwardPassParallel(model,JointPassFunctor<Pass1,Model,Data>(model,data,arg1),num_threads);
     
     data.Fcrb[0].setZero();
     typedef ComputeABADerivativesBackwardStep1<Scalar,Options,JointCollectionTpl,MatrixType3> Pass2;
-    for(JointIndex i=(JointIndex)(model.njoints-1);i>0;--i)
-    {
-      Pass2::run(model.joints[i],data.joints[i],
-                 typename Pass2::ArgsType(model,data,Minv_));
-    }
+    typename Pass2::ArgsType arg2(model,data,Minv_);
+    backwardPassParallel(model,JointPassFunctor<Pass2,Model,Data>(model,data,arg2),num_threads);
     
     typedef ComputeABADerivativesForwardStep2<Scalar,Options,JointCollectionTpl,MatrixType3> Pass3;
-    for(JointIndex i=1; i<(JointIndex) model.njoints; ++i)
-    {
-      Pass3::run(model.joints[i],data.joints[i],
-                 typename Pass3::ArgsType(model,data,Minv_));
-    }
+    typename Pass3::ArgsType arg3(model,data,Minv_);
+    forwardPassParallel(model,JointPassFunctor<Pass3,Model,Data>(model,data,arg3),num_threads);
     
     typedef ComputeABADerivativesBackwardStep2<Scalar,Options,JointCollectionTpl> Pass4;
-    for(JointIndex i=(JointIndex)(model.njoints-1);i>0;--i)
-    {
-      Pass4::run(model.joints[i],
-                 typename Pass4::ArgsType(model,data));
-    }
+    typename Pass4::ArgsType arg4(model,data);
+    backwardPassParallel(model,JointPassFunctor<Pass4,Model,Data,false>(model,data,arg4),num_threads);
     
     Minv_.template triangularView<Eigen::StrictlyLower>()
     = Minv_.transpose().template triangularView<Eigen::StrictlyLower>();
@@ -35,6 +35,34 @@ namespace pinocchio
       const Eigen::MatrixBase<TangentVectorType1> & v,
       const Eigen::MatrixBase<TangentVectorType2> & tau);
 
+  ///
+  /// \brief The Articulated-Body algorithm, with the independent branches of the kinematic tree
+  ///        handled by different threads (see forwardPassParallel and backwardPassParallel).
+  ///
+  /// \tparam JointCollection Collection of Joint types.
+  /// \tparam ConfigVectorType Type of the joint configuration vector.
+  /// \tparam TangentVectorType1 Type of the joint velocity vector.
+  /// \tparam TangentVectorType2 Type of the joint torque vector.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration vector (dim model.nq).
+  /// \param[in] v The joint velocity vector (dim model.nv).
+  /// \param[in] tau The joint torque vector (dim model.nv).
+  /// \param[in] num_threads Number of threads. It is only effective when Pinocchio is built with OpenMP support.
+  ///            With more than one thread, the model must be numbered in depth-first order (see finalizeModel).
+  ///
+  /// \return The current joint acceleration stored in data.ddq.
+  ///
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType, typename TangentVectorType1, typename TangentVectorType2>
+  inline const typename DataTpl<Scalar,Options,JointCollectionTpl>::TangentVectorType &
+  abaParallel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+              DataTpl<Scalar,Options,JointCollectionTpl> & data,
+              const Eigen::MatrixBase<ConfigVectorType> & q,
+              const Eigen::MatrixBase<TangentVectorType1> & v,
+              const Eigen::MatrixBase<TangentVectorType2> & tau,
+              const int num_threads);
+
   ///
   /// \brief The Articulated-Body algorithm. It computes the forward dynamics, aka the joint accelerations given the current state and actuation of the model.
   ///
@@ -9,6 +9,11 @@
 #include "pinocchio/multibody/visitor.hpp"
 #include "pinocchio/algorithm/check.hpp"
 
+#ifdef PINOCCHIO_WITH_PROFILER
+  #include "pinocchio/utils/profiler.hpp"
+#endif
+#include "pinocchio/algorithm/subtree-parallel.hpp"
+
 /// @cond DEV
 
 namespace pinocchio
@@ -218,37 +223,51 @@ namespace pinocchio
       const Eigen::MatrixBase<ConfigVectorType> & q,
       const Eigen::MatrixBase<TangentVectorType1> & v,
       const Eigen::MatrixBase<TangentVectorType2> & tau)
+  {
+    return abaParallel(model,data,q,v,tau,1);
+  }
+  
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType, typename TangentVectorType1, typename TangentVectorType2>
+  inline const typename DataTpl<Scalar,Options,JointCollectionTpl>::TangentVectorType &
+  abaParallel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+              DataTpl<Scalar,Options,JointCollectionTpl> & data,
+              const Eigen::MatrixBase<ConfigVectorType> & q,
+              const Eigen::MatrixBase<TangentVectorType1> & v,
+              const Eigen::MatrixBase<TangentVectorType2> & tau,
+              const int num_threads)
   {
     assert(model.check(data) && "data is not consistent with model.");
     assert(q.size() == model.nq && "The joint configuration vector is not of right size");
     assert(v.size() == model.nv && "The joint velocity vector is not of right size");
     assert(tau.size() == model.nv && "The joint acceleration vector is not of right size");
+    PINOCCHIO_PROFILER_SCOPE("aba");
     
-    typedef typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex JointIndex;
+    typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
+    typedef DataTpl<Scalar,Options,JointCollectionTpl> Data;
     
     data.v[0].setZero();
     data.a[0] = -model.gravity;
     data.u = tau;
     
     typedef AbaForwardStep1<Scalar,Options,JointCollectionTpl,ConfigVectorType,TangentVectorType1> Pass1;
-    for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
+    typename Pass1::ArgsType arg1(model,data,q.derived(),v.derived());
     {
-      Pass1::run(model.joints[i],data.joints[i],
-                 typename Pass1::ArgsType(model,data,q.derived(),v.derived()));
+      PINOCCHIO_PROFILER_SCOPE("forward pass 1");
+      forwardPassParallel(model,JointPassFunctor<Pass1,Model,Data>(model,data,arg1),num_threads);
     }
     
     typedef AbaBackwardStep<Scalar,Options,JointCollectionTpl> Pass2;
-    for(JointIndex i=(JointIndex)model.njoints-1;i>0; --i)
+    typename Pass2::ArgsType arg2(model,data);
     {
-      Pass2::run(model.joints[i],data.joints[i],
-                 typename Pass2::ArgsType(model,data));
+      PINOCCHIO_PROFILER_SCOPE("backward pass");
+      backwardPassParallel(model,JointPassFunctor<Pass2,Model,Data>(model,data,arg2),num_threads);
     }
 
     typedef AbaForwardStep2<Scalar,Options,JointCollectionTpl> Pass3;
-    for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
+    typename Pass3::ArgsType arg3(model,data);
     {
-      Pass3::run(model.joints[i],data.joints[i],
-                 typename Pass3::ArgsType(model,data));
+      PINOCCHIO_PROFILER_SCOPE("forward pass 2");
+      forwardPassParallel(model,JointPassFunctor<Pass3,Model,Data>(model,data,arg3),num_threads);
     }
     
     return data.ddq;
@@ -268,6 +287,7 @@ namespace pinocchio
     assert(q.size() == model.nq && "The joint configuration vector is not of right size");
     assert(v.size() == model.nv && "The joint velocity vector is not of right size");
     assert(tau.size() == model.nv && "The joint acceleration vector is not of right size");
+    PINOCCHIO_PROFILER_SCOPE("aba");
     
     typedef typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex JointIndex;
     
@@ -276,25 +296,34 @@ namespace pinocchio
     data.u = tau;
     
     typedef AbaForwardStep1<Scalar,Options,JointCollectionTpl,ConfigVectorType,TangentVectorType1> Pass1;
-    for(JointIndex i=1;i<(JointIndex)model.njoints;++i)
     {
-      Pass1::run(model.joints[i],data.joints[i],
-                 typename Pass1::ArgsType(model,data,q.derived(),v.derived()));
-      data.f[i] -= fext[i];
+      PINOCCHIO_PROFILER_SCOPE("forward pass 1");
+      for(JointIndex i=1;i<(JointIndex)model.njoints;++i)
+      {
+        Pass1::run(model.joints[i],data.joints[i],
+                   typename Pass1::ArgsType(model,data,q.derived(),v.derived()));
+        data.f[i] -= fext[i];
+      }
     }
     
     typedef AbaBackwardStep<Scalar,Options,JointCollectionTpl> Pass2;
-    for(JointIndex i=(JointIndex)model.njoints-1;i>0; --i)
     {
-      Pass2::run(model.joints[i],data.joints[i],
-                 typename Pass2::ArgsType(model,data));
+      PINOCCHIO_PROFILER_SCOPE("backward pass");
+      for(JointIndex i=(JointIndex)model.njoints-1;i>0; --i)
+      {
+        Pass2::run(model.joints[i],data.joints[i],
+                   typename Pass2::ArgsType(model,data));
+      }
     }
     
     typedef AbaForwardStep2<Scalar,Options,JointCollectionTpl> Pass3;
-    for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
     {
-      Pass3::run(model.joints[i],data.joints[i],
-                 typename Pass3::ArgsType(model,data));
+      PINOCCHIO_PROFILER_SCOPE("forward pass 2");
+      for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
+      {
+        Pass3::run(model.joints[i],data.joints[i],
+                   typename Pass3::ArgsType(model,data));
+      }
     }
     
     return data.ddq;
@@ -455,30 +484,40 @@ namespace pinocchio
   {
     assert(model.check(data) && "data is not consistent with model.");
     assert(q.size() == model.nq && "The joint configuration vector is not of right size");
+    PINOCCHIO_PROFILER_SCOPE("computeMinverse");
     
     typedef typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex JointIndex;
     data.Minv.template triangularView<Eigen::Upper>().setZero();
     
     typedef ComputeMinverseForwardStep1<Scalar,Options,JointCollectionTpl,ConfigVectorType> Pass1;
-    for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
     {
-      Pass1::run(model.joints[i],data.joints[i],
-                 typename Pass1::ArgsType(model,data,q.derived()));
+      PINOCCHIO_PROFILER_SCOPE("forward pass 1");
+      for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
+      {
+        Pass1::run(model.joints[i],data.joints[i],
+                   typename Pass1::ArgsType(model,data,q.derived()));
+      }
     }
     
     data.Fcrb[0].setZero();
     typedef ComputeMinverseBackwardStep<Scalar,Options,JointCollectionTpl> Pass2;
-    for(JointIndex i=(JointIndex)model.njoints-1; i>0; --i)
     {
-      Pass2::run(model.joints[i],data.joints[i],
-                 typename Pass2::ArgsType(model,data));
+      PINOCCHIO_PROFILER_SCOPE("backward pass");
+      for(JointIndex i=(JointIndex)model.njoints-1; i>0; --i)
+      {
+        Pass2::run(model.joints[i],data.joints[i],
+                   typename Pass2::ArgsType(model,data));
+      }
     }
 
     typedef ComputeMinverseForwardStep2<Scalar,Options,JointCollectionTpl> Pass3;
-    for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
     {
-      Pass3::run(model.joints[i],data.joints[i],
-                 typename Pass3::ArgsType(model,data));
+      PINOCCHIO_PROFILER_SCOPE("forward pass 2");
+      for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
+      {
+        Pass3::run(model.joints[i],data.joints[i],
+                   typename Pass3::ArgsType(model,data));
+      }
     }
     
     return data.Minv;
@@ -126,6 +126,7 @@ namespace pinocchio
     CHECK_DATA( (int)data.nvSubtree.size()         == model.njoints );
     CHECK_DATA( (int)data.parents_fromRow.size()   == model.nv );
     CHECK_DATA( (int)data.nvSubtree_fromRow.size() == model.nv );
+    CHECK_DATA( (int)data.supportSpans.size()      == model.njoints );
 
     for( JointIndex j=1;int(j)<model.njoints;++j )
       {
@@ -37,24 +37,41 @@ namespace pinocchio
       assert(model.check(data) && "data is not consistent with model.");
 #endif
       typedef DataTpl<Scalar,Options,JointCollectionTpl> Data;
+      typedef typename Data::ColumnSpanVector ColumnSpanVector;
 
       const typename Data::MatrixXs & M = data.M;
       typename Data::MatrixXs & U = data.U;
       typename Data::VectorXs & D = data.D;
       typename Data::VectorXs & Dinv = data.Dinv;
       
-      for(int j=model.nv-1;j>=0;--j )
+      // The rows j are visited in decreasing order, joint by joint.
+      for(JointIndex i=(JointIndex)(model.njoints-1);i>0;--i)
       {
-        const int NVT = data.nvSubtree_fromRow[(size_t)j]-1;
-        typename Data::VectorXs::SegmentReturnType DUt = data.tmp.head(NVT);
-        if(NVT)
-          DUt.noalias() = U.row(j).segment(j+1,NVT).transpose()
-          .cwiseProduct(D.segment(j+1,NVT));
-        
-        D[j] = M(j,j) - U.row(j).segment(j+1,NVT).dot(DUt);
-        Dinv[j] = Scalar(1)/D[j];
-        for(int _i = data.parents_fromRow[(size_t)j]; _i >= 0;_i = data.parents_fromRow[(size_t)_i])
-          U(_i,j) = (M(_i,j) - U.row(_i).segment(j+1,NVT).dot(DUt)) * Dinv[j];
+        const int idx_vi = model.joints[i].idx_v();
+        const ColumnSpanVector & spans = data.supportSpans[i];
+        for(int j=idx_vi+model.joints[i].nv()-1;j>=idx_vi;--j)
+        {
+          const int NVT = data.nvSubtree_fromRow[(size_t)j]-1;
+          typename Data::VectorXs::SegmentReturnType DUt = data.tmp.head(NVT);
+          if(NVT)
+            DUt.noalias() = U.row(j).segment(j+1,NVT).transpose()
+            .cwiseProduct(D.segment(j+1,NVT));
+          
+          D[j] = M(j,j) - U.row(j).segment(j+1,NVT).dot(DUt);
+          Dinv[j] = Scalar(1)/D[j];
+          
+          // The rows supporting j are the spans of joint i, the last one being cut at row j.
+          for(typename ColumnSpanVector::const_iterator span = spans.begin(); span != spans.end(); ++span)
+          {
+            const int rows = std::min(span->second,j-span->first);
+            if(rows <= 0) break;
+            typename Data::MatrixXs::ColXpr::SegmentReturnType Uj = U.col(j).segment(span->first,rows);
+            Uj = M.col(j).segment(span->first,rows);
+            if(NVT)
+              Uj.noalias() -= U.block(span->first,j+1,rows,NVT) * DUt;
+            Uj *= Dinv[j];
+          }
+        }
       }
       
       return data.U;
@@ -70,9 +87,21 @@ namespace pinocchio
                         const DataTpl<Scalar,Options,JointCollectionTpl> & data,
                         const Eigen::MatrixBase<Mat> & m)
         {
+          typedef DataTpl<Scalar,Options,JointCollectionTpl> Data;
+          
+#ifndef NDEBUG
+          assert(model.check(data) && "data is not consistent with model.");
+#endif
+          assert(m.rows() == model.nv);
           Mat & m_ = EIGEN_CONST_CAST(Mat,m);
-          for(int k = 0; k < m_.cols(); ++k)
-            cholesky::Uv(model,data,m_.col(k));
+          
+          const typename Data::MatrixXs & U = data.U;
+          const std::vector<int> & nvt = data.nvSubtree_fromRow;
+          
+          // All the columns are updated together, row by row. The products are coefficient-based
+          // (lazyProduct), which avoids the dispatch overhead of GEMV for a few columns.
+          for(int k=0;k < model.nv-1;++k) // You can stop one step before nv
+            m_.row(k).noalias() += U.row(k).segment(k+1,nvt[(size_t)k]-1).lazyProduct(m_.middleRows(k+1,nvt[(size_t)k]-1));
         }
       };
       
@@ -125,9 +154,20 @@ namespace pinocchio
                         const DataTpl<Scalar,Options,JointCollectionTpl> & data,
                         const Eigen::MatrixBase<Mat> & m)
         {
+          typedef DataTpl<Scalar,Options,JointCollectionTpl> Data;
+          
+#ifndef NDEBUG
+          assert(model.check(data) && "data is not consistent with model.");
+#endif
+          assert(m.rows() == model.nv);
           Mat & m_ = EIGEN_CONST_CAST(Mat,m);
-          for(int k = 0; k < m_.cols(); ++k)
-            cholesky::Utv(model,data,m_.col(k));
+          
+          const typename Data::MatrixXs & U = data.U;
+          const std::vector<int> & nvt = data.nvSubtree_fromRow;
+          
+          // All the columns are updated together, by rank-one updates of the subtree rows.
+          for( int k=model.nv-2;k>=0;--k ) // You can start from nv-2 (no child in nv-1)
+            m_.middleRows(k+1,nvt[(size_t)k]-1).noalias() += U.row(k).segment(k+1,nvt[(size_t)k]-1).transpose().lazyProduct(m_.row(k));
         }
       };
       
@@ -180,9 +220,20 @@ namespace pinocchio
                         const DataTpl<Scalar,Options,JointCollectionTpl> & data,
                         const Eigen::MatrixBase<Mat> & m)
         {
+          typedef DataTpl<Scalar,Options,JointCollectionTpl> Data;
+          
+#ifndef NDEBUG
+          assert(model.check(data) && "data is not consistent with model.");
+#endif
+          assert(m.rows() == model.nv);
           Mat & m_ = EIGEN_CONST_CAST(Mat,m);
-          for(int k = 0; k < m_.cols(); ++k)
-            cholesky::Uiv(model,data,m_.col(k));
+          
+          const typename Data::MatrixXs & U = data.U;
+          const std::vector<int> & nvt = data.nvSubtree_fromRow;
+          
+          // All the columns are substituted together, row by row.
+          for(int k=model.nv-2;k>=0;--k) // You can start from nv-2 (no child in nv-1)
+            m_.row(k).noalias() -= U.row(k).segment(k+1,nvt[(size_t)k]-1).lazyProduct(m_.middleRows(k+1,nvt[(size_t)k]-1));
         }
       };
       
@@ -236,9 +287,20 @@ namespace pinocchio
                         const DataTpl<Scalar,Options,JointCollectionTpl> & data,
                         const Eigen::MatrixBase<Mat> & m)
         {
+          typedef DataTpl<Scalar,Options,JointCollectionTpl> Data;
+          
+#ifndef NDEBUG
+          assert(model.check(data) && "data is not consistent with model.");
+#endif
+          assert(m.rows() == model.nv);
           Mat & m_ = EIGEN_CONST_CAST(Mat,m);
-          for(int k = 0; k < m_.cols(); ++k)
-            cholesky::Utiv(model,data,m_.col(k));
+          
+          const typename Data::MatrixXs & U = data.U;
+          const std::vector<int> & nvt = data.nvSubtree_fromRow;
+          
+          // All the columns are substituted together, by rank-one updates of the subtree rows.
+          for(int k=0; k<model.nv-1; ++k) // You can stop one step before nv.
+            m_.middleRows(k+1,nvt[(size_t)k]-1).noalias() -= U.row(k).segment(k+1,nvt[(size_t)k]-1).transpose().lazyProduct(m_.row(k));
         }
       };
       
@@ -292,9 +354,24 @@ namespace pinocchio
                         const Eigen::MatrixBase<MatRes> & mout
                         )
         {
+          typedef DataTpl<Scalar,Options,JointCollectionTpl> Data;
+          
+#ifndef NDEBUG
+          assert(model.check(data) && "data is not consistent with model.");
+#endif
+          assert(min.rows() == model.nv);
+          assert(mout.rows() == model.nv && mout.cols() == min.cols());
           MatRes & mout_ = EIGEN_CONST_CAST(MatRes,mout);
-          for(int k = 0; k < min.cols(); ++k)
-            cholesky::Mv(model,data,min.col(k),mout_.col(k));
+          
+          const typename Data::MatrixXs & M = data.M;
+          const std::vector<int> & nvt = data.nvSubtree_fromRow;
+          
+          // All the columns are computed together, row by row.
+          for(int k=model.nv-1;k>=0;--k)
+          {
+            mout_.row(k).noalias() = M.row(k).segment(k,nvt[(size_t)k]).lazyProduct(min.middleRows(k,nvt[(size_t)k]));
+            mout_.middleRows(k+1,nvt[(size_t)k]-1).noalias() += M.row(k).segment(k+1,nvt[(size_t)k]-1).transpose().lazyProduct(min.row(k));
+          }
         }
       };
       
@@ -380,9 +457,16 @@ namespace pinocchio
                         const DataTpl<Scalar,Options,JointCollectionTpl> & data,
                         const Eigen::MatrixBase<Mat> & m)
         {
+#ifndef NDEBUG
+          assert(model.check(data) && "data is not consistent with model.");
+#endif
+          assert(m.rows() == model.nv);
+          
           Mat & m_ = EIGEN_CONST_CAST(Mat,m);
-          for(int k = 0; k < m_.cols(); ++k)
-            cholesky::UDUtv(model,data,m_.col(k));
+          
+          cholesky::Utv(model,data,m_);
+          m_ = data.D.asDiagonal() * m_;
+          cholesky::Uv(model,data,m_);
         }
       };
       
@@ -431,9 +515,15 @@ namespace pinocchio
                         const DataTpl<Scalar,Options,JointCollectionTpl> & data,
                         const Eigen::MatrixBase<Mat> & m)
         {
+#ifndef NDEBUG
+          assert(model.check(data) && "data is not consistent with model.");
+#endif
+          
           Mat & m_ = EIGEN_CONST_CAST(Mat,m);
-          for(int k = 0; k < m_.cols(); ++k)
-            cholesky::solve(model,data,m_.col(k));
+          
+          cholesky::Uiv(model,data,m_);
+          m_ = data.Dinv.asDiagonal() * m_;
+          cholesky::Utiv(model,data,m_);
         }
       };
       
@@ -35,6 +35,29 @@ namespace pinocchio
        DataTpl<Scalar,Options,JointCollectionTpl> & data,
        const Eigen::MatrixBase<ConfigVectorType> & q);
   
+  ///
+  /// \brief Computes the upper triangular part of the joint space inertia matrix M with the Composite Rigid Body
+  ///        Algorithm, the independent branches of the kinematic tree being handled by different threads
+  ///        (see forwardPassParallel and backwardPassParallel). The result is accessible through data.M.
+  ///
+  /// \tparam JointCollection Collection of Joint types.
+  /// \tparam ConfigVectorType Type of the joint configuration vector.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration vector (dim model.nq).
+  /// \param[in] num_threads Number of threads. It is only effective when Pinocchio is built with OpenMP support.
+  ///            With more than one thread, the model must be numbered in depth-first order (see finalizeModel).
+  ///
+  /// \return The joint space inertia matrix with only the upper triangular part computed.
+  ///
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType>
+  inline const typename DataTpl<Scalar,Options,JointCollectionTpl>::MatrixXs &
+  crbaParallel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+               DataTpl<Scalar,Options,JointCollectionTpl> & data,
+               const Eigen::MatrixBase<ConfigVectorType> & q,
+               const int num_threads);
+  
   ///
   /// \brief Computes the upper triangular part of the joint space inertia matrix M by
   ///        using the Composite Rigid Body Algorithm (Chapter 6, Rigid-Body Dynamics Algorithms, R. Featherstone, 2008).
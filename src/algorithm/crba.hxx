@@ -10,6 +10,11 @@
 #include "pinocchio/algorithm/kinematics.hpp"
 #include "pinocchio/algorithm/check.hpp"
 
+#ifdef PINOCCHIO_WITH_PROFILER
+  #include "pinocchio/utils/profiler.hpp"
+#endif
+#include "pinocchio/algorithm/subtree-parallel.hpp"
+
 /// @cond DEV
 
 namespace pinocchio 
@@ -176,24 +181,36 @@ namespace pinocchio
   crba(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
        DataTpl<Scalar,Options,JointCollectionTpl> & data,
        const Eigen::MatrixBase<ConfigVectorType> & q)
+  {
+    return crbaParallel(model,data,q,1);
+  }
+  
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType>
+  inline const typename DataTpl<Scalar,Options,JointCollectionTpl>::MatrixXs &
+  crbaParallel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+               DataTpl<Scalar,Options,JointCollectionTpl> & data,
+               const Eigen::MatrixBase<ConfigVectorType> & q,
+               const int num_threads)
   {
     assert(model.check(data) && "data is not consistent with model.");
     assert(q.size() == model.nq && "The configuration vector is not of right size");
+    PINOCCHIO_PROFILER_SCOPE("crba");
     
-    typedef typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex JointIndex;
+    typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
+    typedef DataTpl<Scalar,Options,JointCollectionTpl> Data;
     
     typedef CrbaForwardStep<Scalar,Options,JointCollectionTpl,ConfigVectorType> Pass1;
-    for(JointIndex i=1; i<(JointIndex)(model.njoints); ++i)
+    typename Pass1::ArgsType arg1(model,data,q.derived());
     {
-      Pass1::run(model.joints[i],data.joints[i],
-                 typename Pass1::ArgsType(model,data,q.derived()));
+      PINOCCHIO_PROFILER_SCOPE("forward pass");
+      forwardPassParallel(model,JointPassFunctor<Pass1,Model,Data>(model,data,arg1),num_threads);
     }
     
     typedef CrbaBackwardStep<Scalar,Options,JointCollectionTpl> Pass2;
-    for(JointIndex i=(JointIndex)(model.njoints-1); i>0; --i)
+    typename Pass2::ArgsType arg2(model,data);
     {
-      Pass2::run(model.joints[i],data.joints[i],
-                 typename Pass2::ArgsType(model,data));
+      PINOCCHIO_PROFILER_SCOPE("backward pass");
+      backwardPassParallel(model,JointPassFunctor<Pass2,Model,Data>(model,data,arg2),num_threads);
     }
 
     return data.M;
@@ -207,21 +224,28 @@ namespace pinocchio
   {
     assert(model.check(data) && "data is not consistent with model.");
     assert(q.size() == model.nq && "The configuration vector is not of right size");
+    PINOCCHIO_PROFILER_SCOPE("crbaMinimal");
     
     typedef typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex JointIndex;
     
     typedef CrbaForwardStepMinimal<Scalar,Options,JointCollectionTpl,ConfigVectorType> Pass1;
-    for(JointIndex i=1; i<(JointIndex)(model.njoints); ++i)
     {
-      Pass1::run(model.joints[i],data.joints[i],
-                 typename Pass1::ArgsType(model,data,q.derived()));
+      PINOCCHIO_PROFILER_SCOPE("forward pass");
+      for(JointIndex i=1; i<(JointIndex)(model.njoints); ++i)
+      {
+        Pass1::run(model.joints[i],data.joints[i],
+                   typename Pass1::ArgsType(model,data,q.derived()));
+      }
     }
     
     typedef CrbaBackwardStepMinimal<Scalar,Options,JointCollectionTpl> Pass2;
-    for(JointIndex i=(JointIndex)(model.njoints-1); i>0; --i)
     {
-      Pass2::run(model.joints[i],data.joints[i],
-                 typename Pass2::ArgsType(model,data));
+      PINOCCHIO_PROFILER_SCOPE("backward pass");
+      for(JointIndex i=(JointIndex)(model.njoints-1); i>0; --i)
+      {
+        Pass2::run(model.joints[i],data.joints[i],
+                   typename Pass2::ArgsType(model,data));
+      }
     }
     
     // Retrieve the Centroidal Momemtum map
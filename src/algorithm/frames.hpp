@@ -25,6 +25,22 @@ namespace pinocchio
   inline void updateFramePlacements(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
                                     DataTpl<Scalar,Options,JointCollectionTpl> & data);
 
+  /**
+   * @brief      Updates the position of each frame contained in the model, in the quaternion representation
+   *             (data.oMf_quat). The frame placements are converted on the fly, unless their rotation is the identity.
+   *             data.oMf is not updated. data.oMf_quat is allocated by the first call.
+   *
+   * @tparam JointCollection Collection of Joint types.
+   *
+   * @param[in]  model  The kinematic model.
+   * @param      data   Data associated to model.
+   *
+   * @warning    forwardKinematicsQuaternion should have been called first
+   */
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+  inline void updateFramePlacementsQuaternion(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                              DataTpl<Scalar,Options,JointCollectionTpl> & data);
+
   /**
    * @brief      Updates the placement of the given frame.
    *
@@ -59,6 +75,23 @@ namespace pinocchio
                                       DataTpl<Scalar,Options,JointCollectionTpl> & data,
                                       const Eigen::MatrixBase<ConfigVectorType> & q);
 
+  /**
+   * @brief      First calls forwardKinematicsQuaternion on the model, then computes the placement of each frame
+   *             in the quaternion representation.
+   *             /sa pinocchio::forwardKinematicsQuaternion.
+   *
+   * @tparam JointCollection Collection of Joint types.
+   * @tparam ConfigVectorType Type of the joint configuration vector.
+   *
+   * @param[in]  model                    The kinematic model.
+   * @param      data                     Data associated to model.
+   * @param[in]  q                        Configuration vector.
+   */
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType>
+  inline void framesForwardKinematicsQuaternion(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                                DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                                const Eigen::MatrixBase<ConfigVectorType> & q);
+
 
   /**
    * @brief      Returns the spatial velocity of the frame expressed in the LOCAL frame coordinate system.
@@ -104,6 +137,32 @@ namespace pinocchio
                                const ReferenceFrame rf,
                                const Eigen::MatrixBase<Matrix6xLike> & J);
   
+  /**
+   * @brief      Returns the stacked jacobians of a set of frames, expressed either in the LOCAL frame coordinate system of each frame
+   *             or in the WORLD coordinate system, depending on the value of rf. It is equivalent to calling pinocchio::getFrameJacobian
+   *             for each frame, but the SE3 action is applied on the whole column block of each supporting joint and
+   *             the frames sharing the same Jacobian (same parent joint and, for LOCAL, same placement) are only computed once.
+   *             You must first call pinocchio::computeJointJacobians followed by pinocchio::framesForwardKinematics to update placement values in data structure.
+   *
+   * @tparam JointCollection Collection of Joint types.
+   * @tparam MatrixLike Type of the matrix containing the stacked Jacobians.
+   *
+   * @param[in]  model       The kinematic model
+   * @param[in]  data        Data associated to model
+   * @param[in]  frame_ids   Ids of the operational Frames
+   * @param[in]  rf          Reference frame in which the Jacobians are expressed.
+   * @param[out] J           The stacked Jacobians (dim 6*frame_ids.size() x model.nv): rows 6*k to 6*k+5 contain the Jacobian of frame_ids[k].
+   *                         Only the columns of the joints supporting each frame are written, the others must be set to zero by the caller.
+   *
+   * @warning    The function pinocchio::computeJointJacobians and pinocchio::framesForwardKinematics should have been called first.
+   */
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename MatrixLike>
+  inline void getFrameJacobians(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                const DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                const std::vector<typename ModelTpl<Scalar,Options,JointCollectionTpl>::FrameIndex> & frame_ids,
+                                const ReferenceFrame rf,
+                                const Eigen::MatrixBase<MatrixLike> & J);
+  
 
    /**
    * @brief      Returns the spatial acceleration of the frame expressed in the LOCAL frame coordinate system.
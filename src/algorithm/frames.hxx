@@ -8,6 +8,7 @@
 #include "pinocchio/algorithm/kinematics.hpp"
 #include "pinocchio/algorithm/jacobian.hpp"
 #include "pinocchio/algorithm/check.hpp"
+#include "pinocchio/spatial/act-on-set.hpp"
 
 namespace pinocchio 
 {
@@ -36,6 +37,32 @@ namespace pinocchio
     }
   }
   
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+  inline void updateFramePlacementsQuaternion(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                              DataTpl<Scalar,Options,JointCollectionTpl> & data)
+  {
+    assert(model.check(data) && "data is not consistent with model.");
+    
+    typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
+    typedef typename Model::FrameIndex FrameIndex;
+    typedef typename Model::JointIndex JointIndex;
+    typedef typename DataTpl<Scalar,Options,JointCollectionTpl>::SE3Quaternion SE3Quaternion;
+    
+    // The placements are only allocated by the first call.
+    if(data.oMf_quat.size() != (std::size_t)model.nframes)
+      data.oMf_quat.assign((std::size_t)model.nframes,SE3Quaternion::Identity());
+    
+    for (FrameIndex i=1; i < (FrameIndex) model.nframes; ++i)
+    {
+      const Frame & frame = model.frames[i];
+      const JointIndex & parent = frame.parent;
+      if (frame.placement.isIdentity())
+        data.oMf_quat[i] = data.oMi_quat[parent];
+      else
+        details::composeQuaternion(data.oMi_quat[parent],frame.placement,data.oMf_quat[i]);
+    }
+  }
+  
   template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
   inline const typename DataTpl<Scalar,Options,JointCollectionTpl>::SE3 &
   updateFramePlacement(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
@@ -74,6 +101,17 @@ namespace pinocchio
     updateFramePlacements(model, data);
   }
 
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType>
+  inline void framesForwardKinematicsQuaternion(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                                DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                                const Eigen::MatrixBase<ConfigVectorType> & q)
+  {
+    assert(model.check(data) && "data is not consistent with model.");
+    
+    forwardKinematicsQuaternion(model, data, q);
+    updateFramePlacementsQuaternion(model, data);
+  }
+
   template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename MotionLike>
   void getFrameVelocity(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
                         const DataTpl<Scalar,Options,JointCollectionTpl> & data,
@@ -130,15 +168,66 @@ namespace pinocchio
     
     if(rf == LOCAL)
     {
+      typedef typename Data::ColumnSpanVector ColumnSpanVector;
+      
       Matrix6xLike & J_ = EIGEN_CONST_CAST(Matrix6xLike,J);
       const typename Data::SE3 & oMframe = data.oMf[frame_id];
-      const int colRef = nv(model.joints[joint_id])+idx_v(model.joints[joint_id])-1;
+      const ColumnSpanVector & spans = data.supportSpans[joint_id];
       
-      for(Eigen::DenseIndex j=colRef;j>=0;j=data.parents_fromRow[(size_t) j])
+      for(typename ColumnSpanVector::const_iterator span = spans.begin(); span != spans.end(); ++span)
+        motionSet::se3ActionInverse(oMframe,data.J.middleCols(span->first,span->second),
+                                    J_.middleCols(span->first,span->second));
+      return;
+    }
+  }
+  
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename MatrixLike>
+  inline void getFrameJacobians(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                const DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                const std::vector<typename ModelTpl<Scalar,Options,JointCollectionTpl>::FrameIndex> & frame_ids,
+                                const ReferenceFrame rf,
+                                const Eigen::MatrixBase<MatrixLike> & J)
+  {
+    assert(J.rows() == 6*(Eigen::DenseIndex)frame_ids.size());
+    assert(J.cols() == model.nv);
+    assert(data.J.cols() == model.nv);
+    assert(model.check(data) && "data is not consistent with model.");
+    
+    typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
+    typedef DataTpl<Scalar,Options,JointCollectionTpl> Data;
+    typedef typename Model::Frame Frame;
+    typedef typename Model::JointIndex JointIndex;
+    typedef typename Data::ColumnSpanVector ColumnSpanVector;
+    
+    MatrixLike & J_ = EIGEN_CONST_CAST(MatrixLike,J);
+    
+    for(size_t k = 0; k < frame_ids.size(); ++k)
+    {
+      const Frame & frame = model.frames[frame_ids[k]];
+      const JointIndex joint_id = frame.parent;
+      const Eigen::DenseIndex row = 6*(Eigen::DenseIndex)k;
+      
+      // Look for a previous frame sharing the same Jacobian
+      size_t ref = k;
+      for(size_t l = 0; l < k && ref == k; ++l)
       {
-        J_.col(j) = oMframe.actInv(Motion(data.J.col(j))).toVector(); // TODO: use MotionRef
+        const Frame & other = model.frames[frame_ids[l]];
+        if(other.parent == joint_id && (rf == WORLD || other.placement == frame.placement))
+          ref = l;
+      }
+      
+      // Traverse the supporting columns by contiguous blocks
+      const ColumnSpanVector & spans = data.supportSpans[joint_id];
+      for(typename ColumnSpanVector::const_iterator span = spans.begin(); span != spans.end(); ++span)
+      {
+        typename MatrixLike::BlockXpr J_block = J_.block(row,span->first,6,span->second);
+        if(ref != k)
+          J_block = J_.block(6*(Eigen::DenseIndex)ref,span->first,6,span->second);
+        else if(rf == WORLD)
+          J_block = data.J.middleCols(span->first,span->second);
+        else
+          motionSet::se3ActionInverse(data.oMf[frame_ids[k]],data.J.middleCols(span->first,span->second),J_block);
       }
-      return;
     }
   }
   
@@ -176,14 +265,15 @@ namespace pinocchio
     
     if (rf == LOCAL)
     {
+      typedef typename DataTpl<Scalar,Options,JointCollectionTpl>::ColumnSpanVector ColumnSpanVector;
+      
       Matrix6xLike & dJ_ = EIGEN_CONST_CAST(Matrix6xLike,dJ);
       const SE3 & oMframe = data.oMf[frame_id];
-      const int colRef = nv(model.joints[joint_id])+idx_v(model.joints[joint_id])-1;
+      const ColumnSpanVector & spans = data.supportSpans[joint_id];
       
-      for(int j=colRef;j>=0;j=data.parents_fromRow[(size_t) j])
-      {
-        dJ_.col(j) = oMframe.actInv(Motion(data.dJ.col(j))).toVector();
-      }
+      for(typename ColumnSpanVector::const_iterator span = spans.begin(); span != spans.end(); ++span)
+        motionSet::se3ActionInverse(oMframe,data.dJ.middleCols(span->first,span->second),
+                                    dJ_.middleCols(span->first,span->second));
       return;
     }    
   }
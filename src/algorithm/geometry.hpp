@@ -10,6 +10,8 @@
 #include "pinocchio/multibody/data.hpp"
 
 #include "pinocchio/algorithm/kinematics.hpp"
+#include "pinocchio/algorithm/joint-configuration.hpp"
+#include "pinocchio/algorithm/jacobian.hpp"
 #include "pinocchio/multibody/geometry.hpp"
 
 namespace pinocchio
@@ -50,6 +52,73 @@ namespace pinocchio
                                        const GeometryModel & geomModel,
                                        GeometryData & geomData);
 
+  ///
+  /// \brief Update the placement of the geometry objects which are attached to a moving joint, according to the
+  ///        current joint placements contained in data. The update is split among num_threads threads.
+  ///
+  /// \tparam JointCollection Collection of Joint types.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] geomModel The geometry model containing the collision objects.
+  /// \param[out] geomData The geometry data containing the placements of the collision objects. See oMg field in GeometryData.
+  /// \param[in] num_threads Number of threads. It is only effective when Pinocchio is built with OpenMP support.
+  ///
+  /// \note The objects attached to the universe are placed once by the constructor of GeometryData
+  ///       (see GeometryData::movingObjects). If their placement in geomModel is modified afterwards, use the
+  ///       version above which updates all the objects.
+  ///
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+  inline void updateGeometryPlacements(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                       const DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                       const GeometryModel & geomModel,
+                                       GeometryData & geomData,
+                                       const int num_threads);
+
+  ///
+  /// \brief Apply a forward kinematics in the quaternion representation and update the placement of the geometry
+  ///        objects in the same representation. See oMg_quat field in GeometryData.
+  ///
+  /// \tparam JointCollection Collection of Joint types.
+  /// \tparam ConfigVectorType Type of the joint configuration vector.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] geomModel The geometry model containing the collision objects.
+  /// \param[out] geomData The geometry data containing the placements of the collision objects.
+  /// \param[in] q The joint configuration vector (dim model.nq).
+  ///
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType>
+  inline void updateGeometryPlacementsQuaternion(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                                 DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                                 const GeometryModel & geomModel,
+                                                 GeometryData & geomData,
+                                                 const Eigen::MatrixBase<ConfigVectorType> & q);
+
+  ///
+  /// \brief Update the placement of the geometry objects which are attached to a moving joint, according to the
+  ///        joint placements contained in data.oMi_quat (see forwardKinematicsQuaternion).
+  ///        The update is split among num_threads threads.
+  ///
+  /// \tparam JointCollection Collection of Joint types.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] geomModel The geometry model containing the collision objects.
+  /// \param[out] geomData The geometry data containing the placements of the collision objects. See oMg_quat field in GeometryData.
+  /// \param[in] num_threads Number of threads. It is only effective when Pinocchio is built with OpenMP support.
+  ///
+  /// \note Only geomData.oMg_quat and the collision objects are updated, geomData.oMg is left untouched.
+  ///       The placements of the objects are converted on the fly, unless their rotation is the identity.
+  ///       geomData.oMg_quat is allocated by the first call.
+  ///
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+  inline void updateGeometryPlacementsQuaternion(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                                 const DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                                 const GeometryModel & geomModel,
+                                                 GeometryData & geomData,
+                                                 const int num_threads);
+
 #ifdef PINOCCHIO_WITH_HPP_FCL
 
   ///
@@ -104,7 +173,9 @@ namespace pinocchio
   ///
   /// \return A reference on fcl struct containing the distance result, referring an element
   /// of vector geomData::distanceResults.
-  /// \note The complete distance result is also available in geomData.distanceResults[pairId]
+  /// \note The complete distance result is also available in geomData.distanceResults[pairId].
+  ///       The placements of the two objects are stored in geomData.distancePlacements for later use by
+  ///       computeDistances with a culling threshold.
   ///
   fcl::DistanceResult & computeDistance(const GeometryModel & geomModel,
                                         GeometryData & geomData,
@@ -175,6 +246,104 @@ namespace pinocchio
                                       const GeometryModel & geomModel,
                                       GeometryData & geomData);
 
+  ///
+  /// \brief Calls computeDistance for the active pairs of GeometryData which may be closer than threshold,
+  ///        or closer than the closest pair.
+  ///
+  /// \details For each pair, a lower bound on its current distance is obtained from its last computed distance minus
+  ///          the displacement of the two objects since that computation, bounded from the change of their placements
+  ///          and the extent of their local AABB. The pairs whose bound is below threshold are evaluated first. The other
+  ///          ones are then only evaluated if their bound is below the smallest distance computed so far. Otherwise,
+  ///          fcl is not called and geomData.distanceResults keeps the previous result, witness points included.
+  ///          The bounds are stored in geomData.distanceLowerBounds. In a control loop with small configuration
+  ///          changes, only the pairs close to the threshold are evaluated at each tick.
+  ///
+  /// \param[in] geomModel geometry model (const)
+  /// \param[out] geomData corresponding geometry data (nonconst) where distances are computed
+  /// \param[in] threshold pairs whose lower bound is above this distance, and above the smallest computed distance, are skipped.
+  ///
+  /// \return The index of the collision pair with the smallest distance, which is always computed during the call.
+  ///
+  inline std::size_t computeDistances(const GeometryModel & geomModel,
+                                      GeometryData & geomData,
+                                      const double threshold);
+
+  ///
+  /// Compute the forward kinematics, update the geometry placements and calls
+  /// computeDistances(geomModel,geomData,threshold).
+  ///
+  /// \tparam JointCollection Collection of Joint types.
+  /// \tparam ConfigVectorType Type of the joint configuration vector.
+  ///
+  /// \param[in] model: robot model (const)
+  /// \param[in] data: corresponding data (nonconst) where FK results are stored
+  /// \param[in] geomModel: geometry model (const)
+  /// \param[out] geomData: corresponding geometry data (nonconst) where distances are computed
+  /// \param[in] q: robot configuration.
+  /// \param[in] threshold: pairs which are proven to be farther than this distance, and than the closest pair, are skipped.
+  ///
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType>
+  inline std::size_t computeDistances(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                      DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                      const GeometryModel & geomModel,
+                                      GeometryData & geomData,
+                                      const Eigen::MatrixBase<ConfigVectorType> & q,
+                                      const double threshold);
+
+  ///
+  /// \brief Compute the partial derivatives of the distances of the active collision pairs with respect to the
+  ///        joint configuration, at the placements of the objects stored in geomData.oMg.
+  ///
+  /// \details With n the unit vector from the nearest point p1 of the first object to the nearest point p2 of the
+  ///          second one, the row of a pair is n^T (J(p2) - J(p1)), J(p) being the Jacobian of the linear velocity of
+  ///          point p. Only the columns of the joints which support one object but not the other are non zero.
+  ///          The rows of inactive or colliding pairs are set to zero.
+  ///
+  /// \tparam JointCollection Collection of Joint types.
+  /// \tparam Matrix Type of the matrix containing the partial derivatives.
+  ///
+  /// \param[in] model robot model (const)
+  /// \param[in] data corresponding data (const), containing the world Jacobians of computeJointJacobians.
+  /// \param[in] geomModel geometry model (const)
+  /// \param[in] geomData corresponding geometry data (const), containing the placements of the objects (see
+  ///            updateGeometryPlacements) at the same configuration.
+  /// \param[out] distance_partial_dq partial derivatives of the distances (dim geomModel.collisionPairs.size() x model.nv).
+  ///
+  /// \note The nearest points are recomputed for each active pair, so that they are known in the frame of their object
+  ///       whatever the convention of the installed hpp-fcl: fcl::distance is called with the first object placed at
+  ///       the origin, then between the second object placed at the origin and the nearest point of the first one.
+  ///       geomData.distanceResults is left untouched.
+  ///
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename Matrix>
+  inline void computeDistancesDerivatives(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                          const DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                          const GeometryModel & geomModel,
+                                          const GeometryData & geomData,
+                                          const Eigen::MatrixBase<Matrix> & distance_partial_dq);
+
+  ///
+  /// \brief Compute the joint Jacobians, the distances of all the active collision pairs and their partial
+  ///        derivatives with respect to the joint configuration.
+  ///
+  /// \tparam JointCollection Collection of Joint types.
+  /// \tparam ConfigVectorType Type of the joint configuration vector.
+  /// \tparam Matrix Type of the matrix containing the partial derivatives.
+  ///
+  /// \param[in] model robot model (const)
+  /// \param[out] data corresponding data (nonconst) where FK results and Jacobians are stored
+  /// \param[in] geomModel geometry model (const)
+  /// \param[out] geomData corresponding geometry data (nonconst) where distances are computed
+  /// \param[in] q robot configuration.
+  /// \param[out] distance_partial_dq partial derivatives of the distances (dim geomModel.collisionPairs.size() x model.nv).
+  ///
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType, typename Matrix>
+  inline void computeDistancesDerivatives(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                          DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                          const GeometryModel & geomModel,
+                                          GeometryData & geomData,
+                                          const Eigen::MatrixBase<ConfigVectorType> & q,
+                                          const Eigen::MatrixBase<Matrix> & distance_partial_dq);
+
   ///
   /// Compute the radius of the geometry volumes attached to every joints.
   /// \sa GeometryData::radius
@@ -183,6 +352,48 @@ namespace pinocchio
   inline void computeBodyRadius(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
                                 const GeometryModel & geomModel,
                                 GeometryData & geomData);
+
+  ///
+  /// \brief Check whether the straight joint-space motion q(s) = interpolate(q0,q1,s), s in [0,1],
+  ///        is collision free for every active pair of GeometryData.
+  ///
+  /// \details The segment is traversed by conservative advancement: at the current parameter s, the distance
+  ///          d of every active pair is computed and s is increased by the smallest d / rate, where rate is an
+  ///          upper bound on the relative displacement of the two objects per unit of s. The bound is built once
+  ///          for the whole segment from the joint velocity difference(q0,q1), the motion subspaces of the joints,
+  ///          the joint placements and the body radius (GeometryData::radius). Joints shared by the two bodies
+  ///          of a pair do not contribute to its rate. When the loop reaches s = 1, no collision can occur on
+  ///          the segment, whatever the resolution of a discretization would have been.
+  ///
+  /// \tparam JointCollection Collection of Joint types.
+  /// \tparam ConfigVectorIn1 Type of the initial joint configuration vector.
+  /// \tparam ConfigVectorIn2 Type of the final joint configuration vector.
+  ///
+  /// \param[in] model robot model (const)
+  /// \param[out] data corresponding data (nonconst) where FK results are stored
+  /// \param[in] geomModel geometry model (const)
+  /// \param[out] geomData corresponding geometry data (nonconst) where distances are computed
+  /// \param[in] q0 initial configuration of the segment (dim model.nq).
+  /// \param[in] q1 final configuration of the segment (dim model.nq).
+  /// \param[in] tolerance pairs closer than this distance are considered as colliding. It also bounds the number
+  ///            of iterations, which is at most the largest pair rate divided by tolerance.
+  ///
+  /// \return true if a collision may occur along the segment. In that case, geomData.collisionPairIndex
+  ///         is set to the index of the pair which could not be certified.
+  ///
+  /// \warning computeBodyRadius must have been called beforehand.
+  /// \note The bound assumes that the motion subspace column norms do not depend on the configuration, which holds
+  ///       for all the elementary joints but not for JointModelComposite: models with composite joints are rejected
+  ///       with a std::invalid_argument exception.
+  ///
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorIn1, typename ConfigVectorIn2>
+  inline bool computeContinuousCollisions(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                          DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                          const GeometryModel & geomModel,
+                                          GeometryData & geomData,
+                                          const Eigen::MatrixBase<ConfigVectorIn1> & q0,
+                                          const Eigen::MatrixBase<ConfigVectorIn2> & q1,
+                                          const Scalar tolerance = Scalar(1e-4));
 #endif // PINOCCHIO_WITH_HPP_FCL
 
   ///
@@ -6,6 +6,12 @@
 #define __pinocchio_algo_geometry_hxx__
 
 #include <boost/foreach.hpp>
+#include <limits>
+#include <stdexcept>
+
+#ifdef PINOCCHIO_WITH_OPENMP
+  #include <omp.h>
+#endif
 
 namespace pinocchio 
 {
@@ -44,6 +50,90 @@ namespace pinocchio
 #endif // PINOCCHIO_WITH_HPP_FCL
     }
   }
+
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+  inline void updateGeometryPlacements(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                       const DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                       const GeometryModel & geomModel,
+                                       GeometryData & geomData,
+                                       const int num_threads)
+  {
+    PINOCCHIO_UNUSED_VARIABLE(model);
+    assert(model.check(data) && "data is not consistent with model.");
+    assert(geomData.oMg.size() == geomModel.ngeoms && "geomData is not consistent with geomModel.");
+
+    const std::vector<GeomIndex> & movingObjects = geomData.movingObjects;
+    const long num_objects = (long)movingObjects.size();
+
+#ifdef PINOCCHIO_WITH_OPENMP
+    #pragma omp parallel for num_threads(num_threads) schedule(static)
+#else
+    PINOCCHIO_UNUSED_VARIABLE(num_threads);
+#endif
+    for(long k = 0; k < num_objects; ++k)
+    {
+      const GeomIndex i = movingObjects[(std::size_t)k];
+      const GeometryObject & geom = geomModel.geometryObjects[i];
+      geomData.oMg[i] = data.oMi[geom.parentJoint] * geom.placement;
+#ifdef PINOCCHIO_WITH_HPP_FCL
+      geomData.collisionObjects[i].setTransform( toFclTransform3f(geomData.oMg[i]) );
+#endif // PINOCCHIO_WITH_HPP_FCL
+    }
+  }
+
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType>
+  inline void updateGeometryPlacementsQuaternion(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                                 DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                                 const GeometryModel & geomModel,
+                                                 GeometryData & geomData,
+                                                 const Eigen::MatrixBase<ConfigVectorType> & q)
+  {
+    assert(model.check(data) && "data is not consistent with model.");
+
+    forwardKinematicsQuaternion(model, data, q);
+    updateGeometryPlacementsQuaternion(model, data, geomModel, geomData, 1);
+  }
+
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+  inline void updateGeometryPlacementsQuaternion(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                                 const DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                                 const GeometryModel & geomModel,
+                                                 GeometryData & geomData,
+                                                 const int num_threads)
+  {
+    PINOCCHIO_UNUSED_VARIABLE(model);
+    assert(model.check(data) && "data is not consistent with model.");
+
+    // The placements are only allocated by the first call, which also places the objects attached to the universe.
+    if(geomData.oMg_quat.size() != geomModel.ngeoms)
+    {
+      geomData.oMg_quat.resize(geomModel.ngeoms);
+      for(GeomIndex i = 0; i < geomModel.ngeoms; ++i)
+      {
+        if(geomModel.geometryObjects[i].parentJoint == 0)
+          geomData.oMg_quat[i] = GeometryData::SE3Quaternion(geomModel.geometryObjects[i].placement);
+      }
+    }
+
+    const std::vector<GeomIndex> & movingObjects = geomData.movingObjects;
+    const long num_objects = (long)movingObjects.size();
+
+#ifdef PINOCCHIO_WITH_OPENMP
+    #pragma omp parallel for num_threads(num_threads) schedule(static)
+#else
+    PINOCCHIO_UNUSED_VARIABLE(num_threads);
+#endif
+    for(long k = 0; k < num_objects; ++k)
+    {
+      const GeomIndex i = movingObjects[(std::size_t)k];
+      const GeometryObject & geom = geomModel.geometryObjects[i];
+      details::composeQuaternion(data.oMi_quat[geom.parentJoint],geom.placement,geomData.oMg_quat[i]);
+#ifdef PINOCCHIO_WITH_HPP_FCL
+      geomData.collisionObjects[i].setTransform( toFclTransform3f(geomData.oMg_quat[i]) );
+#endif // PINOCCHIO_WITH_HPP_FCL
+    }
+  }
+
 #ifdef PINOCCHIO_WITH_HPP_FCL  
 
   /* --- COLLISIONS ----------------------------------------------------------------- */
@@ -128,8 +218,30 @@ namespace pinocchio
                     geomData.distanceRequest,
                     geomData.distanceResults[pairId]);
 
+    geomData.distancePlacements[2*pairId] = geomData.oMg[pair.first];
+    geomData.distancePlacements[2*pairId+1] = geomData.oMg[pair.second];
+    geomData.distanceLowerBounds[pairId] = geomData.distanceResults[pairId].min_distance;
+
     return geomData.distanceResults[pairId];
   }
+
+  namespace details
+  {
+    /// Upper bound on the displacement of any point of the geometry object between placements M0 and M1.
+    /// The norm of R1 - R0 is the chord length 2 sin(theta/2) of the relative rotation, i.e. sqrt(3 - trace(R0^T R1)).
+    inline double geometryDisplacement(const GeometryObject & geom,
+                                       const GeometryData::SE3 & M0,
+                                       const GeometryData::SE3 & M1)
+    {
+      const fcl::AABB & aabb = geom.fcl->aabb_local;
+      double radius = 0.;
+      for(int k = 0; k < 3; ++k)
+        radius += std::max(aabb.min_[k]*aabb.min_[k],aabb.max_[k]*aabb.max_[k]);
+
+      const double chord = std::sqrt(std::max(0., 3. - M0.rotation().cwiseProduct(M1.rotation()).sum()));
+      return (M1.translation() - M0.translation()).norm() + chord * std::sqrt(radius);
+    }
+  } // namespace details
   
 
   template <bool COMPUTE_SHORTEST>
@@ -174,6 +286,70 @@ namespace pinocchio
     return min_index;
   }
   
+  inline std::size_t computeDistances(const GeometryModel & geomModel,
+                                      GeometryData & geomData,
+                                      const double threshold)
+  {
+    std::size_t min_index = geomModel.collisionPairs.size();
+    double min_dist = std::numeric_limits<double>::infinity();
+    
+    // First, the pairs which may be closer than threshold are evaluated.
+    for (std::size_t cpt = 0; cpt < geomModel.collisionPairs.size(); ++cpt)
+    {
+      if(!geomData.activeCollisionPairs[cpt]) continue;
+
+      const CollisionPair & pair = geomModel.collisionPairs[cpt];
+      double & lower_bound = geomData.distanceLowerBounds[cpt];
+      if(lower_bound > threshold)
+      {
+        // Lower bound from the last computed distance and the motion of both objects since then.
+        lower_bound = geomData.distanceResults[cpt].min_distance
+                    - details::geometryDisplacement(geomModel.geometryObjects[pair.first],
+                                                    geomData.distancePlacements[2*cpt],
+                                                    geomData.oMg[pair.first])
+                    - details::geometryDisplacement(geomModel.geometryObjects[pair.second],
+                                                    geomData.distancePlacements[2*cpt+1],
+                                                    geomData.oMg[pair.second]);
+      }
+      if(lower_bound > threshold) continue;
+      
+      const double dist = computeDistance(geomModel,geomData,cpt).min_distance;
+      if(dist < min_dist)
+      {
+        min_index = cpt;
+        min_dist = dist;
+      }
+    }
+    
+    // Then, the other pairs are only evaluated if they may be closer than the closest pair found so far.
+    for (std::size_t cpt = 0; cpt < geomModel.collisionPairs.size(); ++cpt)
+    {
+      if(!geomData.activeCollisionPairs[cpt]) continue;
+      if(geomData.distanceLowerBounds[cpt] <= threshold || geomData.distanceLowerBounds[cpt] >= min_dist) continue;
+      
+      const double dist = computeDistance(geomModel,geomData,cpt).min_distance;
+      if(dist < min_dist)
+      {
+        min_index = cpt;
+        min_dist = dist;
+      }
+    }
+    return min_index;
+  }
+
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType>
+  inline std::size_t computeDistances(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                      DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                      const GeometryModel & geomModel,
+                                      GeometryData & geomData,
+                                      const Eigen::MatrixBase<ConfigVectorType> & q,
+                                      const double threshold)
+  {
+    assert(model.check(data) && "data is not consistent with model.");
+    updateGeometryPlacements(model, data, geomModel, geomData, q);
+    return computeDistances(geomModel,geomData,threshold);
+  }
+
   // Required to have a default template argument on templated free function
   PINOCCHIO_DEPRECATED
   inline std::size_t computeDistances(const Model & model,
@@ -223,6 +399,114 @@ namespace pinocchio
     return computeDistances<ComputeShortest>(geomModel,geomData);
   }
 
+  /* --- DISTANCE DERIVATIVES ------------------------------------------------------ */
+  /* --- DISTANCE DERIVATIVES ------------------------------------------------------ */
+  /* --- DISTANCE DERIVATIVES ------------------------------------------------------ */
+
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename Matrix>
+  inline void computeDistancesDerivatives(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                          const DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                          const GeometryModel & geomModel,
+                                          const GeometryData & geomData,
+                                          const Eigen::MatrixBase<Matrix> & distance_partial_dq)
+  {
+    assert(model.check(data) && "data is not consistent with model.");
+    assert(distance_partial_dq.rows() == (Eigen::DenseIndex)geomModel.collisionPairs.size());
+    assert(distance_partial_dq.cols() == model.nv);
+
+    typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
+    typedef typename Model::JointIndex JointIndex;
+    typedef Eigen::Matrix<Scalar,3,1,Options> Vector3;
+    typedef Eigen::Matrix<Scalar,6,1,Options> Vector6;
+
+    Matrix & dd_dq = EIGEN_CONST_CAST(Matrix,distance_partial_dq);
+    dd_dq.setZero();
+
+    for(std::size_t cp = 0; cp < geomModel.collisionPairs.size(); ++cp)
+    {
+      if(!geomData.activeCollisionPairs[cp]) continue;
+
+      const CollisionPair & pair = geomModel.collisionPairs[cp];
+      const GeometryObject & geom1 = geomModel.geometryObjects[pair.first];
+      const GeometryObject & geom2 = geomModel.geometryObjects[pair.second];
+      const GeometryData::SE3 & oMg1 = geomData.oMg[pair.first];
+      const GeometryData::SE3 & oMg2 = geomData.oMg[pair.second];
+      
+      // Depending on the version of hpp-fcl and on the types of the shapes, fcl returns the nearest points either
+      // in the world frame or in the frames of the objects. When the first object of a query is placed at the
+      // origin, both conventions agree on its nearest point. The nearest point of the first object is given by a
+      // query in its frame. The nearest points may not be unique (e.g. two parallel faces), so the one of the
+      // second object is the point of this object nearest to p1, given by a second query against p1 seen as a
+      // sphere of radius zero.
+      const GeometryData::SE3 g1Mg2(oMg1.actInv(oMg2));
+      fcl::DistanceResult res1;
+      fcl::distance(geom1.fcl.get(),fcl::Transform3f(),
+                    geom2.fcl.get(),toFclTransform3f(g1Mg2),
+                    geomData.distanceRequest,res1);
+      // The gradient is not defined for colliding objects.
+      if(res1.min_distance <= 0.) continue;
+
+      const GeometryData::SE3::Vector3 g1p1(res1.nearest_points[0][0],res1.nearest_points[0][1],res1.nearest_points[0][2]);
+      const GeometryData::SE3::Vector3 g2p1(g1Mg2.actInv(g1p1));
+      const fcl::Sphere witness(0.);
+      fcl::DistanceResult res2;
+      fcl::distance(geom2.fcl.get(),fcl::Transform3f(),
+                    &witness,toFclTransform3f(GeometryData::SE3(GeometryData::SE3::Matrix3::Identity(),g2p1)),
+                    geomData.distanceRequest,res2);
+
+      const GeometryData::SE3::Vector3 g2p2(res2.nearest_points[0][0],res2.nearest_points[0][1],res2.nearest_points[0][2]);
+      const Vector3 p1 = oMg1.act(g1p1).template cast<Scalar>();
+      const Vector3 p2 = oMg2.act(g2p2).template cast<Scalar>();
+      const Vector3 diff = p2 - p1;
+      const Scalar dist = diff.norm();
+      if(dist <= Eigen::NumTraits<Scalar>::dummy_precision()) continue;
+
+      // d = n^T (p2 - p1): the row is the wrench of the force n applied at p2 minus the one applied at p1,
+      // expressed at the world origin and projected on the world Jacobians.
+      const Vector3 n = diff / dist;
+      Vector6 w1, w2;
+      w1 << n, p1.cross(n);
+      w2 << n, p2.cross(n);
+
+      // The joints supporting both objects do not change the distance: only the two branches up to
+      // their common ancestor are visited.
+      JointIndex j1 = geomModel.geometryObjects[pair.first].parentJoint;
+      JointIndex j2 = geomModel.geometryObjects[pair.second].parentJoint;
+      while(j1 != j2)
+      {
+        if(j1 > j2)
+        {
+          const int idx_v = model.joints[j1].idx_v(), nv = model.joints[j1].nv();
+          dd_dq.row((Eigen::DenseIndex)cp).segment(idx_v,nv).noalias()
+          -= w1.transpose() * data.J.middleCols(idx_v,nv);
+          j1 = model.parents[j1];
+        }
+        else
+        {
+          const int idx_v = model.joints[j2].idx_v(), nv = model.joints[j2].nv();
+          dd_dq.row((Eigen::DenseIndex)cp).segment(idx_v,nv).noalias()
+          += w2.transpose() * data.J.middleCols(idx_v,nv);
+          j2 = model.parents[j2];
+        }
+      }
+    }
+  }
+
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType, typename Matrix>
+  inline void computeDistancesDerivatives(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                          DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                          const GeometryModel & geomModel,
+                                          GeometryData & geomData,
+                                          const Eigen::MatrixBase<ConfigVectorType> & q,
+                                          const Eigen::MatrixBase<Matrix> & distance_partial_dq)
+  {
+    assert(model.check(data) && "data is not consistent with model.");
+    computeJointJacobians(model,data,q);
+    computeDistances(model,data,geomModel,geomData);
+    computeDistancesDerivatives(model,data,geomModel,geomData,
+                                EIGEN_CONST_CAST(Matrix,distance_partial_dq));
+  }
+
   /* --- RADIUS -------------------------------------------------------------------- */
   /* --- RADIUS -------------------------------------------------------------------- */
   /* --- RADIUS -------------------------------------------------------------------- */
@@ -271,6 +555,139 @@ namespace pinocchio
   }
 
 #undef SE3_GEOM_AABB
+
+  /* --- CONTINUOUS COLLISIONS ------------------------------------------------------ */
+  /* --- CONTINUOUS COLLISIONS ------------------------------------------------------ */
+  /* --- CONTINUOUS COLLISIONS ------------------------------------------------------ */
+
+  namespace details
+  {
+    /// Upper bound on the relative displacement rate of the bodies supported by joints a and b.
+    /// Only the joints which are not common ancestors of a and b are visited, as the common ones move both bodies
+    /// rigidly. Joint indexes being sorted from the root, the deepest of the two current joints is never common.
+    template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+    inline Scalar continuousCollisionRate(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                          const std::vector<Scalar> & lin,
+                                          const std::vector<Scalar> & ang,
+                                          const std::vector<Scalar> & length,
+                                          const GeometryData & geomData,
+                                          JointIndex a, JointIndex b)
+    {
+      const Scalar ra = (Scalar)geomData.radius[a], rb = (Scalar)geomData.radius[b];
+      Scalar La = Scalar(0), Lb = Scalar(0), rate = Scalar(0);
+      while(a != b)
+      {
+        if(a > b)
+        {
+          rate += lin[a] + ang[a] * (La + ra);
+          La += length[a];
+          a = model.parents[a];
+        }
+        else
+        {
+          rate += lin[b] + ang[b] * (Lb + rb);
+          Lb += length[b];
+          b = model.parents[b];
+        }
+      }
+      return rate;
+    }
+  } // namespace details
+
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorIn1, typename ConfigVectorIn2>
+  inline bool computeContinuousCollisions(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                          DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                          const GeometryModel & geomModel,
+                                          GeometryData & geomData,
+                                          const Eigen::MatrixBase<ConfigVectorIn1> & q0,
+                                          const Eigen::MatrixBase<ConfigVectorIn2> & q1,
+                                          const Scalar tolerance)
+  {
+    assert(model.check(data) && "data is not consistent with model.");
+    assert(q0.size() == model.nq && "The configuration vector q0 is not of right size");
+    assert(q1.size() == model.nq && "The configuration vector q1 is not of right size");
+    assert(geomData.radius.size() == (std::size_t)model.njoints && "computeBodyRadius must be called first.");
+    assert(tolerance > Scalar(0) && "tolerance must be positive.");
+
+    typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
+    typedef typename Model::JointIndex JointIndex;
+    typedef typename Model::ConfigVectorType ConfigVectorType;
+    typedef typename Model::TangentVectorType TangentVectorType;
+    typedef Eigen::Matrix<Scalar,6,Eigen::Dynamic,Options> Matrix6x;
+
+    const TangentVectorType v = difference(model,q0,q1);
+    forwardKinematics(model,data,q0);
+
+    // lin[i] and ang[i] bound the linear and angular velocities of joint i per unit of s, expressed in its local frame.
+    // They rely on the norms of the columns of the motion subspace being independent of the configuration,
+    // which holds for the elementary joints only.
+    // length[i] bounds, over the whole segment, the distance between the origins of joint i and of its parent:
+    // the origin of joint i moves by at most lin[i] with respect to its placement at q0 (e.g. the travel of a prismatic joint).
+    std::vector<Scalar> lin((std::size_t)model.njoints,Scalar(0));
+    std::vector<Scalar> ang((std::size_t)model.njoints,Scalar(0));
+    std::vector<Scalar> length((std::size_t)model.njoints,Scalar(0));
+    for(JointIndex i=1; i < (JointIndex)model.njoints; ++i)
+    {
+      if(model.joints[i].shortname() == JointModelCompositeTpl<Scalar,Options,JointCollectionTpl>::classname())
+        throw std::invalid_argument("computeContinuousCollisions does not handle composite joints: "
+                                    "the motion subspace of " + model.names[i] + " depends on the configuration.");
+      
+      const Matrix6x S = data.joints[i].S().matrix();
+      const int idx_v = model.joints[i].idx_v();
+      for(int k = 0; k < model.joints[i].nv(); ++k)
+      {
+        const Scalar vk = std::fabs(v[idx_v+k]);
+        lin[i] += vk * S.col(k).template head<3>().norm();
+        ang[i] += vk * S.col(k).template tail<3>().norm();
+      }
+      
+      const Scalar max_offset = data.joints[i].M().translation().norm() + lin[i];
+      length[i] = model.jointPlacements[i].translation().norm() + max_offset;
+    }
+
+    std::vector<Scalar> rates(geomModel.collisionPairs.size(),Scalar(0));
+    for(std::size_t cp = 0; cp < geomModel.collisionPairs.size(); ++cp)
+    {
+      if(!geomData.activeCollisionPairs[cp]) continue;
+      const CollisionPair & pair = geomModel.collisionPairs[cp];
+      rates[cp] = details::continuousCollisionRate(model,lin,ang,length,geomData,
+                                                   geomModel.geometryObjects[pair.first].parentJoint,
+                                                   geomModel.geometryObjects[pair.second].parentJoint);
+    }
+
+    ConfigVectorType q(model.nq);
+    Scalar s = Scalar(0);
+    while(true)
+    {
+      if(s > Scalar(0))
+      {
+        q = interpolate(model,q0,q1,s);
+        forwardKinematics(model,data,q);
+      }
+      updateGeometryPlacements(model,data,geomModel,geomData);
+
+      Scalar step = std::numeric_limits<Scalar>::infinity();
+      for(std::size_t cp = 0; cp < geomModel.collisionPairs.size(); ++cp)
+      {
+        if(!geomData.activeCollisionPairs[cp]) continue;
+        // Pairs without relative motion only need to be checked once.
+        if(s > Scalar(0) && rates[cp] <= Scalar(0)) continue;
+
+        const Scalar dist = (Scalar)computeDistance(geomModel,geomData,cp).min_distance;
+        if(dist <= tolerance)
+        {
+          geomData.collisionPairIndex = cp;
+          return true;
+        }
+        if(rates[cp] > Scalar(0))
+          step = std::min(step, dist / rates[cp]);
+      }
+
+      // No pair can get in contact before s + step.
+      s += step;
+      if(s >= Scalar(1)) return false;
+    }
+  }
 #endif // PINOCCHIO_WITH_HPP_FCL
 
   /* --- APPEND GEOMETRY MODEL ----------------------------------------------------------- */
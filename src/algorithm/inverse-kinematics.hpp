@@ -0,0 +1,197 @@
+//
+// Copyright (c) 2018 CNRS
+//
+
+#ifndef __pinocchio_inverse_kinematics_hpp__
+#define __pinocchio_inverse_kinematics_hpp__
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/multibody/data.hpp"
+#include "pinocchio/container/aligned-vector.hpp"
+
+#include <Eigen/Cholesky>
+
+namespace pinocchio
+{
+  template<typename Scalar, int Options = 0, template<typename,int> class JointCollectionTpl = JointCollectionDefaultTpl>
+  struct InverseKinematicsTpl;
+
+  typedef InverseKinematicsTpl<double> InverseKinematics;
+
+  ///
+  /// \brief Damped least-squares inverse kinematics solver for a set of weighted frame placement tasks.
+  ///
+  /// \details At each iteration, the joint Jacobians are computed together with the forward kinematics by
+  ///          computeJointJacobians, then the error of each task is the log6 of the placement of the frame relative
+  ///          to its target, weighted component-wise. The step v is the solution of
+  ///          \f$ (J^T J + \lambda I) v = - J^T e \f$, computed with a Cholesky factorization whose storage is reused,
+  ///          and the configuration is updated with integrate and clamped to the model position limits.
+  ///          All the workspace is allocated when the tasks are added, so that solve does not allocate.
+  ///
+  /// \tparam JointCollection Collection of Joint types.
+  ///
+  template<typename _Scalar, int _Options, template<typename,int> class JointCollectionTpl>
+  struct InverseKinematicsTpl
+  {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef _Scalar Scalar;
+    enum { Options = _Options };
+
+    typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
+    typedef DataTpl<Scalar,Options,JointCollectionTpl> Data;
+    typedef typename Model::FrameIndex FrameIndex;
+    typedef typename Model::SE3 SE3;
+    typedef typename Model::ConfigVectorType ConfigVectorType;
+    typedef typename Model::TangentVectorType TangentVectorType;
+
+    typedef Eigen::Matrix<Scalar,Eigen::Dynamic,1,Options> VectorXs;
+    typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic,Options> MatrixXs;
+    typedef Eigen::Matrix<Scalar,6,Eigen::Dynamic,Options> Matrix6x;
+    typedef Eigen::Matrix<Scalar,6,6,Options> Matrix6;
+    typedef Eigen::Matrix<Scalar,6,1,Options> Vector6;
+
+    ///
+    /// \brief Task driving the placement of a frame to a target placement.
+    ///
+    struct FrameTask
+    {
+      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+      /// \brief Index of the frame in model.frames.
+      FrameIndex frame_id;
+
+      /// \brief Desired placement of the frame, relative to the world.
+      SE3 target;
+
+      /// \brief Weights of the linear (first three) and angular (last three) components of the error,
+      ///        expressed in the frame.
+      Vector6 weights;
+    };
+
+    typedef container::aligned_vector<FrameTask> FrameTaskVector;
+
+    /// \brief The frame tasks.
+    FrameTaskVector tasks;
+
+    /// \brief Maximal number of iterations of solve.
+    int maxIterations;
+
+    /// \brief solve stops when the norm of the weighted error is below this value.
+    Scalar tolerance;
+
+    /// \brief Damping added to the diagonal of the normal equations.
+    Scalar damping;
+
+    /// \brief Ratio of the damped least-squares step which is applied at each iteration.
+    Scalar stepSize;
+
+    /// \brief If true, the configuration is clamped to [model.lowerPositionLimit, model.upperPositionLimit]
+    ///        after each iteration, for the joints whose configuration is a vector of independent coordinates
+    ///        (nq == nv). The limits are read from the model at construction.
+    bool enforceJointLimits;
+
+    /// \brief Number of iterations performed by the last call to solve.
+    int iterations;
+
+    /// \brief Norm of the weighted error at the end of the last call to solve.
+    Scalar errorNorm;
+
+    ///
+    /// \brief Constructor.
+    ///
+    /// \param[in] model The model structure of the rigid body system. It must outlive the solver.
+    ///
+    explicit InverseKinematicsTpl(const Model & model);
+
+    ///
+    /// \brief Add a frame placement task with the same weight on every component of the error.
+    ///
+    /// \param[in] frame_id Index of the frame.
+    /// \param[in] target Desired placement of the frame.
+    /// \param[in] weight Weight of the task.
+    ///
+    /// \return The index of the task in tasks.
+    ///
+    std::size_t addFrameTask(const FrameIndex frame_id,
+                             const SE3 & target,
+                             const Scalar weight = Scalar(1));
+
+    ///
+    /// \brief Add a frame placement task.
+    ///
+    /// \param[in] frame_id Index of the frame.
+    /// \param[in] target Desired placement of the frame.
+    /// \param[in] weights Weights of the linear and angular components of the error. A null weight removes the
+    ///            corresponding component from the task (e.g. position only tasks).
+    ///
+    /// \return The index of the task in tasks.
+    ///
+    std::size_t addFrameTask(const FrameIndex frame_id,
+                             const SE3 & target,
+                             const Vector6 & weights);
+
+    ///
+    /// \brief Solve the inverse kinematics problem from the initial configuration q.
+    ///
+    /// \param[in] data The data structure of the rigid body system, used to compute the kinematics.
+    /// \param[in,out] q The initial guess (dim model.nq), replaced by the solution.
+    ///
+    /// \return true if the error norm is below tolerance.
+    ///
+    template<typename ConfigVectorLike>
+    bool solve(Data & data,
+               const Eigen::MatrixBase<ConfigVectorLike> & q);
+
+    ///
+    /// \brief Solve a batch of inverse kinematics problems sharing the same tasks but with different targets.
+    ///
+    /// \param[in] targets The targets of the queries (dim tasks.size() * Q.cols()): the targets of query j are
+    ///            stored at indexes j*tasks.size() to (j+1)*tasks.size()-1, in the order of tasks.
+    /// \param[in,out] Q The initial guesses stored column-wise (dim model.nq x N), replaced by the solutions.
+    /// \param[in] num_threads Number of threads among which the queries are split.
+    ///            It is only effective when Pinocchio is built with OpenMP support.
+    ///
+    /// \return The number of queries which have converged.
+    ///
+    /// \remarks Each thread works with its own copy of the solver and of the data.
+    ///
+    template<typename ConfigMatrixLike>
+    int solveBatch(const container::aligned_vector<SE3> & targets,
+                   const Eigen::MatrixBase<ConfigMatrixLike> & Q,
+                   const int num_threads = 1) const;
+
+    /// \brief The model the solver has been built for.
+    const Model & model() const { return *model_ptr; }
+
+  protected:
+
+    const Model * model_ptr;
+
+    /// \brief Stacked weighted task Jacobians (dim 6*tasks.size() x model.nv).
+    MatrixXs J;
+
+    /// \brief Stacked weighted task errors (dim 6*tasks.size()).
+    VectorXs err;
+
+    /// \brief Damped normal matrix and its factorization.
+    MatrixXs H;
+    Eigen::LLT<MatrixXs> llt;
+
+    /// \brief Jacobian of the log and weighted Jacobian, for a single task.
+    Matrix6 Jlog;
+    Matrix6x Jtask;
+
+    TangentVectorType v;
+    ConfigVectorType q_current, q_next;
+
+    /// \brief Position limits of the joints with nq == nv, infinite for the other ones.
+    ConfigVectorType lowerLimit, upperLimit;
+  };
+
+} // namespace pinocchio
+
+/* --- Details -------------------------------------------------------------------- */
+#include "pinocchio/algorithm/inverse-kinematics.hxx"
+
+#endif // ifndef __pinocchio_inverse_kinematics_hpp__
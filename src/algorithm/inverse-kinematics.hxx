@@ -0,0 +1,203 @@
+//
+// Copyright (c) 2018 CNRS
+//
+
+#ifndef __pinocchio_inverse_kinematics_hxx__
+#define __pinocchio_inverse_kinematics_hxx__
+
+#include "pinocchio/spatial/explog.hpp"
+#include "pinocchio/algorithm/jacobian.hpp"
+#include "pinocchio/algorithm/frames.hpp"
+#include "pinocchio/multibody/liegroup/liegroup.hpp"
+#include "pinocchio/multibody/liegroup/liegroup-algo.hpp"
+
+#include <limits>
+
+#ifdef PINOCCHIO_WITH_OPENMP
+  #include <omp.h>
+#endif
+
+/// @cond DEV
+
+namespace pinocchio
+{
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+  InverseKinematicsTpl<Scalar,Options,JointCollectionTpl>::InverseKinematicsTpl(const Model & model)
+  : tasks()
+  , maxIterations(1000)
+  , tolerance(Scalar(1e-6))
+  , damping(Scalar(1e-6))
+  , stepSize(Scalar(1))
+  , enforceJointLimits(true)
+  , iterations(0)
+  , errorNorm(Scalar(0))
+  , model_ptr(&model)
+  , J(0,model.nv)
+  , err(0)
+  , H(model.nv,model.nv)
+  , llt(model.nv)
+  , Jtask(6,model.nv)
+  , v(model.nv)
+  , q_current(model.nq)
+  , q_next(model.nq)
+  , lowerLimit(ConfigVectorType::Constant(model.nq,-std::numeric_limits<Scalar>::infinity()))
+  , upperLimit(ConfigVectorType::Constant(model.nq, std::numeric_limits<Scalar>::infinity()))
+  {
+    // Clamping the coordinates of a unit quaternion or of a unit complex would leave the Lie group.
+    for(int i = 1; i < model.njoints; ++i)
+    {
+      const typename Model::JointModel & jmodel = model.joints[(std::size_t)i];
+      if(jmodel.nq() != jmodel.nv()) continue;
+      lowerLimit.segment(jmodel.idx_q(),jmodel.nq()) = model.lowerPositionLimit.segment(jmodel.idx_q(),jmodel.nq());
+      upperLimit.segment(jmodel.idx_q(),jmodel.nq()) = model.upperPositionLimit.segment(jmodel.idx_q(),jmodel.nq());
+    }
+  }
+
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+  std::size_t
+  InverseKinematicsTpl<Scalar,Options,JointCollectionTpl>::addFrameTask(const FrameIndex frame_id,
+                                                                        const SE3 & target,
+                                                                        const Scalar weight)
+  {
+    return addFrameTask(frame_id,target,Vector6::Constant(weight));
+  }
+
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+  std::size_t
+  InverseKinematicsTpl<Scalar,Options,JointCollectionTpl>::addFrameTask(const FrameIndex frame_id,
+                                                                        const SE3 & target,
+                                                                        const Vector6 & weights)
+  {
+    assert(frame_id < model().frames.size() && "The frame index is out of range.");
+
+    FrameTask task;
+    task.frame_id = frame_id;
+    task.target = target;
+    task.weights = weights;
+    tasks.push_back(task);
+
+    // The columns which do not support the frame are never written by getFrameJacobian: they stay at zero.
+    const Eigen::DenseIndex nrows = (Eigen::DenseIndex)(6*tasks.size());
+    J.conservativeResize(nrows,model().nv);
+    J.bottomRows(6).setZero();
+    err.resize(nrows);
+
+    return tasks.size()-1;
+  }
+
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+  template<typename ConfigVectorLike>
+  bool
+  InverseKinematicsTpl<Scalar,Options,JointCollectionTpl>::solve(Data & data,
+                                                                 const Eigen::MatrixBase<ConfigVectorLike> & q)
+  {
+    const Model & model = *model_ptr;
+    assert(model.check(data) && "data is not consistent with model.");
+    assert(q.size() == model.nq && "The configuration vector is not of right size");
+
+    typedef typename Model::JointIndex JointIndex;
+    typedef IntegrateStep<LieGroupMap,ConfigVectorType,TangentVectorType,ConfigVectorType> IntegrateAlgo;
+
+    q_current = q;
+    bool success = false;
+    for(iterations = 0; ; ++iterations)
+    {
+      // Forward kinematics and joint Jacobians in a single pass.
+      computeJointJacobians(model,data,q_current);
+
+      for(std::size_t k = 0; k < tasks.size(); ++k)
+      {
+        const FrameTask & task = tasks[k];
+        const Eigen::DenseIndex row = (Eigen::DenseIndex)(6*k);
+
+        const SE3 & oMf = updateFramePlacement(model,data,task.frame_id);
+        const SE3 dM(task.target.actInv(oMf));
+        err.template segment<6>(row) = task.weights.cwiseProduct(log6(dM).toVector());
+
+        // The rows of the task only hold non zero values on the columns supporting the frame.
+        typename MatrixXs::RowsBlockXpr Jrows = J.middleRows(row,6);
+        getFrameJacobian(model,data,task.frame_id,LOCAL,Jrows);
+        Jlog6(dM,Jlog);
+        Jtask.noalias() = Jlog * Jrows;
+        Jrows = task.weights.asDiagonal() * Jtask;
+      }
+
+      errorNorm = err.norm();
+      if(errorNorm < tolerance) { success = true; break; }
+      if(iterations >= maxIterations) break;
+
+      // Damped least-squares step: (J^T J + damping I) v = - J^T err.
+      H.noalias() = J.transpose() * J;
+      H.diagonal().array() += damping;
+      llt.compute(H);
+      v.noalias() = J.transpose() * err;
+      v *= -stepSize;
+      llt.solveInPlace(v);
+
+      typename IntegrateAlgo::ArgsType args(q_current,v,q_next);
+      for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
+        IntegrateAlgo::run(model.joints[i], args);
+
+      if(enforceJointLimits)
+        q_current = q_next.cwiseMax(lowerLimit).cwiseMin(upperLimit);
+      else
+        q_current.swap(q_next);
+    }
+
+    EIGEN_CONST_CAST(ConfigVectorLike,q) = q_current;
+    return success;
+  }
+
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+  template<typename ConfigMatrixLike>
+  int
+  InverseKinematicsTpl<Scalar,Options,JointCollectionTpl>::solveBatch(const container::aligned_vector<SE3> & targets,
+                                                                      const Eigen::MatrixBase<ConfigMatrixLike> & Q,
+                                                                      const int num_threads) const
+  {
+    const Model & model = *model_ptr;
+    assert(Q.rows() == model.nq && "The configurations are not of right size");
+    assert(targets.size() == tasks.size() * (std::size_t)Q.cols() && "The number of targets is not consistent with Q.");
+
+    ConfigMatrixLike & Q_ = EIGEN_CONST_CAST(ConfigMatrixLike,Q);
+    const long num_queries = (long)Q.cols();
+    const std::size_t num_tasks = tasks.size();
+
+#ifdef PINOCCHIO_WITH_OPENMP
+    const int num_workers = std::max(1,num_threads);
+#else
+    PINOCCHIO_UNUSED_VARIABLE(num_threads);
+    const int num_workers = 1;
+#endif
+
+    container::aligned_vector<InverseKinematicsTpl> solvers((std::size_t)num_workers,*this);
+    container::aligned_vector<Data> datas((std::size_t)num_workers,Data(model));
+
+    int num_success = 0;
+#ifdef PINOCCHIO_WITH_OPENMP
+    #pragma omp parallel for num_threads(num_workers) schedule(dynamic) reduction(+:num_success)
+#endif
+    for(long j = 0; j < num_queries; ++j)
+    {
+#ifdef PINOCCHIO_WITH_OPENMP
+      const std::size_t worker = (std::size_t)omp_get_thread_num();
+#else
+      const std::size_t worker = 0;
+#endif
+      InverseKinematicsTpl & solver = solvers[worker];
+      for(std::size_t k = 0; k < num_tasks; ++k)
+        solver.tasks[k].target = targets[(std::size_t)j*num_tasks + k];
+
+      typename ConfigMatrixLike::ColXpr q = Q_.col(j);
+      if(solver.solve(datas[worker],q))
+        ++num_success;
+    }
+
+    return num_success;
+  }
+
+} // namespace pinocchio
+
+/// @endcond
+
+#endif // ifndef __pinocchio_inverse_kinematics_hxx__
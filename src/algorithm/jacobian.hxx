@@ -7,6 +7,11 @@
 
 #include "pinocchio/multibody/visitor.hpp"
 #include "pinocchio/algorithm/check.hpp"
+#include "pinocchio/spatial/act-on-set.hpp"
+
+#ifdef PINOCCHIO_WITH_PROFILER
+  #include "pinocchio/utils/profiler.hpp"
+#endif
 
 /// @cond DEV
 
@@ -55,6 +60,7 @@ namespace pinocchio
   {
     assert(model.check(data) && "data is not consistent with model.");
     assert(q.size() == model.nq && "The configuration vector is not of right size");
+    PINOCCHIO_PROFILER_SCOPE("computeJointJacobians");
     
     typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
     typedef typename Model::JointIndex JointIndex;
@@ -97,6 +103,7 @@ namespace pinocchio
                         DataTpl<Scalar,Options,JointCollectionTpl> & data)
   {
     assert(model.check(data) && "data is not consistent with model.");
+    PINOCCHIO_PROFILER_SCOPE("computeJointJacobians");
     
     typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
     typedef typename Model::JointIndex JointIndex;
@@ -126,20 +133,19 @@ namespace pinocchio
     assert(model.check(data) && "data is not consistent with model.");
     
     typedef DataTpl<Scalar,Options,JointCollectionTpl> Data;
-    typedef typename Data::Matrix6x::ConstColXpr M6xColXpr;
+    typedef typename Data::ColumnSpanVector ColumnSpanVector;
     
     Matrix6Like & J_ = EIGEN_CONST_CAST(Matrix6Like,J);
     
     const typename Data::SE3 & oMjoint = data.oMi[jointId];
-    int colRef = nv(model.joints[jointId])+idx_v(model.joints[jointId])-1;
-    for(int j=colRef;j>=0;j=data.parents_fromRow[(Model::Index)j])
+    const ColumnSpanVector & spans = data.supportSpans[jointId];
+    for(typename ColumnSpanVector::const_iterator span = spans.begin(); span != spans.end(); ++span)
     {
-      if(rf == WORLD)   J_.col(j) = data.J.col(j);
+      if(rf == WORLD)
+        J_.middleCols(span->first,span->second) = data.J.middleCols(span->first,span->second);
       else
-      {
-        const MotionRef<M6xColXpr> mref(data.J.col(j).derived());
-        J_.col(j) = oMjoint.actInv(mref).toVector();
-      }
+        motionSet::se3ActionInverse(oMjoint,data.J.middleCols(span->first,span->second),
+                                    J_.middleCols(span->first,span->second));
     }
   }
   
@@ -296,15 +302,19 @@ namespace pinocchio
     assert(model.check(data) && "data is not consistent with model.");
     
     typedef DataTpl<Scalar,Options,JointCollectionTpl> Data;
+    typedef typename Data::ColumnSpanVector ColumnSpanVector;
     
     Matrix6Like & dJ_ = EIGEN_CONST_CAST(Matrix6Like,dJ);
     
     const typename Data::SE3 & oMjoint = data.oMi[jointId];
-    int colRef = nv(model.joints[jointId])+idx_v(model.joints[jointId])-1;
-    for(int j=colRef;j>=0;j=data.parents_fromRow[(size_t)j])
+    const ColumnSpanVector & spans = data.supportSpans[jointId];
+    for(typename ColumnSpanVector::const_iterator span = spans.begin(); span != spans.end(); ++span)
     {
-      if(rf == WORLD)   dJ_.col(j) = data.dJ.col(j);
-      else              dJ_.col(j) = oMjoint.actInv(Motion(data.dJ.col(j))).toVector(); // TODO: use MotionRef
+      if(rf == WORLD)
+        dJ_.middleCols(span->first,span->second) = data.dJ.middleCols(span->first,span->second);
+      else
+        motionSet::se3ActionInverse(oMjoint,data.dJ.middleCols(span->first,span->second),
+                                    dJ_.middleCols(span->first,span->second));
     }
   }
   
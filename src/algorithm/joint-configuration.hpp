@@ -74,6 +74,26 @@ namespace pinocchio
              const Eigen::MatrixBase<ConfigVectorIn1> & q0,
              const Eigen::MatrixBase<ConfigVectorIn2> & q1);
 
+  /**
+   * @brief      Computes the Jacobian of the difference operation with respect to q0 or q1.
+   *
+   * @details    The Jacobian is block diagonal and computed analytically for each joint, which is both cheaper and
+   *             more accurate than finite differences. Only the diagonal blocks of J are written.
+   *
+   * @param[in]  model   Model of rigid body system.
+   * @param[in]  q0      Initial configuration (size model.nq)
+   * @param[in]  q1      Wished configuration (size model.nq)
+   * @param[out] J       Jacobian of the Difference operation, either with respect to q0 or q1 (size model.nv x model.nv).
+   * @param[in]  arg     ARG0 (resp. ARG1) to get the Jacobian with respect to q0 (resp. q1).
+   *
+   */
+  template<typename LieGroup_t, typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorIn1, typename ConfigVectorIn2, typename JacobianMatrixType>
+  void dDifference(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                   const Eigen::MatrixBase<ConfigVectorIn1> & q0,
+                   const Eigen::MatrixBase<ConfigVectorIn2> & q1,
+                   const Eigen::MatrixBase<JacobianMatrixType> & J,
+                   const ArgumentPosition arg);
+
 
   /**
    * @brief      Squared distance between two configuration vectors
@@ -194,6 +214,83 @@ namespace pinocchio
                              const Eigen::MatrixBase<ConfigVector> & q,
                              const Eigen::MatrixBase<JacobianMatrix> & jacobian);
 
+  /**
+   * @brief      Integrate a set of configurations, stored column-wise, for the corresponding set of tangent vectors during one unit time.
+   *
+   * @details    The joint type is dispatched once per joint for the whole set, and the joints living in a vector space
+   *             are integrated for all the configurations at once.
+   *
+   * @param[in]  model   Model that must be integrated
+   * @param[in]  Q       Initial configurations (size model.nq x T)
+   * @param[in]  V       Velocities (size model.nv x T)
+   * @param[out] Qout    The integrated configurations (size model.nq x T)
+   */
+  template<typename LieGroup_t, typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigMatrixIn, typename TangentMatrixIn, typename ConfigMatrixOut>
+  void integrateTrajectory(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                           const Eigen::MatrixBase<ConfigMatrixIn> & Q,
+                           const Eigen::MatrixBase<TangentMatrixIn> & V,
+                           const Eigen::MatrixBase<ConfigMatrixOut> & Qout);
+  
+  /**
+   * @brief      Computes the Jacobians of the integrate operation for a set of configurations and tangent vectors stored column-wise.
+   *
+   * @param[in]  model   Model that must be integrated
+   * @param[in]  Q       Initial configurations (size model.nq x T)
+   * @param[in]  V       Velocities (size model.nv x T)
+   * @param[out] J       Jacobians of the Integrate operation, the block J.middleCols(t*model.nv,model.nv) being the one of the configuration t (size model.nv x T*model.nv)
+   * @param[in]  arg     Argument (either q or v) with respect to which the differentiation is performed
+   */
+  template<typename LieGroup_t, typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigMatrixIn, typename TangentMatrixIn, typename JacobianMatrixType>
+  void dIntegrateTrajectory(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                            const Eigen::MatrixBase<ConfigMatrixIn> & Q,
+                            const Eigen::MatrixBase<TangentMatrixIn> & V,
+                            const Eigen::MatrixBase<JacobianMatrixType> & J,
+                            const ArgumentPosition arg);
+  
+  /**
+   * @brief      Interpolate the model between two sets of configurations stored column-wise
+   *
+   * @param[in]  model   Model to be interpolated
+   * @param[in]  Q0      Initial configurations (size model.nq x T)
+   * @param[in]  Q1      Final configurations (size model.nq x T)
+   * @param[in]  u       u in [0;1] position along the interpolation.
+   * @param[out] Qout    The interpolated configurations (size model.nq x T)
+   */
+  template<typename LieGroup_t, typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename ConfigMatrixOut>
+  void interpolateTrajectory(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                             const Eigen::MatrixBase<ConfigMatrixIn1> & Q0,
+                             const Eigen::MatrixBase<ConfigMatrixIn2> & Q1,
+                             const Scalar & u,
+                             const Eigen::MatrixBase<ConfigMatrixOut> & Qout);
+  
+  /**
+   * @brief      Compute the tangent vectors that must be integrated during one unit time to go from each column of Q0 to the same column of Q1
+   *
+   * @param[in]  model   Model to be differenced
+   * @param[in]  Q0      Initial configurations (size model.nq x T)
+   * @param[in]  Q1      Wished configurations (size model.nq x T)
+   * @param[out] Vout    The corresponding velocities (size model.nv x T)
+   */
+  template<typename LieGroup_t, typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename TangentMatrixOut>
+  void differenceTrajectory(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                            const Eigen::MatrixBase<ConfigMatrixIn1> & Q0,
+                            const Eigen::MatrixBase<ConfigMatrixIn2> & Q1,
+                            const Eigen::MatrixBase<TangentMatrixOut> & Vout);
+  
+  /**
+   * @brief      Squared distances between two sets of configurations stored column-wise
+   *
+   * @param[in]  model      Model we want to compute the distance
+   * @param[in]  Q0         Configurations 0 (size model.nq x T)
+   * @param[in]  Q1         Configurations 1 (size model.nq x T)
+   * @param[out] distances  The squared distances for each joint and each configuration (size model.njoints-1 x T)
+   */
+  template<typename LieGroup_t, typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename DistanceMatrixOut>
+  void squaredDistanceTrajectory(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                 const Eigen::MatrixBase<ConfigMatrixIn1> & Q0,
+                                 const Eigen::MatrixBase<ConfigMatrixIn2> & Q1,
+                                 const Eigen::MatrixBase<DistanceMatrixOut> & distances);
+
 } // namespace pinocchio
 
 /* --- Details -------------------------------------------------------------------- */
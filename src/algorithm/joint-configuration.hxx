@@ -100,7 +100,7 @@ namespace pinocchio
     for(JointIndex i=1; i<(JointIndex) model.njoints; ++i)
     {
       Algo::run(model.joints[i],
-                typename Algo::ArgsType(q0, q1, u, res));
+                typename Algo::ArgsType(q0.derived(), q1.derived(), u, res));
     }
     
     return res;
@@ -137,6 +137,38 @@ namespace pinocchio
     return difference<LieGroupMap,Scalar,Options,JointCollectionTpl,ConfigVectorIn1,ConfigVectorIn2>(model,q0.derived(),q1.derived());
   }
 
+  template<typename LieGroup_t, typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorIn1, typename ConfigVectorIn2, typename JacobianMatrixType>
+  void dDifference(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                   const Eigen::MatrixBase<ConfigVectorIn1> & q0,
+                   const Eigen::MatrixBase<ConfigVectorIn2> & q1,
+                   const Eigen::MatrixBase<JacobianMatrixType> & J,
+                   const ArgumentPosition arg)
+  {
+    assert(q0.size() == model.nq && "The configuration vector q0 is not of right size");
+    assert(q1.size() == model.nq && "The configuration vector q1 is not of right size");
+    assert(J.rows() == model.nv && J.cols() == model.nv && "The Jacobian does not have the right dimension");
+    
+    typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
+    typedef typename Model::JointIndex JointIndex;
+    
+    typedef dDifferenceStep<LieGroup_t,ConfigVectorIn1,ConfigVectorIn2,JacobianMatrixType> Algo;
+    typename Algo::ArgsType args(q0.derived(),q1.derived(),EIGEN_CONST_CAST(JacobianMatrixType,J),arg);
+    for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
+    {
+      Algo::run(model.joints[i], args);
+    }
+  }
+  
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorIn1, typename ConfigVectorIn2, typename JacobianMatrixType>
+  void dDifference(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                   const Eigen::MatrixBase<ConfigVectorIn1> & q0,
+                   const Eigen::MatrixBase<ConfigVectorIn2> & q1,
+                   const Eigen::MatrixBase<JacobianMatrixType> & J,
+                   const ArgumentPosition arg)
+  {
+    dDifference<LieGroupMap,Scalar,Options,JointCollectionTpl,ConfigVectorIn1,ConfigVectorIn2,JacobianMatrixType>(model,q0.derived(),q1.derived(),J.derived(),arg);
+  }
+
   template<typename LieGroup_t,typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorIn1, typename ConfigVectorIn2>
   inline typename EIGEN_PLAIN_TYPE(ConfigVectorIn1)
   squaredDistance(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
@@ -338,6 +370,171 @@ namespace pinocchio
     return integrateCoeffWiseJacobian<LieGroupMap,Scalar,Options,JointCollectionTpl,ConfigVector,JacobianMatrix>(model,q,jacobian);
   }
 
+  
+  template<typename LieGroup_t, typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigMatrixIn, typename TangentMatrixIn, typename ConfigMatrixOut>
+  void integrateTrajectory(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                           const Eigen::MatrixBase<ConfigMatrixIn> & Q,
+                           const Eigen::MatrixBase<TangentMatrixIn> & V,
+                           const Eigen::MatrixBase<ConfigMatrixOut> & Qout)
+  {
+    assert(Q.rows() == model.nq && "The configuration matrix is not of right size");
+    assert(V.rows() == model.nv && V.cols() == Q.cols() && "The velocity matrix is not of right size");
+    assert(Qout.rows() == model.nq && Qout.cols() == Q.cols() && "The output matrix is not of right size");
+    PINOCCHIO_STATIC_ASSERT(!ConfigMatrixIn::IsRowMajor && !ConfigMatrixOut::IsRowMajor,
+                            CONFIGURATIONS_MUST_BE_STORED_COLUMN_WISE);
+    
+    typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
+    typedef typename Model::JointIndex JointIndex;
+    
+    typedef IntegrateTrajectoryStep<LieGroup_t,ConfigMatrixIn,TangentMatrixIn,ConfigMatrixOut> Algo;
+    typename Algo::ArgsType args(Q.derived(),V.derived(),EIGEN_CONST_CAST(ConfigMatrixOut,Qout));
+    for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
+    {
+      Algo::run(model.joints[i], args);
+    }
+  }
+  
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigMatrixIn, typename TangentMatrixIn, typename ConfigMatrixOut>
+  void integrateTrajectory(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                           const Eigen::MatrixBase<ConfigMatrixIn> & Q,
+                           const Eigen::MatrixBase<TangentMatrixIn> & V,
+                           const Eigen::MatrixBase<ConfigMatrixOut> & Qout)
+  {
+    integrateTrajectory<LieGroupMap,Scalar,Options,JointCollectionTpl,ConfigMatrixIn,TangentMatrixIn,ConfigMatrixOut>(model,Q.derived(),V.derived(),Qout.derived());
+  }
+  
+  template<typename LieGroup_t, typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigMatrixIn, typename TangentMatrixIn, typename JacobianMatrixType>
+  void dIntegrateTrajectory(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                            const Eigen::MatrixBase<ConfigMatrixIn> & Q,
+                            const Eigen::MatrixBase<TangentMatrixIn> & V,
+                            const Eigen::MatrixBase<JacobianMatrixType> & J,
+                            const ArgumentPosition arg)
+  {
+    assert(Q.rows() == model.nq && "The configuration matrix is not of right size");
+    assert(V.rows() == model.nv && V.cols() == Q.cols() && "The velocity matrix is not of right size");
+    assert(J.rows() == model.nv && J.cols() == model.nv*Q.cols() && "The Jacobian matrix is not of right size");
+    PINOCCHIO_STATIC_ASSERT(!ConfigMatrixIn::IsRowMajor, CONFIGURATIONS_MUST_BE_STORED_COLUMN_WISE);
+    
+    typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
+    typedef typename Model::JointIndex JointIndex;
+    
+    typedef dIntegrateTrajectoryStep<LieGroup_t,ConfigMatrixIn,TangentMatrixIn,JacobianMatrixType> Algo;
+    typename Algo::ArgsType args(Q.derived(),V.derived(),EIGEN_CONST_CAST(JacobianMatrixType,J),arg);
+    for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
+    {
+      Algo::run(model.joints[i], args);
+    }
+  }
+  
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigMatrixIn, typename TangentMatrixIn, typename JacobianMatrixType>
+  void dIntegrateTrajectory(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                            const Eigen::MatrixBase<ConfigMatrixIn> & Q,
+                            const Eigen::MatrixBase<TangentMatrixIn> & V,
+                            const Eigen::MatrixBase<JacobianMatrixType> & J,
+                            const ArgumentPosition arg)
+  {
+    dIntegrateTrajectory<LieGroupMap,Scalar,Options,JointCollectionTpl,ConfigMatrixIn,TangentMatrixIn,JacobianMatrixType>(model,Q.derived(),V.derived(),J.derived(),arg);
+  }
+  
+  template<typename LieGroup_t, typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename ConfigMatrixOut>
+  void interpolateTrajectory(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                             const Eigen::MatrixBase<ConfigMatrixIn1> & Q0,
+                             const Eigen::MatrixBase<ConfigMatrixIn2> & Q1,
+                             const Scalar & u,
+                             const Eigen::MatrixBase<ConfigMatrixOut> & Qout)
+  {
+    assert(Q0.rows() == model.nq && "The configuration matrix is not of right size");
+    assert(Q1.rows() == model.nq && Q1.cols() == Q0.cols() && "The configuration matrix is not of right size");
+    assert(Qout.rows() == model.nq && Qout.cols() == Q0.cols() && "The output matrix is not of right size");
+    PINOCCHIO_STATIC_ASSERT(!ConfigMatrixIn1::IsRowMajor && !ConfigMatrixIn2::IsRowMajor && !ConfigMatrixOut::IsRowMajor,
+                            CONFIGURATIONS_MUST_BE_STORED_COLUMN_WISE);
+    
+    typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
+    typedef typename Model::JointIndex JointIndex;
+    
+    typedef InterpolateTrajectoryStep<LieGroup_t,ConfigMatrixIn1,ConfigMatrixIn2,Scalar,ConfigMatrixOut> Algo;
+    typename Algo::ArgsType args(Q0.derived(),Q1.derived(),u,EIGEN_CONST_CAST(ConfigMatrixOut,Qout));
+    for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
+    {
+      Algo::run(model.joints[i], args);
+    }
+  }
+  
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename ConfigMatrixOut>
+  void interpolateTrajectory(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                             const Eigen::MatrixBase<ConfigMatrixIn1> & Q0,
+                             const Eigen::MatrixBase<ConfigMatrixIn2> & Q1,
+                             const Scalar & u,
+                             const Eigen::MatrixBase<ConfigMatrixOut> & Qout)
+  {
+    interpolateTrajectory<LieGroupMap,Scalar,Options,JointCollectionTpl,ConfigMatrixIn1,ConfigMatrixIn2,ConfigMatrixOut>(model,Q0.derived(),Q1.derived(),u,Qout.derived());
+  }
+  
+  template<typename LieGroup_t, typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename TangentMatrixOut>
+  void differenceTrajectory(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                            const Eigen::MatrixBase<ConfigMatrixIn1> & Q0,
+                            const Eigen::MatrixBase<ConfigMatrixIn2> & Q1,
+                            const Eigen::MatrixBase<TangentMatrixOut> & Vout)
+  {
+    assert(Q0.rows() == model.nq && "The configuration matrix is not of right size");
+    assert(Q1.rows() == model.nq && Q1.cols() == Q0.cols() && "The configuration matrix is not of right size");
+    assert(Vout.rows() == model.nv && Vout.cols() == Q0.cols() && "The output matrix is not of right size");
+    PINOCCHIO_STATIC_ASSERT(!ConfigMatrixIn1::IsRowMajor && !ConfigMatrixIn2::IsRowMajor,
+                            CONFIGURATIONS_MUST_BE_STORED_COLUMN_WISE);
+    
+    typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
+    typedef typename Model::JointIndex JointIndex;
+    
+    typedef DifferenceTrajectoryStep<LieGroup_t,ConfigMatrixIn1,ConfigMatrixIn2,TangentMatrixOut> Algo;
+    typename Algo::ArgsType args(Q0.derived(),Q1.derived(),EIGEN_CONST_CAST(TangentMatrixOut,Vout));
+    for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
+    {
+      Algo::run(model.joints[i], args);
+    }
+  }
+  
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename TangentMatrixOut>
+  void differenceTrajectory(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                            const Eigen::MatrixBase<ConfigMatrixIn1> & Q0,
+                            const Eigen::MatrixBase<ConfigMatrixIn2> & Q1,
+                            const Eigen::MatrixBase<TangentMatrixOut> & Vout)
+  {
+    differenceTrajectory<LieGroupMap,Scalar,Options,JointCollectionTpl,ConfigMatrixIn1,ConfigMatrixIn2,TangentMatrixOut>(model,Q0.derived(),Q1.derived(),Vout.derived());
+  }
+  
+  template<typename LieGroup_t, typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename DistanceMatrixOut>
+  void squaredDistanceTrajectory(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                 const Eigen::MatrixBase<ConfigMatrixIn1> & Q0,
+                                 const Eigen::MatrixBase<ConfigMatrixIn2> & Q1,
+                                 const Eigen::MatrixBase<DistanceMatrixOut> & distances)
+  {
+    assert(Q0.rows() == model.nq && "The configuration matrix is not of right size");
+    assert(Q1.rows() == model.nq && Q1.cols() == Q0.cols() && "The configuration matrix is not of right size");
+    assert(distances.rows() == model.njoints-1 && distances.cols() == Q0.cols() && "The output matrix is not of right size");
+    PINOCCHIO_STATIC_ASSERT(!ConfigMatrixIn1::IsRowMajor && !ConfigMatrixIn2::IsRowMajor,
+                            CONFIGURATIONS_MUST_BE_STORED_COLUMN_WISE);
+    
+    typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
+    typedef typename Model::JointIndex JointIndex;
+    
+    DistanceMatrixOut & distances_ = EIGEN_CONST_CAST(DistanceMatrixOut,distances);
+    distances_.setZero();
+    typedef SquaredDistanceTrajectoryStep<LieGroup_t,ConfigMatrixIn1,ConfigMatrixIn2,DistanceMatrixOut> Algo;
+    for(JointIndex i=0; i<(JointIndex) model.njoints-1; ++i)
+    {
+      typename Algo::ArgsType args(i,Q0.derived(),Q1.derived(),distances_);
+      Algo::run(model.joints[i+1], args);
+    }
+  }
+  
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename DistanceMatrixOut>
+  void squaredDistanceTrajectory(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                 const Eigen::MatrixBase<ConfigMatrixIn1> & Q0,
+                                 const Eigen::MatrixBase<ConfigMatrixIn2> & Q1,
+                                 const Eigen::MatrixBase<DistanceMatrixOut> & distances)
+  {
+    squaredDistanceTrajectory<LieGroupMap,Scalar,Options,JointCollectionTpl,ConfigMatrixIn1,ConfigMatrixIn2,DistanceMatrixOut>(model,Q0.derived(),Q1.derived(),distances.derived());
+  }
 
 } // namespace pinocchio
 
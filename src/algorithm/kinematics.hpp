@@ -55,6 +55,42 @@ namespace pinocchio
                                 DataTpl<Scalar,Options,JointCollectionTpl> & data,
                                 const Eigen::MatrixBase<ConfigVectorType> & q);
 
+  ///
+  /// \brief Update the joint placements according to the current joint configuration, in the quaternion
+  ///        representation (data.oMi_quat).
+  ///
+  /// \details This is the kinematics-only counterpart of forwardKinematics for workloads dominated by memory
+  ///          traffic: each placement holds 7 scalars instead of 12. data.oMi and data.liMi are not updated.
+  ///          Use updateGlobalPlacementsFromQuaternion or SE3Quaternion::toSE3 to convert the placements on demand.
+  ///          The rotations of the joint placements are converted on the fly, unless they are the identity. The
+  ///          revolute, prismatic, spherical and free-flyer joints are composed from q without forming any rotation
+  ///          matrix, and their joint data are not updated.
+  ///          data.oMi_quat is allocated by the first call.
+  ///
+  /// \tparam JointCollection Collection of Joint types.
+  /// \tparam ConfigVectorType Type of the joint configuration vector.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration (vector dim model.nq).
+  ///
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType>
+  inline void forwardKinematicsQuaternion(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                          DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                          const Eigen::MatrixBase<ConfigVectorType> & q);
+  
+  ///
+  /// \brief Update data.oMi from the joint placements data.oMi_quat computed by forwardKinematicsQuaternion.
+  ///
+  /// \tparam JointCollection Collection of Joint types.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  ///
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+  inline void updateGlobalPlacementsFromQuaternion(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                                   DataTpl<Scalar,Options,JointCollectionTpl> & data);
+
   ///
   /// \brief Update the joint placements and spatial velocities according to the current joint configuration and velocity.
   ///
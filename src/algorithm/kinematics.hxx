@@ -8,6 +8,10 @@
 #include "pinocchio/multibody/visitor.hpp"
 #include "pinocchio/algorithm/check.hpp"
 
+#ifdef PINOCCHIO_WITH_PROFILER
+  #include "pinocchio/utils/profiler.hpp"
+#endif
+
 namespace pinocchio 
 {
   
@@ -107,6 +111,7 @@ namespace pinocchio
   {
     assert(q.size() == model.nq && "The configuration vector is not of right size");
     assert(model.check(data) && "data is not consistent with model.");
+    PINOCCHIO_PROFILER_SCOPE("forwardKinematics");
     
     typedef typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex JointIndex;
     
@@ -118,6 +123,231 @@ namespace pinocchio
     }
   }
 
+  namespace details
+  {
+    ///
+    /// \brief Computes oMj = oMp * pMj in the quaternion representation, where pMj is given in the rotation matrix
+    ///        representation. The rotation of pMj is only converted when it is not the identity.
+    ///
+    template<typename SE3Quaternion, typename SE3>
+    inline void composeQuaternion(const SE3Quaternion & oMp,
+                                  const SE3 & pMj,
+                                  SE3Quaternion & oMj)
+    {
+      typedef typename SE3Quaternion::Quaternion Quaternion;
+      
+      oMj.translation() = oMp.act(pMj.translation());
+      if(pMj.rotation().isIdentity())
+        oMj.rotation() = oMp.rotation();
+      else
+        oMj.rotation() = oMp.rotation() * Quaternion(pMj.rotation());
+    }
+    
+    ///
+    /// \brief Computes oMi = oMj * jMi in the quaternion representation, where jMi is the transform of the joint
+    ///        for the configuration q.
+    ///
+    /// \details The generic implementation calls jmodel.calc and converts the rotation matrix of the joint transform.
+    ///          The joints whose rotation is directly given by the configuration vector, or whose transform is a pure
+    ///          rotation around a cartesian axis or a pure translation, are specialized below. They read q and
+    ///          leave the joint data untouched.
+    ///
+    template<typename JointModel>
+    struct JointTransformQuaternion
+    {
+      template<typename JointData, typename ConfigVectorType, typename SE3Quaternion>
+      static void run(const JointModel & jmodel,
+                      JointData & jdata,
+                      const Eigen::MatrixBase<ConfigVectorType> & q,
+                      const SE3Quaternion & oMj,
+                      SE3Quaternion & oMi)
+      {
+        jmodel.calc(jdata,q.derived());
+        composeQuaternion(oMj,typename SE3Quaternion::SE3(jdata.M),oMi);
+      }
+    };
+
+    template<typename Scalar, int Options, int axis>
+    struct JointTransformQuaternion< JointModelRevoluteTpl<Scalar,Options,axis> >
+    {
+      template<typename JointData, typename ConfigVectorType, typename SE3Quaternion>
+      static void run(const JointModelRevoluteTpl<Scalar,Options,axis> & jmodel,
+                      JointData &,
+                      const Eigen::MatrixBase<ConfigVectorType> & q,
+                      const SE3Quaternion & oMj,
+                      SE3Quaternion & oMi)
+      {
+        typedef typename SE3Quaternion::Quaternion Quaternion;
+        
+        // (cos(angle/2), sin(angle/2) * axis)
+        Quaternion jRi;
+        jRi.vec().setZero();
+        SINCOS(q[jmodel.idx_q()]/Scalar(2),&jRi.vec()[axis],&jRi.w());
+
+        oMi.rotation() = oMj.rotation() * jRi;
+        oMi.translation() = oMj.translation();
+      }
+    };
+
+    template<typename Scalar, int Options, int axis>
+    struct JointTransformQuaternion< JointModelRevoluteUnboundedTpl<Scalar,Options,axis> >
+    {
+      template<typename JointData, typename ConfigVectorType, typename SE3Quaternion>
+      static void run(const JointModelRevoluteUnboundedTpl<Scalar,Options,axis> & jmodel,
+                      JointData &,
+                      const Eigen::MatrixBase<ConfigVectorType> & q,
+                      const SE3Quaternion & oMj,
+                      SE3Quaternion & oMi)
+      {
+        typedef typename SE3Quaternion::Quaternion Quaternion;
+
+        const Scalar & c = q[jmodel.idx_q()];
+        const Scalar & s = q[jmodel.idx_q()+1];
+
+        // (1+c, s) and (s, 1-c) are both proportional to (cos(angle/2), sin(angle/2)).
+        // The first one is used when it is far from zero, i.e. when c >= 0.
+        Quaternion jRi;
+        jRi.vec().setZero();
+        if(c >= Scalar(0))
+        {
+          jRi.w() = Scalar(1) + c;
+          jRi.vec()[axis] = s;
+        }
+        else
+        {
+          jRi.w() = s;
+          jRi.vec()[axis] = Scalar(1) - c;
+        }
+        jRi.coeffs() /= math::sqrt(jRi.w()*jRi.w() + jRi.vec()[axis]*jRi.vec()[axis]);
+
+        oMi.rotation() = oMj.rotation() * jRi;
+        oMi.translation() = oMj.translation();
+      }
+    };
+
+    template<typename Scalar, int Options, int axis>
+    struct JointTransformQuaternion< JointModelPrismaticTpl<Scalar,Options,axis> >
+    {
+      template<typename JointData, typename ConfigVectorType, typename SE3Quaternion>
+      static void run(const JointModelPrismaticTpl<Scalar,Options,axis> & jmodel,
+                      JointData &,
+                      const Eigen::MatrixBase<ConfigVectorType> & q,
+                      const SE3Quaternion & oMj,
+                      SE3Quaternion & oMi)
+      {
+        typename SE3Quaternion::Vector3 jpi(SE3Quaternion::Vector3::Zero());
+        jpi[axis] = q[jmodel.idx_q()];
+        oMi.rotation() = oMj.rotation();
+        oMi.translation() = oMj.act(jpi);
+      }
+    };
+
+    template<typename Scalar, int Options>
+    struct JointTransformQuaternion< JointModelSphericalTpl<Scalar,Options> >
+    {
+      template<typename JointData, typename ConfigVectorType, typename SE3Quaternion>
+      static void run(const JointModelSphericalTpl<Scalar,Options> & jmodel,
+                      JointData &,
+                      const Eigen::MatrixBase<ConfigVectorType> & q,
+                      const SE3Quaternion & oMj,
+                      SE3Quaternion & oMi)
+      {
+        typedef Eigen::Map<const typename SE3Quaternion::Quaternion> ConstQuaternionMap;
+        typename ConfigVectorType::template ConstFixedSegmentReturnType<4>::Type q_joint
+        = q.template segment<4>(jmodel.idx_q());
+
+        oMi.rotation() = oMj.rotation() * ConstQuaternionMap(q_joint.data());
+        oMi.translation() = oMj.translation();
+      }
+    };
+
+    template<typename Scalar, int Options>
+    struct JointTransformQuaternion< JointModelFreeFlyerTpl<Scalar,Options> >
+    {
+      template<typename JointData, typename ConfigVectorType, typename SE3Quaternion>
+      static void run(const JointModelFreeFlyerTpl<Scalar,Options> & jmodel,
+                      JointData &,
+                      const Eigen::MatrixBase<ConfigVectorType> & q,
+                      const SE3Quaternion & oMj,
+                      SE3Quaternion & oMi)
+      {
+        typedef Eigen::Map<const typename SE3Quaternion::Quaternion> ConstQuaternionMap;
+        typename ConfigVectorType::template ConstFixedSegmentReturnType<7>::Type q_joint
+        = q.template segment<7>(jmodel.idx_q());
+
+        oMi.translation() = oMj.act(q_joint.template head<3>());
+        oMi.rotation() = oMj.rotation() * ConstQuaternionMap(q_joint.template tail<4>().data());
+      }
+    };
+  } // namespace details
+
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType>
+  struct ForwardKinematicQuaternionStep
+  : fusion::JointVisitorBase< ForwardKinematicQuaternionStep<Scalar,Options,JointCollectionTpl,ConfigVectorType> >
+  {
+    typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
+    typedef DataTpl<Scalar,Options,JointCollectionTpl> Data;
+    
+    typedef boost::fusion::vector<const Model &,
+                                  Data &,
+                                  const ConfigVectorType &> ArgsType;
+    
+    template<typename JointModel>
+    static void algo(const JointModelBase<JointModel> & jmodel,
+                     JointDataBase<typename JointModel::JointDataDerived> & jdata,
+                     const Model & model,
+                     Data & data,
+                     const Eigen::MatrixBase<ConfigVectorType> & q)
+    {
+      typedef typename Model::JointIndex JointIndex;
+      typedef typename Data::SE3Quaternion SE3Quaternion;
+      
+      const JointIndex & i = jmodel.id();
+      const JointIndex & parent = model.parents[i];
+
+      // Placement of the input of the joint, then of its output.
+      SE3Quaternion oMj;
+      details::composeQuaternion(data.oMi_quat[parent],model.jointPlacements[i],oMj);
+      details::JointTransformQuaternion<JointModel>::run(jmodel.derived(),jdata.derived(),q,oMj,data.oMi_quat[i]);
+    }
+  };
+
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType>
+  inline void forwardKinematicsQuaternion(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                          DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                          const Eigen::MatrixBase<ConfigVectorType> & q)
+  {
+    assert(q.size() == model.nq && "The configuration vector is not of right size");
+    assert(model.check(data) && "data is not consistent with model.");
+    PINOCCHIO_PROFILER_SCOPE("forwardKinematicsQuaternion");
+    
+    typedef typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex JointIndex;
+    typedef typename DataTpl<Scalar,Options,JointCollectionTpl>::SE3Quaternion SE3Quaternion;
+    
+    // The placements are only allocated by the first call.
+    if(data.oMi_quat.size() != (std::size_t)model.njoints)
+      data.oMi_quat.assign((std::size_t)model.njoints,SE3Quaternion::Identity());
+    
+    typedef ForwardKinematicQuaternionStep<Scalar,Options,JointCollectionTpl,ConfigVectorType> Algo;
+    for(JointIndex i=1; i < (JointIndex)model.njoints; ++i)
+    {
+      Algo::run(model.joints[i], data.joints[i],
+                typename Algo::ArgsType(model,data,q.derived()));
+    }
+  }
+  
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+  inline void updateGlobalPlacementsFromQuaternion(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                                   DataTpl<Scalar,Options,JointCollectionTpl> & data)
+  {
+    assert(model.check(data) && "data is not consistent with model.");
+    
+    typedef typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex JointIndex;
+    
+    for(JointIndex i=1; i < (JointIndex)model.njoints; ++i)
+      data.oMi_quat[i].toSE3(data.oMi[i]);
+  }
+
   template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType, typename TangentVectorType>
   struct ForwardKinematicFirstStep
   : fusion::JointVisitorBase< ForwardKinematicFirstStep<Scalar,Options,JointCollectionTpl,ConfigVectorType,TangentVectorType> >
@@ -170,6 +400,7 @@ namespace pinocchio
     assert(q.size() == model.nq && "The configuration vector is not of right size");
     assert(v.size() == model.nv && "The velocity vector is not of right size");
     assert(model.check(data) && "data is not consistent with model.");
+    PINOCCHIO_PROFILER_SCOPE("forwardKinematics");
     
     typedef typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex JointIndex;
     
@@ -240,6 +471,7 @@ namespace pinocchio
     assert(v.size() == model.nv && "The velocity vector is not of right size");
     assert(a.size() == model.nv && "The acceleration vector is not of right size");
     assert(model.check(data) && "data is not consistent with model.");
+    PINOCCHIO_PROFILER_SCOPE("forwardKinematics");
     
     typedef typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex JointIndex;
     
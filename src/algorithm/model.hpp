@@ -0,0 +1,56 @@
+//
+// Copyright (c) 2018 CNRS
+//
+
+#ifndef __pinocchio_algorithm_model_hpp__
+#define __pinocchio_algorithm_model_hpp__
+
+#include "pinocchio/multibody/model.hpp"
+
+namespace pinocchio
+{
+  ///
+  /// \brief Computes the depth-first (preorder) traversal of the kinematic tree, starting from the universe.
+  ///        The children of a joint are visited in the order they have been added to the model.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  ///
+  /// \return The joint indexes in depth-first order (the first element is the universe).
+  ///
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+  inline std::vector<JointIndex>
+  depthFirstOrder(const ModelTpl<Scalar,Options,JointCollectionTpl> & model);
+
+  ///
+  /// \brief Builds a copy of the model where the joints are renumbered in depth-first order.
+  ///
+  /// \details The joints (and their bodies) are stored in the order they have been added by the parsers.
+  ///          After finalization, the subtree of any joint holds contiguous joint indexes, and each
+  ///          configuration and tangent vector segment of a subtree is contiguous too. This numbering is
+  ///          required by checkData and by the subtree-parallel passes, and it keeps each branch of the tree
+  ///          packed in all the per-joint arrays of Model and Data.
+  ///          The joint names, frames and limits are preserved. Configuration and tangent vectors must be
+  ///          permuted accordingly (the joint named name keeps the same segment length).
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[out] finalized_model The renumbered model.
+  ///
+  /// \return The permutation from the new joint indexes to the original ones (finalized_model.joints[i] stands
+  ///         for model.joints[perm[i]]).
+  ///
+  /// \remarks A model built in depth-first order is returned unchanged. The Data associated to
+  ///          finalized_model must be allocated from finalized_model.
+  ///
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+  inline std::vector<JointIndex>
+  finalizeModel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                ModelTpl<Scalar,Options,JointCollectionTpl> & finalized_model);
+
+} // namespace pinocchio
+
+/* --- Details -------------------------------------------------------------------- */
+/* --- Details -------------------------------------------------------------------- */
+/* --- Details -------------------------------------------------------------------- */
+#include "pinocchio/algorithm/model.hxx"
+
+#endif // ifndef __pinocchio_algorithm_model_hpp__
@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2018 CNRS
+//
+
+#ifndef __pinocchio_algorithm_model_hxx__
+#define __pinocchio_algorithm_model_hxx__
+
+/// @cond DEV
+
+namespace pinocchio
+{
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+  inline std::vector<JointIndex>
+  depthFirstOrder(const ModelTpl<Scalar,Options,JointCollectionTpl> & model)
+  {
+    const size_t njoints = (size_t)model.njoints;
+
+    std::vector< std::vector<JointIndex> > children(njoints);
+    for(JointIndex i=1; i<njoints; ++i)
+      children[model.parents[i]].push_back(i);
+
+    std::vector<JointIndex> order; order.reserve(njoints);
+    std::vector<JointIndex> stack(1,0);
+    while(!stack.empty())
+    {
+      const JointIndex i = stack.back(); stack.pop_back();
+      order.push_back(i);
+      // Pushed in reverse order so that the first child is visited first.
+      for(typename std::vector<JointIndex>::const_reverse_iterator it = children[i].rbegin();
+          it != children[i].rend(); ++it)
+        stack.push_back(*it);
+    }
+
+    return order;
+  }
+
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+  inline std::vector<JointIndex>
+  finalizeModel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                ModelTpl<Scalar,Options,JointCollectionTpl> & finalized_model)
+  {
+    typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
+    typedef typename Model::JointModel JointModel;
+
+    const std::vector<JointIndex> perm = depthFirstOrder(model);
+    const size_t njoints = perm.size();
+
+    std::vector<JointIndex> new_index(njoints);
+    for(JointIndex k=0; k<njoints; ++k)
+      new_index[perm[k]] = k;
+
+    finalized_model = model;
+
+    int idx_q = 0, idx_v = 0;
+    for(JointIndex k=1; k<njoints; ++k)
+    {
+      const JointIndex i = perm[k];
+      const JointModel & jmodel = model.joints[i];
+
+      finalized_model.joints[k] = jmodel;
+      finalized_model.joints[k].setIndexes(k,idx_q,idx_v);
+      finalized_model.inertias[k] = model.inertias[i];
+      finalized_model.jointPlacements[k] = model.jointPlacements[i];
+      finalized_model.names[k] = model.names[i];
+      finalized_model.parents[k] = new_index[model.parents[i]];
+
+      finalized_model.neutralConfiguration.segment(idx_q,jmodel.nq())
+      = model.neutralConfiguration.segment(jmodel.idx_q(),jmodel.nq());
+      finalized_model.lowerPositionLimit.segment(idx_q,jmodel.nq())
+      = model.lowerPositionLimit.segment(jmodel.idx_q(),jmodel.nq());
+      finalized_model.upperPositionLimit.segment(idx_q,jmodel.nq())
+      = model.upperPositionLimit.segment(jmodel.idx_q(),jmodel.nq());
+
+      finalized_model.effortLimit.segment(idx_v,jmodel.nv())
+      = model.effortLimit.segment(jmodel.idx_v(),jmodel.nv());
+      finalized_model.velocityLimit.segment(idx_v,jmodel.nv())
+      = model.velocityLimit.segment(jmodel.idx_v(),jmodel.nv());
+      finalized_model.rotorInertia.segment(idx_v,jmodel.nv())
+      = model.rotorInertia.segment(jmodel.idx_v(),jmodel.nv());
+      finalized_model.rotorGearRatio.segment(idx_v,jmodel.nv())
+      = model.rotorGearRatio.segment(jmodel.idx_v(),jmodel.nv());
+
+      idx_q += jmodel.nq();
+      idx_v += jmodel.nv();
+    }
+    assert(idx_q == model.nq && idx_v == model.nv);
+
+    // The subtrees are rebuilt as in ModelTpl::addJoint.
+    for(JointIndex k=1; k<njoints; ++k)
+    {
+      finalized_model.subtrees[k].assign(1,k);
+      for(JointIndex parent = finalized_model.parents[k]; parent>0; parent = finalized_model.parents[parent])
+        finalized_model.subtrees[parent].push_back(k);
+    }
+
+    for(size_t k=0; k<finalized_model.frames.size(); ++k)
+      finalized_model.frames[k].parent = new_index[model.frames[k].parent];
+
+    return perm;
+  }
+
+} // namespace pinocchio
+
+/// @endcond
+
+#endif // ifndef __pinocchio_algorithm_model_hxx__
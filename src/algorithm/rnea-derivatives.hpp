@@ -74,7 +74,45 @@ namespace pinocchio
                          const Eigen::MatrixBase<MatrixType1> & rnea_partial_dq,
                          const Eigen::MatrixBase<MatrixType2> & rnea_partial_dv,
                          const Eigen::MatrixBase<MatrixType3> & rnea_partial_da);
-  
+
+  ///
+  /// \brief Computes the derivatives of the Recursive Newton Euler Algorithms, with the independent branches
+  ///        of the kinematic tree handled by different threads (see forwardPassParallel and backwardPassParallel).
+  ///
+  /// \tparam JointCollection Collection of Joint types.
+  /// \tparam ConfigVectorType Type of the joint configuration vector.
+  /// \tparam TangentVectorType1 Type of the joint velocity vector.
+  /// \tparam TangentVectorType2 Type of the joint acceleration vector.
+  /// \tparam MatrixType1 Type of the matrix containing the partial derivative with respect to the joint configuration vector.
+  /// \tparam MatrixType2 Type of the matrix containing the partial derivative with respect to the joint velocity vector.
+  /// \tparam MatrixType3 Type of the matrix containing the partial derivative with respect to the joint acceleration vector.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration vector (dim model.nq).
+  /// \param[in] v The joint velocity vector (dim model.nv).
+  /// \param[in] a The joint acceleration vector (dim model.nv).
+  /// \param[out] rnea_partial_dq Partial derivative of the generalized torque vector with respect to the joint configuration.
+  /// \param[out] rnea_partial_dv Partial derivative of the generalized torque vector with respect to the joint velocity.
+  /// \param[out] rnea_partial_da Partial derivative of the generalized torque vector with respect to the joint acceleration.
+  /// \param[in] num_threads Number of threads. It is only effective when Pinocchio is built with OpenMP support.
+  ///            With more than one thread, the model must be numbered in depth-first order (see finalizeModel).
+  ///
+  /// \remark As for computeRNEADerivatives, the partial derivatives must be first initialized with zeros.
+  ///
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType, typename TangentVectorType1, typename TangentVectorType2,
+  typename MatrixType1, typename MatrixType2, typename MatrixType3>
+  inline void
+  computeRNEADerivativesParallel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                 DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                 const Eigen::MatrixBase<ConfigVectorType> & q,
+                                 const Eigen::MatrixBase<TangentVectorType1> & v,
+                                 const Eigen::MatrixBase<TangentVectorType2> & a,
+                                 const Eigen::MatrixBase<MatrixType1> & rnea_partial_dq,
+                                 const Eigen::MatrixBase<MatrixType2> & rnea_partial_dv,
+                                 const Eigen::MatrixBase<MatrixType3> & rnea_partial_da,
+                                 const int num_threads);
+
   ///
   /// \brief Computes the derivatives of the Recursive Newton Euler Algorithms
   ///        with respect to the joint configuration, the joint velocity and the joint acceleration.
@@ -8,6 +8,11 @@
 #include "pinocchio/multibody/visitor.hpp"
 #include "pinocchio/algorithm/check.hpp"
 
+#ifdef PINOCCHIO_WITH_PROFILER
+  #include "pinocchio/utils/profiler.hpp"
+#endif
+#include "pinocchio/algorithm/subtree-parallel.hpp"
+
 namespace pinocchio
 {
   
@@ -131,6 +136,7 @@ namespace pinocchio
     assert(gravity_partial_dq.cols() == model.nv);
     assert(gravity_partial_dq.rows() == model.nv);
     assert(model.check(data) && "data is not consistent with model.");
+    PINOCCHIO_PROFILER_SCOPE("computeGeneralizedGravityDerivatives");
     
     typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
     typedef typename Model::JointIndex JointIndex;
@@ -138,18 +144,24 @@ namespace pinocchio
     data.a_gf[0] = -model.gravity;
     
     typedef ComputeGeneralizedGravityDerivativeForwardStep<Scalar,Options,JointCollectionTpl,ConfigVectorType> Pass1;
-    for(JointIndex i=1; i<(JointIndex) model.njoints; ++i)
     {
-      Pass1::run(model.joints[i],data.joints[i],
-                 typename Pass1::ArgsType(model,data,q.derived()));
+      PINOCCHIO_PROFILER_SCOPE("forward pass");
+      for(JointIndex i=1; i<(JointIndex) model.njoints; ++i)
+      {
+        Pass1::run(model.joints[i],data.joints[i],
+                   typename Pass1::ArgsType(model,data,q.derived()));
+      }
     }
     
     typedef ComputeGeneralizedGravityDerivativeBackwardStep<Scalar,Options,JointCollectionTpl,ReturnMatrixType> Pass2;
     ReturnMatrixType & gravity_partial_dq_ = EIGEN_CONST_CAST(ReturnMatrixType,gravity_partial_dq);
-    for(JointIndex i=(JointIndex)(model.njoints-1); i>0; --i)
     {
-      Pass2::run(model.joints[i],
-                 typename Pass2::ArgsType(model,data,gravity_partial_dq_));
+      PINOCCHIO_PROFILER_SCOPE("backward pass");
+      for(JointIndex i=(JointIndex)(model.njoints-1); i>0; --i)
+      {
+        Pass2::run(model.joints[i],
+                   typename Pass2::ArgsType(model,data,gravity_partial_dq_));
+      }
     }
   }
   
@@ -278,8 +290,8 @@ namespace pinocchio
       
       const JointIndex & i = jmodel.id();
       const JointIndex & parent = model.parents[i];
-      typename Data::RowMatrix6 & M6tmpR = data.M6tmpR;
-      typename Data::RowMatrix6 & M6tmpR2 = data.M6tmpR2;
+      // Local buffers, so that independent branches can be processed concurrently.
+      typename Data::RowMatrix6 M6tmpR, M6tmpR2;
 
       typedef typename SizeDepType<JointModel::NV>::template ColsReturn<typename Data::Matrix6x>::Type ColsBlock;
       
@@ -380,6 +392,22 @@ namespace pinocchio
                          const Eigen::MatrixBase<MatrixType1> & rnea_partial_dq,
                          const Eigen::MatrixBase<MatrixType2> & rnea_partial_dv,
                          const Eigen::MatrixBase<MatrixType3> & rnea_partial_da)
+  {
+    computeRNEADerivativesParallel(model,data,q,v,a,rnea_partial_dq,rnea_partial_dv,rnea_partial_da,1);
+  }
+  
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType, typename TangentVectorType1, typename TangentVectorType2,
+  typename MatrixType1, typename MatrixType2, typename MatrixType3>
+  inline void
+  computeRNEADerivativesParallel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                 DataTpl<Scalar,Options,JointCollectionTpl> & data,
+                                 const Eigen::MatrixBase<ConfigVectorType> & q,
+                                 const Eigen::MatrixBase<TangentVectorType1> & v,
+                                 const Eigen::MatrixBase<TangentVectorType2> & a,
+                                 const Eigen::MatrixBase<MatrixType1> & rnea_partial_dq,
+                                 const Eigen::MatrixBase<MatrixType2> & rnea_partial_dv,
+                                 const Eigen::MatrixBase<MatrixType3> & rnea_partial_da,
+                                 const int num_threads)
   {
     assert(q.size() == model.nq && "The joint configuration vector is not of right size");
     assert(v.size() == model.nv && "The joint velocity vector is not of right size");
@@ -391,27 +419,28 @@ namespace pinocchio
     assert(rnea_partial_da.cols() == model.nv);
     assert(rnea_partial_da.rows() == model.nv);
     assert(model.check(data) && "data is not consistent with model.");
+    PINOCCHIO_PROFILER_SCOPE("computeRNEADerivatives");
     
     typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
-    typedef typename Model::JointIndex JointIndex;
+    typedef DataTpl<Scalar,Options,JointCollectionTpl> Data;
     
     data.oa[0] = -model.gravity;
     
     typedef ComputeRNEADerivativesForwardStep<Scalar,Options,JointCollectionTpl,ConfigVectorType,TangentVectorType1,TangentVectorType2> Pass1;
-    for(JointIndex i=1; i<(JointIndex) model.njoints; ++i)
+    typename Pass1::ArgsType arg1(model,data,q.derived(),v.derived(),a.derived());
     {
-      Pass1::run(model.joints[i],data.joints[i],
-                 typename Pass1::ArgsType(model,data,q.derived(),v.derived(),a.derived()));
+      PINOCCHIO_PROFILER_SCOPE("forward pass");
+      forwardPassParallel(model,JointPassFunctor<Pass1,Model,Data>(model,data,arg1),num_threads);
     }
     
     typedef ComputeRNEADerivativesBackwardStep<Scalar,Options,JointCollectionTpl,MatrixType1,MatrixType2,MatrixType3> Pass2;
-    for(JointIndex i=(JointIndex)(model.njoints-1); i>0; --i)
+    typename Pass2::ArgsType arg2(model,data,
+                                  EIGEN_CONST_CAST(MatrixType1,rnea_partial_dq),
+                                  EIGEN_CONST_CAST(MatrixType2,rnea_partial_dv),
+                                  EIGEN_CONST_CAST(MatrixType3,rnea_partial_da));
     {
-      Pass2::run(model.joints[i],
-                 typename Pass2::ArgsType(model,data,
-                                          EIGEN_CONST_CAST(MatrixType1,rnea_partial_dq),
-                                          EIGEN_CONST_CAST(MatrixType2,rnea_partial_dv),
-                                          EIGEN_CONST_CAST(MatrixType3,rnea_partial_da)));
+      PINOCCHIO_PROFILER_SCOPE("backward pass");
+      backwardPassParallel(model,JointPassFunctor<Pass2,Model,Data,false>(model,data,arg2),num_threads);
     }
   }
   
@@ -439,6 +468,7 @@ namespace pinocchio
     assert(rnea_partial_da.cols() == model.nv);
     assert(rnea_partial_da.rows() == model.nv);
     assert(model.check(data) && "data is not consistent with model.");
+    PINOCCHIO_PROFILER_SCOPE("computeRNEADerivatives");
     
     typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
     typedef typename Model::JointIndex JointIndex;
@@ -446,21 +476,27 @@ namespace pinocchio
     data.oa[0] = -model.gravity;
     
     typedef ComputeRNEADerivativesForwardStep<Scalar,Options,JointCollectionTpl,ConfigVectorType,TangentVectorType1,TangentVectorType2> Pass1;
-    for(JointIndex i=1; i<(JointIndex) model.njoints; ++i)
     {
-      Pass1::run(model.joints[i],data.joints[i],
-                 typename Pass1::ArgsType(model,data,q.derived(),v.derived(),a.derived()));
-      data.of[i] -= data.oMi[i].act(fext[i]);
+      PINOCCHIO_PROFILER_SCOPE("forward pass");
+      for(JointIndex i=1; i<(JointIndex) model.njoints; ++i)
+      {
+        Pass1::run(model.joints[i],data.joints[i],
+                   typename Pass1::ArgsType(model,data,q.derived(),v.derived(),a.derived()));
+        data.of[i] -= data.oMi[i].act(fext[i]);
+      }
     }
     
     typedef ComputeRNEADerivativesBackwardStep<Scalar,Options,JointCollectionTpl,MatrixType1,MatrixType2,MatrixType3> Pass2;
-    for(JointIndex i=(JointIndex)(model.njoints-1); i>0; --i)
     {
-      Pass2::run(model.joints[i],
-                 typename Pass2::ArgsType(model,data,
-                                          EIGEN_CONST_CAST(MatrixType1,rnea_partial_dq),
-                                          EIGEN_CONST_CAST(MatrixType2,rnea_partial_dv),
-                                          EIGEN_CONST_CAST(MatrixType3,rnea_partial_da)));
+      PINOCCHIO_PROFILER_SCOPE("backward pass");
+      for(JointIndex i=(JointIndex)(model.njoints-1); i>0; --i)
+      {
+        Pass2::run(model.joints[i],
+                   typename Pass2::ArgsType(model,data,
+                                            EIGEN_CONST_CAST(MatrixType1,rnea_partial_dq),
+                                            EIGEN_CONST_CAST(MatrixType2,rnea_partial_dv),
+                                            EIGEN_CONST_CAST(MatrixType3,rnea_partial_da)));
+      }
     }
   }
   
@@ -33,7 +33,35 @@ namespace pinocchio
        const Eigen::MatrixBase<ConfigVectorType> & q,
        const Eigen::MatrixBase<TangentVectorType1> & v,
        const Eigen::MatrixBase<TangentVectorType2> & a);
-  
+
+  ///
+  /// \brief The Recursive Newton-Euler algorithm, with the independent branches of the kinematic tree
+  ///        handled by different threads (see forwardPassParallel and backwardPassParallel).
+  ///
+  /// \tparam JointCollection Collection of Joint types.
+  /// \tparam ConfigVectorType Type of the joint configuration vector.
+  /// \tparam TangentVectorType1 Type of the joint velocity vector.
+  /// \tparam TangentVectorType2 Type of the joint acceleration vector.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] data The data structure of the rigid body system.
+  /// \param[in] q The joint configuration vector (dim model.nq).
+  /// \param[in] v The joint velocity vector (dim model.nv).
+  /// \param[in] a The joint acceleration vector (dim model.nv).
+  /// \param[in] num_threads Number of threads. It is only effective when Pinocchio is built with OpenMP support.
+  ///            With more than one thread, the model must be numbered in depth-first order (see finalizeModel).
+  ///
+  /// \return The desired joint torques stored in data.tau.
+  ///
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType, typename TangentVectorType1, typename TangentVectorType2>
+  inline const typename DataTpl<Scalar,Options,JointCollectionTpl>::TangentVectorType &
+  rneaParallel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+               DataTpl<Scalar,Options,JointCollectionTpl> & data,
+               const Eigen::MatrixBase<ConfigVectorType> & q,
+               const Eigen::MatrixBase<TangentVectorType1> & v,
+               const Eigen::MatrixBase<TangentVectorType2> & a,
+               const int num_threads);
+
   ///
   /// \brief The Recursive Newton-Euler algorithm. It computes the inverse dynamics, aka the joint torques according to the current state of the system, the desired joint accelerations and the external forces.
   ///
@@ -10,6 +10,11 @@
 #include "pinocchio/multibody/visitor.hpp"
 #include "pinocchio/algorithm/check.hpp"
 
+#ifdef PINOCCHIO_WITH_PROFILER
+  #include "pinocchio/utils/profiler.hpp"
+#endif
+#include "pinocchio/algorithm/subtree-parallel.hpp"
+
 namespace pinocchio
 {
   template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType, typename TangentVectorType1, typename TangentVectorType2>
@@ -99,32 +104,43 @@ namespace pinocchio
        const Eigen::MatrixBase<ConfigVectorType> & q,
        const Eigen::MatrixBase<TangentVectorType1> & v,
        const Eigen::MatrixBase<TangentVectorType2> & a)
+  {
+    return rneaParallel(model,data,q,v,a,1);
+  }
+  
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename ConfigVectorType, typename TangentVectorType1, typename TangentVectorType2>
+  inline const typename DataTpl<Scalar,Options,JointCollectionTpl>::TangentVectorType &
+  rneaParallel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+               DataTpl<Scalar,Options,JointCollectionTpl> & data,
+               const Eigen::MatrixBase<ConfigVectorType> & q,
+               const Eigen::MatrixBase<TangentVectorType1> & v,
+               const Eigen::MatrixBase<TangentVectorType2> & a,
+               const int num_threads)
   {
     assert(model.check(data) && "data is not consistent with model.");
     assert(q.size() == model.nq && "The configuration vector is not of right size");
     assert(v.size() == model.nv && "The velocity vector is not of right size");
     assert(a.size() == model.nv && "The acceleration vector is not of right size");
+    PINOCCHIO_PROFILER_SCOPE("rnea");
     
     typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
-    typedef typename Model::JointIndex JointIndex;
+    typedef DataTpl<Scalar,Options,JointCollectionTpl> Data;
     
     data.v[0].setZero();
     data.a_gf[0] = -model.gravity;
 
     typedef RneaForwardStep<Scalar,Options,JointCollectionTpl,ConfigVectorType,TangentVectorType1,TangentVectorType2> Pass1;
     typename Pass1::ArgsType arg1(model,data,q.derived(),v.derived(),a.derived());
-    for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
     {
-      Pass1::run(model.joints[i],data.joints[i],
-                 arg1);
+      PINOCCHIO_PROFILER_SCOPE("forward pass");
+      forwardPassParallel(model,JointPassFunctor<Pass1,Model,Data>(model,data,arg1),num_threads);
     }
     
     typedef RneaBackwardStep<Scalar,Options,JointCollectionTpl> Pass2;
     typename Pass2::ArgsType arg2(model,data);
-    for(JointIndex i=(JointIndex)model.njoints-1; i>0; --i)
     {
-      Pass2::run(model.joints[i],data.joints[i],
-                 arg2);
+      PINOCCHIO_PROFILER_SCOPE("backward pass");
+      backwardPassParallel(model,JointPassFunctor<Pass2,Model,Data>(model,data,arg2),num_threads);
     }
 
     return data.tau;
@@ -144,6 +160,7 @@ namespace pinocchio
     assert(q.size() == model.nq && "The configuration vector is not of right size");
     assert(v.size() == model.nv && "The velocity vector is not of right size");
     assert(a.size() == model.nv && "The acceleration vector is not of right size");
+    PINOCCHIO_PROFILER_SCOPE("rnea");
     
     typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
     typedef typename Model::JointIndex JointIndex;
@@ -152,18 +169,24 @@ namespace pinocchio
     data.a_gf[0] = -model.gravity;
     
     typedef RneaForwardStep<Scalar,Options,JointCollectionTpl,ConfigVectorType,TangentVectorType1,TangentVectorType2> Pass1;
-    for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
     {
-      Pass1::run(model.joints[i],data.joints[i],
-                 typename Pass1::ArgsType(model,data,q.derived(),v.derived(),a.derived()));
-      data.f[i] -= fext[i];
+      PINOCCHIO_PROFILER_SCOPE("forward pass");
+      for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
+      {
+        Pass1::run(model.joints[i],data.joints[i],
+                   typename Pass1::ArgsType(model,data,q.derived(),v.derived(),a.derived()));
+        data.f[i] -= fext[i];
+      }
     }
     
     typedef RneaBackwardStep<Scalar,Options,JointCollectionTpl> Pass2;
-    for(JointIndex i=(JointIndex)model.njoints-1; i>0; --i)
     {
-      Pass2::run(model.joints[i],data.joints[i],
-                 typename Pass2::ArgsType(model,data));
+      PINOCCHIO_PROFILER_SCOPE("backward pass");
+      for(JointIndex i=(JointIndex)model.njoints-1; i>0; --i)
+      {
+        Pass2::run(model.joints[i],data.joints[i],
+                   typename Pass2::ArgsType(model,data));
+      }
     }
 
     
@@ -248,6 +271,7 @@ namespace pinocchio
     assert(model.check(data) && "data is not consistent with model.");
     assert(q.size() == model.nq && "The configuration vector is not of right size");
     assert(v.size() == model.nv && "The velocity vector is not of right size");
+    PINOCCHIO_PROFILER_SCOPE("nonLinearEffects");
     
     typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
     typedef typename Model::JointIndex JointIndex;
@@ -256,17 +280,23 @@ namespace pinocchio
     data.a_gf[0] = -model.gravity;
     
     typedef NLEForwardStep<Scalar,Options,JointCollectionTpl,ConfigVectorType,TangentVectorType> Pass1;
-    for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
     {
-      Pass1::run(model.joints[i],data.joints[i],
-                 typename Pass1::ArgsType(model,data,q.derived(),v.derived()));
+      PINOCCHIO_PROFILER_SCOPE("forward pass");
+      for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
+      {
+        Pass1::run(model.joints[i],data.joints[i],
+                   typename Pass1::ArgsType(model,data,q.derived(),v.derived()));
+      }
     }
     
     typedef NLEBackwardStep<Scalar,Options,JointCollectionTpl> Pass2;
-    for(JointIndex i=(JointIndex)(model.njoints-1); i>0; --i)
     {
-      Pass2::run(model.joints[i],data.joints[i],
-                 typename Pass2::ArgsType(model,data));
+      PINOCCHIO_PROFILER_SCOPE("backward pass");
+      for(JointIndex i=(JointIndex)(model.njoints-1); i>0; --i)
+      {
+        Pass2::run(model.joints[i],data.joints[i],
+                   typename Pass2::ArgsType(model,data));
+      }
     }
     
     return data.nle;
@@ -338,6 +368,7 @@ namespace pinocchio
   {
     assert(model.check(data) && "data is not consistent with model.");
     assert(q.size() == model.nq && "The configuration vector is not of right size");
+    PINOCCHIO_PROFILER_SCOPE("computeGeneralizedGravity");
     
     typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
     typedef typename Model::JointIndex JointIndex;
@@ -345,17 +376,23 @@ namespace pinocchio
     data.a_gf[0] = -model.gravity;
     
     typedef ComputeGeneralizedGravityForwardStep<Scalar,Options,JointCollectionTpl,ConfigVectorType> Pass1;
-    for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
     {
-      Pass1::run(model.joints[i],data.joints[i],
-                 typename Pass1::ArgsType(model,data,q.derived()));
+      PINOCCHIO_PROFILER_SCOPE("forward pass");
+      for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
+      {
+        Pass1::run(model.joints[i],data.joints[i],
+                   typename Pass1::ArgsType(model,data,q.derived()));
+      }
     }
     
     typedef ComputeGeneralizedGravityBackwardStep<Scalar,Options,JointCollectionTpl> Pass2;
-    for(JointIndex i=(JointIndex)(model.njoints-1); i>0; --i)
     {
-      Pass2::run(model.joints[i],data.joints[i],
-                 typename Pass2::ArgsType(model,data));
+      PINOCCHIO_PROFILER_SCOPE("backward pass");
+      for(JointIndex i=(JointIndex)(model.njoints-1); i>0; --i)
+      {
+        Pass2::run(model.joints[i],data.joints[i],
+                   typename Pass2::ArgsType(model,data));
+      }
     }
     
     return data.g;
@@ -484,22 +521,29 @@ namespace pinocchio
     assert(model.check(data) && "data is not consistent with model.");
     assert(q.size() == model.nq);
     assert(v.size() == model.nv);
+    PINOCCHIO_PROFILER_SCOPE("computeCoriolisMatrix");
     
     typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
     typedef typename Model::JointIndex JointIndex;
     
     typedef CoriolisMatrixForwardStep<Scalar,Options,JointCollectionTpl,ConfigVectorType,TangentVectorType> Pass1;
-    for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
     {
-      Pass1::run(model.joints[i],data.joints[i],
-                 typename Pass1::ArgsType(model,data,q.derived(),v.derived()));
+      PINOCCHIO_PROFILER_SCOPE("forward pass");
+      for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
+      {
+        Pass1::run(model.joints[i],data.joints[i],
+                   typename Pass1::ArgsType(model,data,q.derived(),v.derived()));
+      }
     }
     
     typedef CoriolisMatrixBackwardStep<Scalar,Options,JointCollectionTpl> Pass2;
-    for(JointIndex i=(JointIndex)(model.njoints-1); i>0; --i)
     {
-      Pass2::run(model.joints[i],
-                 typename Pass2::ArgsType(model,data));
+      PINOCCHIO_PROFILER_SCOPE("backward pass");
+      for(JointIndex i=(JointIndex)(model.njoints-1); i>0; --i)
+      {
+        Pass2::run(model.joints[i],
+                   typename Pass2::ArgsType(model,data));
+      }
     }
     
     return data.C;
@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2018 CNRS
+//
+
+#ifndef __pinocchio_subtree_parallel_hpp__
+#define __pinocchio_subtree_parallel_hpp__
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/multibody/data.hpp"
+
+namespace pinocchio
+{
+  ///
+  /// \brief Calls f(i) on every joint i of the kinematic tree, each joint being visited after its parent.
+  ///        The independent branches of the tree are handled by different threads.
+  ///
+  /// \details The chain of joints going from the root to the first branch point is visited by a single thread,
+  ///          then the subtree of each child of the branch point is visited by its own OpenMP task, and so on
+  ///          recursively. Two joints are never visited concurrently if one is an ancestor of the other.
+  ///
+  /// \tparam JointFunctor Type of a functor with an operator()(const JointIndex) const.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] f The functor called on each joint (except the universe).
+  /// \param[in] num_threads Number of threads. It is only effective when Pinocchio is built with OpenMP support.
+  ///            With a single thread, the joints are visited in increasing order.
+  ///
+  /// \remarks With more than one thread, the subtrees of the model must hold contiguous joint indexes
+  ///          (depth-first numbering), otherwise std::invalid_argument is thrown. The parsers and addJoint
+  ///          do not guarantee this numbering: call finalizeModel on the model first.
+  ///
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename JointFunctor>
+  inline void forwardPassParallel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                  const JointFunctor & f,
+                                  const int num_threads);
+
+  ///
+  /// \brief Calls f(i) on every joint i of the kinematic tree, each joint being visited after all its descendants.
+  ///        The independent branches of the tree are handled by different threads.
+  ///
+  /// \details The subtrees of the children of a branch point are visited by different OpenMP tasks, except
+  ///          their root: once all the tasks have completed, f is called serially on the children (in decreasing
+  ///          order), then on the chain of joints leading to the branch point. Hence f(i) can safely accumulate
+  ///          quantities into the parent of i, and the accumulations are performed in the same order as in a
+  ///          serial backward pass.
+  ///
+  /// \tparam JointFunctor Type of a functor with an operator()(const JointIndex) const.
+  ///
+  /// \param[in] model The model structure of the rigid body system.
+  /// \param[in] f The functor called on each joint (except the universe).
+  /// \param[in] num_threads Number of threads. It is only effective when Pinocchio is built with OpenMP support.
+  ///            With a single thread, the joints are visited in decreasing order.
+  ///
+  /// \remarks With more than one thread, the subtrees of the model must hold contiguous joint indexes
+  ///          (depth-first numbering), otherwise std::invalid_argument is thrown. The parsers and addJoint
+  ///          do not guarantee this numbering: call finalizeModel on the model first.
+  ///
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename JointFunctor>
+  inline void backwardPassParallel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                   const JointFunctor & f,
+                                   const int num_threads);
+
+  ///
+  /// \brief Functor applying the joint visitor Pass on a given joint, to be used with forwardPassParallel
+  ///        and backwardPassParallel.
+  ///
+  /// \tparam Pass A visitor deriving from fusion::JointVisitorBase.
+  /// \tparam WithJointData Whether the algo of Pass takes the joint data as argument.
+  ///
+  template<typename Pass, typename Model, typename Data, bool WithJointData = true>
+  struct JointPassFunctor
+  {
+    typedef typename Model::JointIndex JointIndex;
+
+    JointPassFunctor(const Model & model, Data & data, const typename Pass::ArgsType & args)
+    : model(model), data(data), args(args)
+    {}
+
+    void operator()(const JointIndex i) const
+    { Pass::run(model.joints[i],data.joints[i],args); }
+
+    const Model & model;
+    Data & data;
+    const typename Pass::ArgsType & args;
+  };
+
+  template<typename Pass, typename Model, typename Data>
+  struct JointPassFunctor<Pass,Model,Data,false>
+  {
+    typedef typename Model::JointIndex JointIndex;
+
+    JointPassFunctor(const Model & model, Data & /*data*/, const typename Pass::ArgsType & args)
+    : model(model), args(args)
+    {}
+
+    void operator()(const JointIndex i) const
+    { Pass::run(model.joints[i],args); }
+
+    const Model & model;
+    const typename Pass::ArgsType & args;
+  };
+
+} // namespace pinocchio
+
+/* --- Details -------------------------------------------------------------------- */
+#include "pinocchio/algorithm/subtree-parallel.hxx"
+
+#endif // ifndef __pinocchio_subtree_parallel_hpp__
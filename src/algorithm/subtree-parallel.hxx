@@ -0,0 +1,224 @@
+//
+// Copyright (c) 2018 CNRS
+//
+
+#ifndef __pinocchio_subtree_parallel_hxx__
+#define __pinocchio_subtree_parallel_hxx__
+
+#include <stdexcept>
+
+/// @cond DEV
+
+namespace pinocchio
+{
+  namespace details
+  {
+    /// \brief Throws if the subtree of some joint does not hold contiguous joint indexes.
+    template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+    inline void checkDepthFirstNumbering(const ModelTpl<Scalar,Options,JointCollectionTpl> & model)
+    {
+      typedef typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex JointIndex;
+      for(JointIndex i = 1; i < (JointIndex)model.njoints; ++i)
+      {
+        if(model.subtrees[i].back() != i + model.subtrees[i].size() - 1)
+          throw std::invalid_argument("The joints of the model are not numbered in depth-first order. "
+                                      "Call finalizeModel before running a parallel pass.");
+      }
+    }
+
+    /// \brief Index following the last joint of the subtree of i (depth-first numbering only).
+    template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+    inline typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex
+    subtreeEnd(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+               const typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex i)
+    {
+      typedef typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex JointIndex;
+      const JointIndex end = i + (JointIndex)model.subtrees[i].size();
+      assert(model.subtrees[i].back() == end-1 && "The model is not numbered in depth-first order.");
+      return end;
+    }
+
+    template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename JointFunctor>
+    inline void forwardChildrenParallel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                        const JointFunctor & f,
+                                        const typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex first,
+                                        const typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex end);
+
+    /// \brief Visits the subtree of i, following the chain of single children until a branch point.
+    template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename JointFunctor>
+    inline void forwardSubtreeParallel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                       const JointFunctor & f,
+                                       typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex i)
+    {
+      typedef typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex JointIndex;
+
+      const JointIndex end = subtreeEnd(model,i);
+      for(;;)
+      {
+        f(i);
+        const JointIndex child = i+1;
+        if(child == end) return; // leaf
+        if(subtreeEnd(model,child) != end) break; // branch point
+        i = child;
+      }
+      forwardChildrenParallel(model,f,i+1,end);
+    }
+
+    /// \brief Visits the subtrees of the children in [first,end), one task per child except the last one.
+    template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename JointFunctor>
+    inline void forwardChildrenParallel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                        const JointFunctor & f,
+                                        const typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex first,
+                                        const typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex end)
+    {
+      typedef typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex JointIndex;
+
+      for(JointIndex child = first; child < end; )
+      {
+        const JointIndex next = subtreeEnd(model,child);
+        if(next == end)
+        {
+          forwardSubtreeParallel(model,f,child);
+          break;
+        }
+#ifdef PINOCCHIO_WITH_OPENMP
+        #pragma omp task firstprivate(child) shared(model,f)
+#endif
+        forwardSubtreeParallel(model,f,child);
+        child = next;
+      }
+    }
+
+    template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename JointFunctor>
+    inline void backwardChildrenParallel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                         const JointFunctor & f,
+                                         const typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex first,
+                                         const typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex end);
+
+    /// \brief Visits the subtree of i in reverse order, its root only if with_root is true.
+    template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename JointFunctor>
+    inline void backwardSubtreeParallel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                        const JointFunctor & f,
+                                        const typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex i,
+                                        const bool with_root)
+    {
+      typedef typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex JointIndex;
+
+      const JointIndex end = subtreeEnd(model,i);
+      JointIndex tip = i;
+      while(tip+1 < end && subtreeEnd(model,tip+1) == end)
+        ++tip;
+
+      if(tip+1 < end)
+        backwardChildrenParallel(model,f,tip+1,end);
+
+      for(JointIndex j = tip; j > i; --j)
+        f(j);
+      if(with_root)
+        f(i);
+    }
+
+    /// \brief Calls f on the roots of the children subtrees in [child,end), in decreasing order.
+    template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename JointFunctor>
+    inline void backwardChildrenRoots(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                      const JointFunctor & f,
+                                      const typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex child,
+                                      const typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex end)
+    {
+      const typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex next = subtreeEnd(model,child);
+      if(next < end)
+        backwardChildrenRoots(model,f,next,end);
+      f(child);
+    }
+
+    /// \brief Visits the subtrees of the children in [first,end) without their roots in parallel, then their
+    ///        roots serially.
+    template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename JointFunctor>
+    inline void backwardChildrenParallel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                         const JointFunctor & f,
+                                         const typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex first,
+                                         const typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex end)
+    {
+      typedef typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex JointIndex;
+
+      for(JointIndex child = first; child < end; )
+      {
+        const JointIndex next = subtreeEnd(model,child);
+        if(next == end)
+        {
+          backwardSubtreeParallel(model,f,child,false);
+          break;
+        }
+#ifdef PINOCCHIO_WITH_OPENMP
+        #pragma omp task firstprivate(child) shared(model,f)
+#endif
+        backwardSubtreeParallel(model,f,child,false);
+        child = next;
+      }
+#ifdef PINOCCHIO_WITH_OPENMP
+      #pragma omp taskwait
+#endif
+
+      // The roots write into their common parent.
+      backwardChildrenRoots(model,f,first,end);
+    }
+
+  } // namespace details
+
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename JointFunctor>
+  inline void forwardPassParallel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                  const JointFunctor & f,
+                                  const int num_threads)
+  {
+    typedef typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex JointIndex;
+    const JointIndex njoints = (JointIndex)model.njoints;
+    if(num_threads > 1)
+      details::checkDepthFirstNumbering(model);
+
+#ifdef PINOCCHIO_WITH_OPENMP
+    if(num_threads > 1 && njoints > 1)
+    {
+      #pragma omp parallel num_threads(num_threads)
+      #pragma omp single
+      details::forwardChildrenParallel(model,f,1,njoints);
+      return;
+    }
+#else
+    PINOCCHIO_UNUSED_VARIABLE(num_threads);
+#endif
+
+    for(JointIndex i=1; i<njoints; ++i)
+      f(i);
+  }
+
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl, typename JointFunctor>
+  inline void backwardPassParallel(const ModelTpl<Scalar,Options,JointCollectionTpl> & model,
+                                   const JointFunctor & f,
+                                   const int num_threads)
+  {
+    typedef typename ModelTpl<Scalar,Options,JointCollectionTpl>::JointIndex JointIndex;
+    const JointIndex njoints = (JointIndex)model.njoints;
+    if(num_threads > 1)
+      details::checkDepthFirstNumbering(model);
+
+#ifdef PINOCCHIO_WITH_OPENMP
+    if(num_threads > 1 && njoints > 1)
+    {
+      #pragma omp parallel num_threads(num_threads)
+      #pragma omp single
+      details::backwardChildrenParallel(model,f,1,njoints);
+      return;
+    }
+#else
+    PINOCCHIO_UNUSED_VARIABLE(num_threads);
+#endif
+
+    for(JointIndex i=njoints-1; i>0; --i)
+      f(i);
+  }
+
+} // namespace pinocchio
+
+/// @endcond
+
+#endif // ifndef __pinocchio_subtree_parallel_hxx__
@@ -13,6 +13,11 @@
 #include "pinocchio/algorithm/aba.hpp"
 #include "pinocchio/algorithm/rnea-derivatives.hpp"
 #include "pinocchio/algorithm/aba-derivatives.hpp"
+#include "pinocchio/algorithm/frames.hpp"
+#include "pinocchio/algorithm/jacobian.hpp"
+#include "pinocchio/algorithm/center-of-mass.hpp"
+#include "pinocchio/algorithm/centroidal.hpp"
+#include "pinocchio/algorithm/centroidal-derivatives.hpp"
 
 namespace pinocchio
 {
@@ -27,6 +32,7 @@ namespace pinocchio
     typedef typename Base::ADTangentVectorType ADTangentVectorType;
     typedef typename Base::MatrixXs MatrixXs;
     typedef typename Base::VectorXs VectorXs;
+    typedef typename Base::BoolMatrixXs BoolMatrixXs;
     
     CodeGenRNEA(const Model & model,
                 const std::string & function_name = "rnea",
@@ -96,8 +102,98 @@ namespace pinocchio
       dtau_da = Base::jac.middleCols(it,ad_model.nv); it += ad_model.nv;
     }
     
+    using Base::evalHessian;
+    ///
+    /// \brief Evaluates the second order derivatives of RNEA, i.e. the Hessian (dim (model.nq+2*model.nv)^2) of the weighted sum
+    ///        \f$ \sum_{i} \lambda_{i} f_{i}(q,v,a) \f$ with respect to the stacked input (q,v,a).
+    ///        The result is stored in hess. It requires setBuildHessian(true) to be called before initLib.
+    ///
+    template<typename ConfigVectorType, typename TangentVector1, typename TangentVector2, typename WeightVector>
+    void evalHessian(const Eigen::MatrixBase<ConfigVectorType> & q,
+                     const Eigen::MatrixBase<TangentVector1> & v,
+                     const Eigen::MatrixBase<TangentVector2> & a,
+                     const Eigen::MatrixBase<WeightVector> & lambda)
+    {
+      // fill x
+      Eigen::DenseIndex it = 0;
+      x.segment(it,ad_model.nq) = q; it += ad_model.nq;
+      x.segment(it,ad_model.nv) = v; it += ad_model.nv;
+      x.segment(it,ad_model.nv) = a; it += ad_model.nv;
+      
+      evalHessian(x,lambda);
+    }
+    
+    using Base::evalSparseJacobian;
+    ///
+    /// \brief Evaluates the non-zero values of the sparse Jacobian of RNEA into jac_values.
+    ///        It requires setBuildSparseJacobian(true) to be called before initLib.
+    ///
+    template<typename ConfigVectorType, typename TangentVector1, typename TangentVector2>
+    void evalSparseJacobian(const Eigen::MatrixBase<ConfigVectorType> & q,
+                            const Eigen::MatrixBase<TangentVector1> & v,
+                            const Eigen::MatrixBase<TangentVector2> & a)
+    {
+      // fill x
+      Eigen::DenseIndex it = 0;
+      x.segment(it,ad_model.nq) = q; it += ad_model.nq;
+      x.segment(it,ad_model.nv) = v; it += ad_model.nv;
+      x.segment(it,ad_model.nv) = a; it += ad_model.nv;
+      
+      evalSparseJacobian(x);
+    }
+    
+    using Base::evalSparseHessian;
+    ///
+    /// \brief Evaluates the non-zero values of the lower triangular part of the sparse second order derivatives of RNEA,
+    ///        weighted by lambda, into hess_values. It requires setBuildSparseHessian(true) to be called before initLib.
+    ///
+    template<typename ConfigVectorType, typename TangentVector1, typename TangentVector2, typename WeightVector>
+    void evalSparseHessian(const Eigen::MatrixBase<ConfigVectorType> & q,
+                           const Eigen::MatrixBase<TangentVector1> & v,
+                           const Eigen::MatrixBase<TangentVector2> & a,
+                           const Eigen::MatrixBase<WeightVector> & lambda)
+    {
+      // fill x
+      Eigen::DenseIndex it = 0;
+      x.segment(it,ad_model.nq) = q; it += ad_model.nq;
+      x.segment(it,ad_model.nv) = v; it += ad_model.nv;
+      x.segment(it,ad_model.nv) = a; it += ad_model.nv;
+      
+      evalSparseHessian(x,lambda);
+    }
+    
+    /// \brief Joint torques computed by evalFunction.
+    VectorXs res;
+    /// \brief Dense derivatives of the joint torques with respect to (q,v,a), computed by evalJacobian.
+    MatrixXs dtau_dq, dtau_dv, dtau_da;
+    
   protected:
     
+    /// \brief The joint torque of a given dof only depends on the joints supporting it or supported by it.
+    BoolMatrixXs jacobianSparsityPattern() const
+    {
+      const Eigen::DenseIndex nq = ad_model.nq, nv = ad_model.nv;
+      BoolMatrixXs pattern(BoolMatrixXs::Constant(nv,nq+2*nv,false));
+      Base::fillSparsityBlock(pattern,Base::joint_support,0,false,0,true);
+      Base::fillSparsityBlock(pattern,Base::joint_support,0,false,nq,false);
+      Base::fillSparsityBlock(pattern,Base::joint_support,0,false,nq+nv,false);
+      return pattern;
+    }
+    
+    /// \brief Same coupling as the Jacobian, except the (v,a) and (a,a) blocks which are zero as RNEA is affine in a.
+    BoolMatrixXs hessianSparsityPattern() const
+    {
+      const Eigen::DenseIndex nq = ad_model.nq, nv = ad_model.nv;
+      BoolMatrixXs pattern(BoolMatrixXs::Constant(nq+2*nv,nq+2*nv,false));
+      Base::fillSparsityBlock(pattern,Base::joint_support,0,true,0,true);
+      Base::fillSparsityBlock(pattern,Base::joint_support,0,true,nq,false);
+      Base::fillSparsityBlock(pattern,Base::joint_support,nq,false,0,true);
+      Base::fillSparsityBlock(pattern,Base::joint_support,nq,false,nq,false);
+      Base::fillSparsityBlock(pattern,Base::joint_support,0,true,nq+nv,false);
+      Base::fillSparsityBlock(pattern,Base::joint_support,nq+nv,false,0,true);
+      return pattern;
+    }
+    
     using Base::ad_model;
     using Base::ad_data;
     using Base::ad_fun;
@@ -107,8 +203,6 @@ namespace pinocchio
     using Base::jac;
     
     VectorXs x;
-    VectorXs res;
-    MatrixXs dtau_dq, dtau_dv, dtau_da;
     
     ADCongigVectorType ad_q, ad_q_plus;
     ADTangentVectorType ad_dq, ad_v, ad_a;
@@ -125,6 +219,7 @@ namespace pinocchio
     typedef typename Base::ADTangentVectorType ADTangentVectorType;
     typedef typename Base::MatrixXs MatrixXs;
     typedef typename Base::VectorXs VectorXs;
+    typedef typename Base::BoolMatrixXs BoolMatrixXs;
     
     CodeGenABA(const Model & model,
                const std::string & function_name = "aba",
@@ -194,8 +289,98 @@ namespace pinocchio
       da_dtau = Base::jac.middleCols(it,ad_model.nv); it += ad_model.nv;
     }
     
+    using Base::evalHessian;
+    ///
+    /// \brief Evaluates the second order derivatives of ABA, i.e. the Hessian (dim (model.nq+2*model.nv)^2) of the weighted sum
+    ///        \f$ \sum_{i} \lambda_{i} f_{i}(q,v,tau) \f$ with respect to the stacked input (q,v,tau).
+    ///        The result is stored in hess. It requires setBuildHessian(true) to be called before initLib.
+    ///
+    template<typename ConfigVectorType, typename TangentVector1, typename TangentVector2, typename WeightVector>
+    void evalHessian(const Eigen::MatrixBase<ConfigVectorType> & q,
+                     const Eigen::MatrixBase<TangentVector1> & v,
+                     const Eigen::MatrixBase<TangentVector2> & tau,
+                     const Eigen::MatrixBase<WeightVector> & lambda)
+    {
+      // fill x
+      Eigen::DenseIndex it = 0;
+      x.segment(it,ad_model.nq) = q; it += ad_model.nq;
+      x.segment(it,ad_model.nv) = v; it += ad_model.nv;
+      x.segment(it,ad_model.nv) = tau; it += ad_model.nv;
+      
+      evalHessian(x,lambda);
+    }
+    
+    using Base::evalSparseJacobian;
+    ///
+    /// \brief Evaluates the non-zero values of the sparse Jacobian of ABA into jac_values.
+    ///        It requires setBuildSparseJacobian(true) to be called before initLib.
+    ///
+    template<typename ConfigVectorType, typename TangentVector1, typename TangentVector2>
+    void evalSparseJacobian(const Eigen::MatrixBase<ConfigVectorType> & q,
+                            const Eigen::MatrixBase<TangentVector1> & v,
+                            const Eigen::MatrixBase<TangentVector2> & tau)
+    {
+      // fill x
+      Eigen::DenseIndex it = 0;
+      x.segment(it,ad_model.nq) = q; it += ad_model.nq;
+      x.segment(it,ad_model.nv) = v; it += ad_model.nv;
+      x.segment(it,ad_model.nv) = tau; it += ad_model.nv;
+      
+      evalSparseJacobian(x);
+    }
+    
+    using Base::evalSparseHessian;
+    ///
+    /// \brief Evaluates the non-zero values of the lower triangular part of the sparse second order derivatives of ABA,
+    ///        weighted by lambda, into hess_values. It requires setBuildSparseHessian(true) to be called before initLib.
+    ///
+    template<typename ConfigVectorType, typename TangentVector1, typename TangentVector2, typename WeightVector>
+    void evalSparseHessian(const Eigen::MatrixBase<ConfigVectorType> & q,
+                           const Eigen::MatrixBase<TangentVector1> & v,
+                           const Eigen::MatrixBase<TangentVector2> & tau,
+                           const Eigen::MatrixBase<WeightVector> & lambda)
+    {
+      // fill x
+      Eigen::DenseIndex it = 0;
+      x.segment(it,ad_model.nq) = q; it += ad_model.nq;
+      x.segment(it,ad_model.nv) = v; it += ad_model.nv;
+      x.segment(it,ad_model.nv) = tau; it += ad_model.nv;
+      
+      evalSparseHessian(x,lambda);
+    }
+    
+    /// \brief Joint accelerations computed by evalFunction.
+    VectorXs res;
+    /// \brief Dense derivatives of the joint accelerations with respect to (q,v,tau), computed by evalJacobian.
+    MatrixXs da_dq,da_dv,da_dtau;
+    
   protected:
     
+    /// \brief The joint acceleration of a given dof only depends on the joints belonging to the same subtree attached to the universe.
+    BoolMatrixXs jacobianSparsityPattern() const
+    {
+      const Eigen::DenseIndex nq = ad_model.nq, nv = ad_model.nv;
+      BoolMatrixXs pattern(BoolMatrixXs::Constant(nv,nq+2*nv,false));
+      Base::fillSparsityBlock(pattern,Base::joint_tree,0,false,0,true);
+      Base::fillSparsityBlock(pattern,Base::joint_tree,0,false,nq,false);
+      Base::fillSparsityBlock(pattern,Base::joint_tree,0,false,nq+nv,false);
+      return pattern;
+    }
+    
+    /// \brief Same coupling as the Jacobian, except the (v,tau) and (tau,tau) blocks which are zero as ABA is affine in tau.
+    BoolMatrixXs hessianSparsityPattern() const
+    {
+      const Eigen::DenseIndex nq = ad_model.nq, nv = ad_model.nv;
+      BoolMatrixXs pattern(BoolMatrixXs::Constant(nq+2*nv,nq+2*nv,false));
+      Base::fillSparsityBlock(pattern,Base::joint_tree,0,true,0,true);
+      Base::fillSparsityBlock(pattern,Base::joint_tree,0,true,nq,false);
+      Base::fillSparsityBlock(pattern,Base::joint_tree,nq,false,0,true);
+      Base::fillSparsityBlock(pattern,Base::joint_tree,nq,false,nq,false);
+      Base::fillSparsityBlock(pattern,Base::joint_tree,0,true,nq+nv,false);
+      Base::fillSparsityBlock(pattern,Base::joint_tree,nq+nv,false,0,true);
+      return pattern;
+    }
+    
     using Base::ad_model;
     using Base::ad_data;
     using Base::ad_fun;
@@ -205,8 +390,6 @@ namespace pinocchio
     using Base::jac;
     
     VectorXs x;
-    VectorXs res;
-    MatrixXs da_dq,da_dv,da_dtau;
     
     ADCongigVectorType ad_q, ad_q_plus;
     ADTangentVectorType ad_dq, ad_v, ad_tau;
@@ -603,6 +786,707 @@ namespace pinocchio
     ADTangentVectorType ad_v, ad_tau;
   };
   
+  template<typename _Scalar>
+  struct CodeGenFramesForwardKinematics : public CodeGenBase<_Scalar>
+  {
+    typedef CodeGenBase<_Scalar> Base;
+    typedef typename Base::Scalar Scalar;
+    
+    typedef typename Base::Model Model;
+    typedef typename Base::Data Data;
+    typedef typename Base::ADCongigVectorType ADCongigVectorType;
+    typedef typename Base::ADTangentVectorType ADTangentVectorType;
+    typedef typename Base::MatrixXs MatrixXs;
+    typedef typename Base::VectorXs VectorXs;
+    
+    typedef typename Model::FrameIndex FrameIndex;
+    typedef std::vector<FrameIndex> FrameIndexVector;
+    typedef typename Data::SE3 SE3;
+    typedef typename SE3::Matrix3 Matrix3;
+    typedef typename Base::ADData::SE3::Matrix3 ADMatrix3;
+    
+    ///
+    /// \brief Generates the placements of a given set of frames.
+    ///        The output of the generated function stacks, for each frame, its translation (dim 3) followed by its rotation matrix (dim 9, column major).
+    ///
+    CodeGenFramesForwardKinematics(const Model & model,
+                                   const FrameIndexVector & frame_ids,
+                                   const std::string & function_name = "frames_fk",
+                                   const std::string & library_name = "cg_frames_fk_eval")
+    : Base(model,model.nq,12*(Eigen::DenseIndex)frame_ids.size(),function_name,library_name)
+    , frame_ids(frame_ids)
+    {
+      ad_q = ADCongigVectorType(model.nq); ad_q = ad_model.neutralConfiguration;
+      x = VectorXs::Zero(Base::getInputDimension());
+      
+      oMf.resize(frame_ids.size(),SE3::Identity());
+    }
+    
+    void buildMap()
+    {
+      CppAD::Independent(ad_X);
+      
+      Eigen::DenseIndex it = 0;
+      ad_q = ad_X.segment(it,ad_model.nq); it += ad_model.nq;
+      
+      pinocchio::framesForwardKinematics(ad_model,ad_data,ad_q);
+      
+      Eigen::DenseIndex it_Y = 0;
+      for(size_t k = 0; k < frame_ids.size(); ++k)
+      {
+        const typename Base::ADData::SE3 & ad_oMf = ad_data.oMf[frame_ids[k]];
+        ad_Y.segment(it_Y,3) = ad_oMf.translation(); it_Y += 3;
+        Eigen::Map<ADMatrix3>(ad_Y.data()+it_Y) = ad_oMf.rotation(); it_Y += 9;
+      }
+      
+      assert(it_Y == Base::getOutputDimension());
+      
+      ad_fun.Dependent(ad_X,ad_Y);
+      ad_fun.optimize("no_compare_op");
+    }
+    
+    template<typename ConfigVectorType>
+    void evalFunction(const Eigen::MatrixBase<ConfigVectorType> & q)
+    {
+      // fill x
+      Eigen::DenseIndex it = 0;
+      x.segment(it,ad_model.nq) = q; it += ad_model.nq;
+      
+      Base::evalFunction(x);
+      
+      // fill oMf
+      Eigen::DenseIndex it_y = 0;
+      for(size_t k = 0; k < frame_ids.size(); ++k)
+      {
+        oMf[k].translation() = Base::y.segment(it_y,3); it_y += 3;
+        oMf[k].rotation() = Eigen::Map<const Matrix3>(Base::y.data()+it_y); it_y += 9;
+      }
+    }
+    
+    /// \brief Placements of the frames of interest, in the order given by frame_ids.
+    container::aligned_vector<SE3> oMf;
+    
+  protected:
+    
+    using Base::ad_model;
+    using Base::ad_data;
+    using Base::ad_fun;
+    using Base::ad_X;
+    using Base::ad_Y;
+    using Base::y;
+    
+    const FrameIndexVector frame_ids;
+    
+    VectorXs x;
+    
+    ADCongigVectorType ad_q;
+  };
+  
+  template<typename _Scalar>
+  struct CodeGenFrameJacobians : public CodeGenBase<_Scalar>
+  {
+    typedef CodeGenBase<_Scalar> Base;
+    typedef typename Base::Scalar Scalar;
+    
+    typedef typename Base::Model Model;
+    typedef typename Base::Data Data;
+    typedef typename Base::ADCongigVectorType ADCongigVectorType;
+    typedef typename Base::ADTangentVectorType ADTangentVectorType;
+    typedef typename Base::MatrixXs MatrixXs;
+    typedef typename Base::VectorXs VectorXs;
+    
+    typedef typename Model::FrameIndex FrameIndex;
+    typedef std::vector<FrameIndex> FrameIndexVector;
+    typedef typename Data::Matrix6x Matrix6x;
+    typedef typename EIGEN_PLAIN_ROW_MAJOR_TYPE(Matrix6x) RowMatrix6x;
+    
+    typedef typename Base::ADData ADData;
+    typedef typename ADData::Matrix6x ADMatrix6x;
+    typedef typename EIGEN_PLAIN_ROW_MAJOR_TYPE(ADMatrix6x) RowADMatrix6x;
+    
+    ///
+    /// \brief Generates the Jacobians of a given set of frames, expressed in the reference frame rf.
+    ///        The output of the generated function stacks the row major 6 x model.nv Jacobians of each frame.
+    ///
+    CodeGenFrameJacobians(const Model & model,
+                          const FrameIndexVector & frame_ids,
+                          const ReferenceFrame rf = LOCAL,
+                          const std::string & function_name = "frame_jacobians",
+                          const std::string & library_name = "cg_frame_jacobians_eval")
+    : Base(model,model.nq,6*model.nv*(Eigen::DenseIndex)frame_ids.size(),function_name,library_name)
+    , frame_ids(frame_ids)
+    , rf(rf)
+    {
+      ad_q = ADCongigVectorType(model.nq); ad_q = ad_model.neutralConfiguration;
+      ad_J = ADMatrix6x::Zero(6,model.nv);
+      x = VectorXs::Zero(Base::getInputDimension());
+      
+      J.resize(frame_ids.size(),Matrix6x::Zero(6,model.nv));
+      
+      Base::build_jacobian = false;
+    }
+    
+    void buildMap()
+    {
+      CppAD::Independent(ad_X);
+      
+      Eigen::DenseIndex it = 0;
+      ad_q = ad_X.segment(it,ad_model.nq); it += ad_model.nq;
+      
+      pinocchio::computeJointJacobians(ad_model,ad_data,ad_q);
+      pinocchio::updateFramePlacements(ad_model,ad_data);
+      
+      Eigen::DenseIndex it_Y = 0;
+      for(size_t k = 0; k < frame_ids.size(); ++k)
+      {
+        ad_J.setZero();
+        pinocchio::getFrameJacobian(ad_model,ad_data,frame_ids[k],rf,ad_J);
+        Eigen::Map<RowADMatrix6x>(ad_Y.data()+it_Y,6,ad_model.nv) = ad_J;
+        it_Y += 6*ad_model.nv;
+      }
+      
+      assert(it_Y == Base::getOutputDimension());
+      
+      ad_fun.Dependent(ad_X,ad_Y);
+      ad_fun.optimize("no_compare_op");
+    }
+    
+    template<typename ConfigVectorType>
+    void evalFunction(const Eigen::MatrixBase<ConfigVectorType> & q)
+    {
+      // fill x
+      Eigen::DenseIndex it = 0;
+      x.segment(it,ad_model.nq) = q; it += ad_model.nq;
+      
+      Base::evalFunction(x);
+      
+      // fill J
+      Eigen::DenseIndex it_y = 0;
+      for(size_t k = 0; k < frame_ids.size(); ++k)
+      {
+        J[k] = Eigen::Map<RowMatrix6x>(Base::y.data()+it_y,6,ad_model.nv);
+        it_y += 6*ad_model.nv;
+      }
+    }
+    
+    /// \brief Jacobians of the frames of interest, in the order given by frame_ids.
+    container::aligned_vector<Matrix6x> J;
+    
+  protected:
+    
+    using Base::ad_model;
+    using Base::ad_data;
+    using Base::ad_fun;
+    using Base::ad_X;
+    using Base::ad_Y;
+    using Base::y;
+    
+    const FrameIndexVector frame_ids;
+    const ReferenceFrame rf;
+    
+    VectorXs x;
+    ADMatrix6x ad_J;
+    
+    ADCongigVectorType ad_q;
+  };
+  
+  template<typename _Scalar>
+  struct CodeGenFrameJacobiansTimeVariation : public CodeGenBase<_Scalar>
+  {
+    typedef CodeGenBase<_Scalar> Base;
+    typedef typename Base::Scalar Scalar;
+    
+    typedef typename Base::Model Model;
+    typedef typename Base::Data Data;
+    typedef typename Base::ADCongigVectorType ADCongigVectorType;
+    typedef typename Base::ADTangentVectorType ADTangentVectorType;
+    typedef typename Base::MatrixXs MatrixXs;
+    typedef typename Base::VectorXs VectorXs;
+    
+    typedef typename Model::FrameIndex FrameIndex;
+    typedef std::vector<FrameIndex> FrameIndexVector;
+    typedef typename Data::Matrix6x Matrix6x;
+    typedef typename EIGEN_PLAIN_ROW_MAJOR_TYPE(Matrix6x) RowMatrix6x;
+    
+    typedef typename Base::ADData ADData;
+    typedef typename ADData::Matrix6x ADMatrix6x;
+    typedef typename EIGEN_PLAIN_ROW_MAJOR_TYPE(ADMatrix6x) RowADMatrix6x;
+    
+    ///
+    /// \brief Generates the Jacobian time variations of a given set of frames, expressed in the reference frame rf.
+    ///        The output of the generated function stacks the row major 6 x model.nv Jacobian time variations of each frame.
+    ///
+    CodeGenFrameJacobiansTimeVariation(const Model & model,
+                                       const FrameIndexVector & frame_ids,
+                                       const ReferenceFrame rf = LOCAL,
+                                       const std::string & function_name = "frame_jacobians_time_variation",
+                                       const std::string & library_name = "cg_frame_jacobians_time_variation_eval")
+    : Base(model,model.nq+model.nv,6*model.nv*(Eigen::DenseIndex)frame_ids.size(),function_name,library_name)
+    , frame_ids(frame_ids)
+    , rf(rf)
+    {
+      ad_q = ADCongigVectorType(model.nq); ad_q = ad_model.neutralConfiguration;
+      ad_v = ADTangentVectorType(model.nv); ad_v.setZero();
+      ad_dJ = ADMatrix6x::Zero(6,model.nv);
+      x = VectorXs::Zero(Base::getInputDimension());
+      
+      dJ.resize(frame_ids.size(),Matrix6x::Zero(6,model.nv));
+      
+      Base::build_jacobian = false;
+    }
+    
+    void buildMap()
+    {
+      CppAD::Independent(ad_X);
+      
+      Eigen::DenseIndex it = 0;
+      ad_q = ad_X.segment(it,ad_model.nq); it += ad_model.nq;
+      ad_v = ad_X.segment(it,ad_model.nv); it += ad_model.nv;
+      
+      pinocchio::computeJointJacobiansTimeVariation(ad_model,ad_data,ad_q,ad_v);
+      pinocchio::updateFramePlacements(ad_model,ad_data);
+      
+      Eigen::DenseIndex it_Y = 0;
+      for(size_t k = 0; k < frame_ids.size(); ++k)
+      {
+        ad_dJ.setZero();
+        pinocchio::getFrameJacobianTimeVariation(ad_model,ad_data,frame_ids[k],rf,ad_dJ);
+        Eigen::Map<RowADMatrix6x>(ad_Y.data()+it_Y,6,ad_model.nv) = ad_dJ;
+        it_Y += 6*ad_model.nv;
+      }
+      
+      assert(it_Y == Base::getOutputDimension());
+      
+      ad_fun.Dependent(ad_X,ad_Y);
+      ad_fun.optimize("no_compare_op");
+    }
+    
+    template<typename ConfigVectorType, typename TangentVector>
+    void evalFunction(const Eigen::MatrixBase<ConfigVectorType> & q,
+                      const Eigen::MatrixBase<TangentVector> & v)
+    {
+      // fill x
+      Eigen::DenseIndex it = 0;
+      x.segment(it,ad_model.nq) = q; it += ad_model.nq;
+      x.segment(it,ad_model.nv) = v; it += ad_model.nv;
+      
+      Base::evalFunction(x);
+      
+      // fill dJ
+      Eigen::DenseIndex it_y = 0;
+      for(size_t k = 0; k < frame_ids.size(); ++k)
+      {
+        dJ[k] = Eigen::Map<RowMatrix6x>(Base::y.data()+it_y,6,ad_model.nv);
+        it_y += 6*ad_model.nv;
+      }
+    }
+    
+    /// \brief Jacobian time variations of the frames of interest, in the order given by frame_ids.
+    container::aligned_vector<Matrix6x> dJ;
+    
+  protected:
+    
+    using Base::ad_model;
+    using Base::ad_data;
+    using Base::ad_fun;
+    using Base::ad_X;
+    using Base::ad_Y;
+    using Base::y;
+    
+    const FrameIndexVector frame_ids;
+    const ReferenceFrame rf;
+    
+    VectorXs x;
+    ADMatrix6x ad_dJ;
+    
+    ADCongigVectorType ad_q;
+    ADTangentVectorType ad_v;
+  };
+  
+  template<typename _Scalar>
+  struct CodeGenCCRBA : public CodeGenBase<_Scalar>
+  {
+    typedef CodeGenBase<_Scalar> Base;
+    typedef typename Base::Scalar Scalar;
+    
+    typedef typename Base::Model Model;
+    typedef typename Base::Data Data;
+    typedef typename Base::ADCongigVectorType ADCongigVectorType;
+    typedef typename Base::ADTangentVectorType ADTangentVectorType;
+    typedef typename Base::MatrixXs MatrixXs;
+    typedef typename Base::VectorXs VectorXs;
+    
+    typedef typename Data::Matrix6x Matrix6x;
+    typedef typename EIGEN_PLAIN_ROW_MAJOR_TYPE(Matrix6x) RowMatrix6x;
+    
+    typedef typename Base::ADData ADData;
+    typedef typename ADData::Matrix6x ADMatrix6x;
+    typedef typename EIGEN_PLAIN_ROW_MAJOR_TYPE(ADMatrix6x) RowADMatrix6x;
+    
+    CodeGenCCRBA(const Model & model,
+                 const std::string & function_name = "ccrba",
+                 const std::string & library_name = "cg_ccrba_eval")
+    : Base(model,model.nq+model.nv,6*model.nv,function_name,library_name)
+    {
+      ad_q = ADCongigVectorType(model.nq); ad_q = ad_model.neutralConfiguration;
+      ad_v = ADTangentVectorType(model.nv); ad_v.setZero();
+      x = VectorXs::Zero(Base::getInputDimension());
+      
+      Ag = Matrix6x::Zero(6,model.nv);
+      
+      Base::build_jacobian = false;
+    }
+    
+    void buildMap()
+    {
+      CppAD::Independent(ad_X);
+      
+      Eigen::DenseIndex it = 0;
+      ad_q = ad_X.segment(it,ad_model.nq); it += ad_model.nq;
+      ad_v = ad_X.segment(it,ad_model.nv); it += ad_model.nv;
+      
+      pinocchio::ccrba(ad_model,ad_data,ad_q,ad_v);
+      
+      Eigen::Map<RowADMatrix6x>(ad_Y.data(),6,ad_model.nv) = ad_data.Ag;
+      
+      ad_fun.Dependent(ad_X,ad_Y);
+      ad_fun.optimize("no_compare_op");
+    }
+    
+    template<typename ConfigVectorType, typename TangentVector>
+    void evalFunction(const Eigen::MatrixBase<ConfigVectorType> & q,
+                      const Eigen::MatrixBase<TangentVector> & v)
+    {
+      // fill x
+      Eigen::DenseIndex it = 0;
+      x.segment(it,ad_model.nq) = q; it += ad_model.nq;
+      x.segment(it,ad_model.nv) = v; it += ad_model.nv;
+      
+      Base::evalFunction(x);
+      
+      // fill Ag
+      Ag = Eigen::Map<RowMatrix6x>(Base::y.data(),6,ad_model.nv);
+    }
+    
+    /// \brief Centroidal Momentum Matrix.
+    Matrix6x Ag;
+    
+  protected:
+    
+    using Base::ad_model;
+    using Base::ad_data;
+    using Base::ad_fun;
+    using Base::ad_X;
+    using Base::ad_Y;
+    using Base::y;
+    
+    VectorXs x;
+    
+    ADCongigVectorType ad_q;
+    ADTangentVectorType ad_v;
+  };
+  
+  template<typename _Scalar>
+  struct CodeGenDCCRBA : public CodeGenBase<_Scalar>
+  {
+    typedef CodeGenBase<_Scalar> Base;
+    typedef typename Base::Scalar Scalar;
+    
+    typedef typename Base::Model Model;
+    typedef typename Base::Data Data;
+    typedef typename Base::ADCongigVectorType ADCongigVectorType;
+    typedef typename Base::ADTangentVectorType ADTangentVectorType;
+    typedef typename Base::MatrixXs MatrixXs;
+    typedef typename Base::VectorXs VectorXs;
+    
+    typedef typename Data::Matrix6x Matrix6x;
+    typedef typename EIGEN_PLAIN_ROW_MAJOR_TYPE(Matrix6x) RowMatrix6x;
+    
+    typedef typename Base::ADData ADData;
+    typedef typename ADData::Matrix6x ADMatrix6x;
+    typedef typename EIGEN_PLAIN_ROW_MAJOR_TYPE(ADMatrix6x) RowADMatrix6x;
+    
+    ///
+    /// \brief Generates both the Centroidal Momentum Matrix and its time variation.
+    ///        The output of the generated function stacks Ag and dAg, both stored row major.
+    ///
+    CodeGenDCCRBA(const Model & model,
+                  const std::string & function_name = "dccrba",
+                  const std::string & library_name = "cg_dccrba_eval")
+    : Base(model,model.nq+model.nv,2*6*model.nv,function_name,library_name)
+    {
+      ad_q = ADCongigVectorType(model.nq); ad_q = ad_model.neutralConfiguration;
+      ad_v = ADTangentVectorType(model.nv); ad_v.setZero();
+      x = VectorXs::Zero(Base::getInputDimension());
+      
+      Ag = Matrix6x::Zero(6,model.nv);
+      dAg = Matrix6x::Zero(6,model.nv);
+      
+      Base::build_jacobian = false;
+    }
+    
+    void buildMap()
+    {
+      CppAD::Independent(ad_X);
+      
+      Eigen::DenseIndex it = 0;
+      ad_q = ad_X.segment(it,ad_model.nq); it += ad_model.nq;
+      ad_v = ad_X.segment(it,ad_model.nv); it += ad_model.nv;
+      
+      pinocchio::dccrba(ad_model,ad_data,ad_q,ad_v);
+      
+      Eigen::DenseIndex it_Y = 0;
+      Eigen::Map<RowADMatrix6x>(ad_Y.data()+it_Y,6,ad_model.nv) = ad_data.Ag;
+      it_Y += 6*ad_model.nv;
+      Eigen::Map<RowADMatrix6x>(ad_Y.data()+it_Y,6,ad_model.nv) = ad_data.dAg;
+      it_Y += 6*ad_model.nv;
+      
+      ad_fun.Dependent(ad_X,ad_Y);
+      ad_fun.optimize("no_compare_op");
+    }
+    
+    template<typename ConfigVectorType, typename TangentVector>
+    void evalFunction(const Eigen::MatrixBase<ConfigVectorType> & q,
+                      const Eigen::MatrixBase<TangentVector> & v)
+    {
+      // fill x
+      Eigen::DenseIndex it = 0;
+      x.segment(it,ad_model.nq) = q; it += ad_model.nq;
+      x.segment(it,ad_model.nv) = v; it += ad_model.nv;
+      
+      Base::evalFunction(x);
+      
+      // fill Ag and dAg
+      Eigen::DenseIndex it_y = 0;
+      Ag = Eigen::Map<RowMatrix6x>(Base::y.data()+it_y,6,ad_model.nv);
+      it_y += 6*ad_model.nv;
+      dAg = Eigen::Map<RowMatrix6x>(Base::y.data()+it_y,6,ad_model.nv);
+      it_y += 6*ad_model.nv;
+    }
+    
+    /// \brief Centroidal Momentum Matrix.
+    Matrix6x Ag;
+    /// \brief Centroidal Momentum Matrix time variation.
+    Matrix6x dAg;
+    
+  protected:
+    
+    using Base::ad_model;
+    using Base::ad_data;
+    using Base::ad_fun;
+    using Base::ad_X;
+    using Base::ad_Y;
+    using Base::y;
+    
+    VectorXs x;
+    
+    ADCongigVectorType ad_q;
+    ADTangentVectorType ad_v;
+  };
+  
+  template<typename _Scalar>
+  struct CodeGenJacobianCenterOfMass : public CodeGenBase<_Scalar>
+  {
+    typedef CodeGenBase<_Scalar> Base;
+    typedef typename Base::Scalar Scalar;
+    
+    typedef typename Base::Model Model;
+    typedef typename Base::Data Data;
+    typedef typename Base::ADCongigVectorType ADCongigVectorType;
+    typedef typename Base::ADTangentVectorType ADTangentVectorType;
+    typedef typename Base::MatrixXs MatrixXs;
+    typedef typename Base::VectorXs VectorXs;
+    
+    typedef typename Data::Vector3 Vector3;
+    typedef typename Data::Matrix3x Matrix3x;
+    typedef typename EIGEN_PLAIN_ROW_MAJOR_TYPE(Matrix3x) RowMatrix3x;
+    
+    typedef typename Base::ADData ADData;
+    typedef typename ADData::Matrix3x ADMatrix3x;
+    typedef typename EIGEN_PLAIN_ROW_MAJOR_TYPE(ADMatrix3x) RowADMatrix3x;
+    
+    ///
+    /// \brief Generates both the center of mass position and its Jacobian.
+    ///        The output of the generated function stacks the com (dim 3) and Jcom (dim 3 x model.nv, row major).
+    ///
+    CodeGenJacobianCenterOfMass(const Model & model,
+                                const std::string & function_name = "jacobian_com",
+                                const std::string & library_name = "cg_jacobian_com_eval")
+    : Base(model,model.nq,3+3*model.nv,function_name,library_name)
+    {
+      ad_q = ADCongigVectorType(model.nq); ad_q = ad_model.neutralConfiguration;
+      x = VectorXs::Zero(Base::getInputDimension());
+      
+      com = Vector3::Zero();
+      Jcom = Matrix3x::Zero(3,model.nv);
+      
+      Base::build_jacobian = false;
+    }
+    
+    void buildMap()
+    {
+      CppAD::Independent(ad_X);
+      
+      Eigen::DenseIndex it = 0;
+      ad_q = ad_X.segment(it,ad_model.nq); it += ad_model.nq;
+      
+      pinocchio::jacobianCenterOfMass(ad_model,ad_data,ad_q,false);
+      
+      Eigen::DenseIndex it_Y = 0;
+      ad_Y.segment(it_Y,3) = ad_data.com[0]; it_Y += 3;
+      Eigen::Map<RowADMatrix3x>(ad_Y.data()+it_Y,3,ad_model.nv) = ad_data.Jcom;
+      it_Y += 3*ad_model.nv;
+      
+      ad_fun.Dependent(ad_X,ad_Y);
+      ad_fun.optimize("no_compare_op");
+    }
+    
+    template<typename ConfigVectorType>
+    void evalFunction(const Eigen::MatrixBase<ConfigVectorType> & q)
+    {
+      // fill x
+      Eigen::DenseIndex it = 0;
+      x.segment(it,ad_model.nq) = q; it += ad_model.nq;
+      
+      Base::evalFunction(x);
+      
+      // fill com and Jcom
+      Eigen::DenseIndex it_y = 0;
+      com = Base::y.template segment<3>(it_y); it_y += 3;
+      Jcom = Eigen::Map<RowMatrix3x>(Base::y.data()+it_y,3,ad_model.nv);
+      it_y += 3*ad_model.nv;
+    }
+    
+    /// \brief Center of mass position of the whole model, expressed in the world frame.
+    Vector3 com;
+    /// \brief Jacobian of the center of mass, expressed in the world frame.
+    Matrix3x Jcom;
+    
+  protected:
+    
+    using Base::ad_model;
+    using Base::ad_data;
+    using Base::ad_fun;
+    using Base::ad_X;
+    using Base::ad_Y;
+    using Base::y;
+    
+    VectorXs x;
+    
+    ADCongigVectorType ad_q;
+  };
+  
+  template<typename _Scalar>
+  struct CodeGenCentroidalDynamicsDerivatives : public CodeGenBase<_Scalar>
+  {
+    typedef CodeGenBase<_Scalar> Base;
+    typedef typename Base::Scalar Scalar;
+    
+    typedef typename Base::Model Model;
+    typedef typename Base::Data Data;
+    typedef typename Base::ADCongigVectorType ADCongigVectorType;
+    typedef typename Base::ADTangentVectorType ADTangentVectorType;
+    typedef typename Base::MatrixXs MatrixXs;
+    typedef typename Base::VectorXs VectorXs;
+    
+    typedef typename Data::Matrix6x Matrix6x;
+    typedef typename EIGEN_PLAIN_ROW_MAJOR_TYPE(Matrix6x) RowMatrix6x;
+    
+    typedef typename Base::ADData ADData;
+    typedef typename ADData::Matrix6x ADMatrix6x;
+    typedef typename EIGEN_PLAIN_ROW_MAJOR_TYPE(ADMatrix6x) RowADMatrix6x;
+    
+    CodeGenCentroidalDynamicsDerivatives(const Model & model,
+                                         const std::string & function_name = "partial_centroidal",
+                                         const std::string & library_name = "cg_partial_centroidal_eval")
+    : Base(model,model.nq+2*model.nv,3*6*model.nv,function_name,library_name)
+    {
+      ad_q = ADCongigVectorType(model.nq); ad_q = ad_model.neutralConfiguration;
+      ad_v = ADTangentVectorType(model.nv); ad_v.setZero();
+      ad_a = ADTangentVectorType(model.nv); ad_a.setZero();
+      
+      x = VectorXs::Zero(Base::getInputDimension());
+      
+      ad_dhdot_dq = ADMatrix6x::Zero(6,model.nv);
+      ad_dhdot_dv = ADMatrix6x::Zero(6,model.nv);
+      ad_dhdot_da = ADMatrix6x::Zero(6,model.nv);
+      
+      dhdot_dq = Matrix6x::Zero(6,model.nv);
+      dhdot_dv = Matrix6x::Zero(6,model.nv);
+      dhdot_da = Matrix6x::Zero(6,model.nv);
+      
+      Base::build_jacobian = false;
+    }
+    
+    void buildMap()
+    {
+      CppAD::Independent(ad_X);
+      
+      Eigen::DenseIndex it = 0;
+      ad_q = ad_X.segment(it,ad_model.nq); it += ad_model.nq;
+      ad_v = ad_X.segment(it,ad_model.nv); it += ad_model.nv;
+      ad_a = ad_X.segment(it,ad_model.nv); it += ad_model.nv;
+      
+      pinocchio::computeCentroidalDynamicsDerivatives(ad_model,ad_data,
+                                                      ad_q,ad_v,ad_a,
+                                                      ad_dhdot_dq,ad_dhdot_dv,ad_dhdot_da);
+      
+      assert(ad_Y.size() == Base::getOutputDimension());
+      
+      Eigen::DenseIndex it_Y = 0;
+      Eigen::Map<RowADMatrix6x>(ad_Y.data()+it_Y,6,ad_model.nv) = ad_dhdot_dq;
+      it_Y += 6*ad_model.nv;
+      Eigen::Map<RowADMatrix6x>(ad_Y.data()+it_Y,6,ad_model.nv) = ad_dhdot_dv;
+      it_Y += 6*ad_model.nv;
+      Eigen::Map<RowADMatrix6x>(ad_Y.data()+it_Y,6,ad_model.nv) = ad_dhdot_da;
+      it_Y += 6*ad_model.nv;
+      
+      ad_fun.Dependent(ad_X,ad_Y);
+      ad_fun.optimize("no_compare_op");
+    }
+    
+    template<typename ConfigVectorType, typename TangentVector1, typename TangentVector2>
+    void evalFunction(const Eigen::MatrixBase<ConfigVectorType> & q,
+                      const Eigen::MatrixBase<TangentVector1> & v,
+                      const Eigen::MatrixBase<TangentVector2> & a)
+    {
+      // fill x
+      Eigen::DenseIndex it_x = 0;
+      x.segment(it_x,ad_model.nq) = q; it_x += ad_model.nq;
+      x.segment(it_x,ad_model.nv) = v; it_x += ad_model.nv;
+      x.segment(it_x,ad_model.nv) = a; it_x += ad_model.nv;
+      
+      Base::evalFunction(x);
+      
+      // fill partial derivatives
+      Eigen::DenseIndex it_y = 0;
+      dhdot_dq = Eigen::Map<RowMatrix6x>(Base::y.data()+it_y,6,ad_model.nv);
+      it_y += 6*ad_model.nv;
+      dhdot_dv = Eigen::Map<RowMatrix6x>(Base::y.data()+it_y,6,ad_model.nv);
+      it_y += 6*ad_model.nv;
+      dhdot_da = Eigen::Map<RowMatrix6x>(Base::y.data()+it_y,6,ad_model.nv);
+      it_y += 6*ad_model.nv;
+    }
+    
+    /// \brief Partial derivatives of the centroidal dynamics with respect to q, v and a.
+    Matrix6x dhdot_dq, dhdot_dv, dhdot_da;
+    
+  protected:
+    
+    using Base::ad_model;
+    using Base::ad_data;
+    using Base::ad_fun;
+    using Base::ad_X;
+    using Base::ad_Y;
+    using Base::y;
+    
+    VectorXs x;
+    ADMatrix6x ad_dhdot_dq, ad_dhdot_dv, ad_dhdot_da;
+    
+    ADCongigVectorType ad_q;
+    ADTangentVectorType ad_v, ad_a;
+  };
+  
 } // namespace pinocchio
 
 #endif // ifdef PINOCCHIO_WITH_CPPADCG_SUPPORT
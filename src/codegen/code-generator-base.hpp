@@ -8,6 +8,16 @@
 #include "pinocchio/multibody/model.hpp"
 #include "pinocchio/multibody/data.hpp"
 
+#include <Eigen/Sparse>
+#include <algorithm>
+#include <cctype>
+#include <set>
+#include <sstream>
+
+#ifdef PINOCCHIO_WITH_OPENMP
+  #include <omp.h>
+#endif
+
 #ifdef PINOCCHIO_WITH_CPPADCG_SUPPORT
 
 namespace pinocchio
@@ -33,6 +43,10 @@ namespace pinocchio
     typedef Eigen::Matrix<Scalar,Eigen::Dynamic,1,Options> VectorXs;
     typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic,Options|Eigen::RowMajor> RowMatrixXs;
     typedef Eigen::Matrix<ADScalar,Eigen::Dynamic,1,Options> ADVectorXs;
+    typedef Eigen::Matrix<bool,Eigen::Dynamic,Eigen::Dynamic> BoolMatrixXs;
+    
+    typedef Eigen::SparseMatrix<Scalar,Eigen::RowMajor,int> RowSparseMatrixXs;
+    typedef Eigen::SparseMatrix<Scalar,Eigen::ColMajor,int> ColSparseMatrixXs;
     
     typedef typename Model::ConfigVectorType CongigVectorType;
     typedef typename Model::TangentVectorType TangentVectorType;
@@ -42,6 +56,65 @@ namespace pinocchio
     
     typedef CppAD::ADFun<CGScalar> ADFun;
     
+    typedef typename Model::JointIndex JointIndex;
+    
+    ///
+    /// \brief Compressed storage (CSR or CSC) of the sparsity pattern of a generated sparse Jacobian or Hessian.
+    ///        The non-zero values returned by the generated function follow the order of (row_indexes,col_indexes),
+    ///        which allows to evaluate them directly in the value buffer of a compressed sparse matrix.
+    ///
+    struct SparsityStructure
+    {
+      SparsityStructure() : rows(0), cols(0), row_major(true) {}
+      
+      ///
+      /// \brief Fills the structure from a dense boolean pattern.
+      ///
+      /// \param[in] pattern The sparsity pattern.
+      /// \param[in] row_major If true, the compressed storage is CSR, otherwise CSC.
+      /// \param[in] lower_triangular If true, only the lower triangular part of pattern is considered.
+      ///
+      void compute(const BoolMatrixXs & pattern,
+                   const bool row_major,
+                   const bool lower_triangular = false)
+      {
+        this->rows = pattern.rows(); this->cols = pattern.cols();
+        this->row_major = row_major;
+        
+        const Eigen::DenseIndex outer_size = row_major ? rows : cols;
+        const Eigen::DenseIndex inner_size = row_major ? cols : rows;
+        
+        row_indexes.clear(); col_indexes.clear(); inner_index.clear();
+        outer_index.resize((size_t)outer_size+1); outer_index[0] = 0;
+        for(Eigen::DenseIndex outer = 0; outer < outer_size; ++outer)
+        {
+          for(Eigen::DenseIndex inner = 0; inner < inner_size; ++inner)
+          {
+            const Eigen::DenseIndex i = row_major ? outer : inner;
+            const Eigen::DenseIndex j = row_major ? inner : outer;
+            if(!pattern(i,j) || (lower_triangular && j > i)) continue;
+            
+            row_indexes.push_back((size_t)i);
+            col_indexes.push_back((size_t)j);
+            inner_index.push_back((int)inner);
+          }
+          outer_index[(size_t)outer+1] = (int)inner_index.size();
+        }
+      }
+      
+      /// \brief Number of structural non-zero elements.
+      size_t nnz() const { return row_indexes.size(); }
+      
+      Eigen::DenseIndex rows, cols;
+      bool row_major;
+      
+      /// \brief Coordinates of the non-zero elements, in storage order.
+      std::vector<size_t> row_indexes, col_indexes;
+      
+      /// \brief Compressed indexes, following the Eigen::SparseMatrix conventions.
+      std::vector<int> outer_index, inner_index;
+    };
+    
     CodeGenBase(const Model & model,
                 const Eigen::DenseIndex dim_input,
                 const Eigen::DenseIndex dim_output,
@@ -53,6 +126,13 @@ namespace pinocchio
     , library_name(library_name + "_" + model.name)
     , build_forward(true)
     , build_jacobian(true)
+    , build_hessian(false)
+    , build_sparse_jacobian(false)
+    , build_sparse_hessian(false)
+    , sparse_row_major(true)
+    , build_batch(false)
+    , batch_lanes(4)
+    , batchFun_ptr(NULL)
     {
       ad_X = ADVectorXs(dim_input);
       ad_Y = ADVectorXs(dim_output);
@@ -60,6 +140,8 @@ namespace pinocchio
       y = VectorXs(ad_Y.size());
       
       jac = RowMatrixXs(ad_Y.size(),ad_X.size());
+      
+      computeJointCoupling(model);
     }
     
     /// \brief build the mapping Y = f(X)
@@ -73,8 +155,52 @@ namespace pinocchio
       cgen_ptr = std::unique_ptr<CppAD::cg::ModelCSourceGen<Scalar> >(new CppAD::cg::ModelCSourceGen<Scalar>(ad_fun, function_name));
       cgen_ptr->setCreateForwardZero(build_forward);
       cgen_ptr->setCreateJacobian(build_jacobian);
+      cgen_ptr->setCreateHessian(build_hessian);
+      
+      if(build_hessian)
+      {
+        w = VectorXs::Zero(ad_Y.size());
+        hess = RowMatrixXs::Zero(ad_X.size(),ad_X.size());
+      }
+      
+      if(build_sparse_jacobian)
+      {
+        typedef std::vector< std::set<size_t> > SparsitySet;
+        const SparsitySet ad_sparsity = CppAD::cg::jacobianSparsitySet<SparsitySet>(ad_fun);
+        
+        BoolMatrixXs pattern(jacobianSparsityPattern());
+        assert(pattern.rows() == ad_Y.size() && pattern.cols() == ad_X.size());
+        intersectSparsityPattern(ad_sparsity,pattern);
+        
+        jac_sparsity.compute(pattern,sparse_row_major);
+        jac_values = VectorXs::Zero((Eigen::DenseIndex)jac_sparsity.nnz());
+        
+        cgen_ptr->setCreateSparseJacobian(true);
+        cgen_ptr->setCustomSparseJacobianElements(jac_sparsity.row_indexes,jac_sparsity.col_indexes);
+      }
+      
+      if(build_sparse_hessian)
+      {
+        typedef std::vector< std::set<size_t> > SparsitySet;
+        const SparsitySet ad_sparsity = CppAD::cg::hessianSparsitySet<SparsitySet>(ad_fun);
+        
+        BoolMatrixXs pattern(hessianSparsityPattern());
+        assert(pattern.rows() == ad_X.size() && pattern.cols() == ad_X.size());
+        intersectSparsityPattern(ad_sparsity,pattern);
+        
+        hess_sparsity.compute(pattern,sparse_row_major,true);
+        hess_values = VectorXs::Zero((Eigen::DenseIndex)hess_sparsity.nnz());
+        if(w.size() != ad_Y.size()) w = VectorXs::Zero(ad_Y.size());
+        
+        cgen_ptr->setCreateSparseHessian(true);
+        cgen_ptr->setCustomSparseHessianElements(hess_sparsity.row_indexes,hess_sparsity.col_indexes);
+      }
+      
       libcgen_ptr = std::unique_ptr<CppAD::cg::ModelLibraryCSourceGen<Scalar> >(new CppAD::cg::ModelLibraryCSourceGen<Scalar>(*cgen_ptr));
       
+      if(build_batch)
+        libcgen_ptr->addCustomFunctionSource(function_name + "_batch.c",generateBatchSource());
+      
       dynamicLibManager_ptr
       = std::unique_ptr<CppAD::cg::DynamicModelLibraryProcessor<Scalar> >(new CppAD::cg::DynamicModelLibraryProcessor<Scalar>(*libcgen_ptr,library_name));
     }
@@ -82,11 +208,79 @@ namespace pinocchio
     CppAD::cg::ModelCSourceGen<Scalar> & codeGenerator()
     { return *cgen_ptr; }
     
+    ///
+    /// \brief Generates a self-contained C source implementing the function, to be compiled ahead of time
+    ///        and linked statically. It does not depend on CppADCG and exports the symbols
+    ///        \code
+    ///        void <c_name>(T const * x, T * y);                            // if build_forward
+    ///        void <c_name>_jacobian(T const * x, T * jac);                 // if build_jacobian, row-major
+    ///        void <c_name>_batch(T const * X, T * Y, unsigned long n);     // if build_batch
+    ///        \endcode
+    ///        with T the scalar type (double or float).
+    ///
+    /// \param[out] source Stream where the C code is written.
+    /// \param[in] c_name Name of the exported symbol.
+    ///
+    /// \remarks The generated code requires <math.h>. The declarations of the symbols are given by generateStandaloneDeclarations.
+    ///          The function recorded by initLib is reused if any, otherwise it is recorded once.
+    ///
+    void generateStandaloneSource(std::ostream & source, const std::string & c_name)
+    {
+      if(ad_fun.size_var() == 0)
+        buildMap();
+      
+      const std::string type_name = typeName();
+      
+      size_t num_tmp;
+      if(build_forward)
+      {
+        const std::string body = generateBody(false,num_tmp);
+        source << "void " << c_name << "(" << type_name << " const * x, " << type_name << " * y)\n"
+               << "{\n"
+               << "  " << type_name << " v[" << num_tmp << "];\n"
+               << "  {\n" << body << "\n  }\n"
+               << "}\n\n";
+      }
+      
+      if(build_jacobian)
+      {
+        const std::string body = generateBody(true,num_tmp);
+        source << "void " << c_name << "_jacobian(" << type_name << " const * x, " << type_name << " * jac)\n"
+               << "{\n"
+               << "  " << type_name << " v[" << num_tmp << "];\n"
+               << "  {\n" << body << "\n  }\n"
+               << "}\n\n";
+      }
+      
+      if(build_batch)
+      {
+        generateBatchFunction(source,c_name + "_batch");
+        source << "\n";
+      }
+    }
+    
+    ///
+    /// \brief Writes the C declarations of the symbols generated by generateStandaloneSource.
+    ///
+    void generateStandaloneDeclarations(std::ostream & header, const std::string & c_name) const
+    {
+      const std::string type_name = typeName();
+      if(build_forward)
+        header << "void " << c_name << "(" << type_name << " const * x, " << type_name << " * y);\n";
+      if(build_jacobian)
+        header << "void " << c_name << "_jacobian(" << type_name << " const * x, " << type_name << " * jac);\n";
+      if(build_batch)
+        header << "void " << c_name << "_batch(" << type_name << " const * X, " << type_name << " * Y, unsigned long n);\n";
+    }
+    
     void compileLib()
     {
       CppAD::cg::GccCompiler<Scalar> compiler;
       std::vector<std::string> compile_options = compiler.getCompileFlags();
       compile_options[0] = "-Ofast";
+      // The batched kernel is only worth it with the vector instructions of the host.
+      if(build_batch)
+        compile_options.push_back("-march=native");
       compiler.setCompileFlags(compile_options);
       dynamicLibManager_ptr->createDynamicLibrary(compiler,false);
     }
@@ -115,6 +309,9 @@ namespace pinocchio
       }
       
       generatedFun_ptr = dynamicLib_ptr->model(function_name.c_str());
+      
+      if(build_batch)
+        batchFun_ptr = reinterpret_cast<BatchFunction>(dynamicLib_ptr->loadFunction(function_name + "_batch"));
     }
     
     template<typename Vector>
@@ -135,6 +332,185 @@ namespace pinocchio
       generatedFun_ptr->Jacobian(x_,jac_);
     }
     
+    ///
+    /// \brief Evaluates the function on a batch of inputs.
+    ///
+    /// \param[in] X The inputs stored column-wise (dim getInputDimension() x N), contiguous in memory.
+    /// \param[out] Y The outputs stored column-wise (dim getOutputDimension() x N), contiguous in memory.
+    /// \param[in] num_threads Number of threads among which the N evaluations are split.
+    ///                        It is only effective when Pinocchio is built with OpenMP support.
+    ///
+    /// \remarks If the batched kernel has been generated (see setBuildBatch), each thread calls it once on its chunk of inputs.
+    ///          Otherwise, the generated function is called once per input.
+    ///
+    template<typename InputMatrix, typename OutputMatrix>
+    void evalFunctionBatch(const Eigen::MatrixBase<InputMatrix> & X,
+                           const Eigen::MatrixBase<OutputMatrix> & Y,
+                           const int num_threads = 1)
+    {
+      assert(build_forward);
+      assert(X.rows() == getInputDimension() && Y.rows() == getOutputDimension());
+      assert(X.cols() == Y.cols());
+      assert(X.innerStride() == 1 && X.outerStride() == X.rows() && "X must be contiguous in memory.");
+      assert(Y.innerStride() == 1 && Y.outerStride() == Y.rows() && "Y must be contiguous in memory.");
+      
+      const Scalar * x = X.derived().data();
+      Scalar * y = EIGEN_CONST_CAST(OutputMatrix,Y).data();
+      const Eigen::DenseIndex nx = X.rows(), ny = Y.rows();
+      const Eigen::DenseIndex N = X.cols();
+      
+      if(batchFun_ptr == NULL)
+      {
+        for(Eigen::DenseIndex k = 0; k < N; ++k)
+        {
+          CppAD::cg::ArrayView<const Scalar> x_(x + k*nx,(size_t)nx);
+          CppAD::cg::ArrayView<Scalar> y_(y + k*ny,(size_t)ny);
+          generatedFun_ptr->ForwardZero(x_,y_);
+        }
+        return;
+      }
+      
+#ifdef PINOCCHIO_WITH_OPENMP
+      const Eigen::DenseIndex num_chunks = std::max(1,std::min<int>(num_threads,(int)N));
+      // The chunks are made of whole blocks of lanes, so that only the last one may end with a partial block.
+      const Eigen::DenseIndex num_blocks = (N + batch_lanes - 1) / batch_lanes;
+      const Eigen::DenseIndex chunk_size = batch_lanes * ((num_blocks + num_chunks - 1) / num_chunks);
+      
+      #pragma omp parallel for num_threads(num_threads) schedule(static)
+      for(Eigen::DenseIndex chunk = 0; chunk < num_chunks; ++chunk)
+      {
+        const Eigen::DenseIndex begin = chunk*chunk_size;
+        const Eigen::DenseIndex size = std::min(chunk_size,N-begin);
+        if(size > 0)
+          batchFun_ptr(x + begin*nx, y + begin*ny, (unsigned long)size);
+      }
+#else
+      PINOCCHIO_UNUSED_VARIABLE(num_threads);
+      batchFun_ptr(x,y,(unsigned long)N);
+#endif
+    }
+    
+    ///
+    /// \brief Evaluates the Hessian of the weighted sum of the outputs, i.e. \f$ \sum_{i} w_{i} \nabla^{2} f_{i}(x) \f$.
+    ///        The result is stored in hess.
+    ///
+    template<typename Vector, typename WeightVector>
+    void evalHessian(const Eigen::MatrixBase<Vector> & x,
+                     const Eigen::MatrixBase<WeightVector> & weights)
+    {
+      assert(build_hessian);
+      
+      w = weights;
+      CppAD::cg::ArrayView<const Scalar> x_(EIGEN_CONST_CAST(Vector,x).data(),(size_t)x.size());
+      CppAD::cg::ArrayView<const Scalar> w_(w.data(),(size_t)w.size());
+      CppAD::cg::ArrayView<Scalar> hess_(hess.data(),(size_t)hess.size());
+      generatedFun_ptr->Hessian(x_,w_,hess_);
+    }
+    
+    ///
+    /// \brief Evaluates the non-zero values of the sparse Jacobian directly into the buffer values.
+    ///
+    /// \param[in] x The input vector.
+    /// \param[out] values A buffer of size jacobianSparsity().nnz(), e.g. the value pointer of a compressed sparse matrix
+    ///                    sharing the structure given by jacobianSparsity().
+    ///
+    template<typename Vector>
+    void evalSparseJacobian(const Eigen::MatrixBase<Vector> & x, Scalar * values)
+    {
+      assert(build_sparse_jacobian);
+      
+      const size_t * row = NULL; const size_t * col = NULL;
+      CppAD::cg::ArrayView<const Scalar> x_(EIGEN_CONST_CAST(Vector,x).data(),(size_t)x.size());
+      CppAD::cg::ArrayView<Scalar> jac_(values,jac_sparsity.nnz());
+      generatedFun_ptr->SparseJacobian(x_,jac_,&row,&col);
+    }
+    
+    /// \brief Evaluates the non-zero values of the sparse Jacobian into jac_values.
+    template<typename Vector>
+    void evalSparseJacobian(const Eigen::MatrixBase<Vector> & x)
+    { evalSparseJacobian(x,jac_values.data()); }
+    
+    ///
+    /// \brief Evaluates the non-zero values of the lower triangular part of the sparse Hessian of the weighted sum of the outputs
+    ///        directly into the buffer values.
+    ///
+    /// \param[in] x The input vector.
+    /// \param[in] weights The weights of each output.
+    /// \param[out] values A buffer of size hessianSparsity().nnz().
+    ///
+    template<typename Vector, typename WeightVector>
+    void evalSparseHessian(const Eigen::MatrixBase<Vector> & x,
+                           const Eigen::MatrixBase<WeightVector> & weights,
+                           Scalar * values)
+    {
+      assert(build_sparse_hessian);
+      
+      w = weights;
+      const size_t * row = NULL; const size_t * col = NULL;
+      CppAD::cg::ArrayView<const Scalar> x_(EIGEN_CONST_CAST(Vector,x).data(),(size_t)x.size());
+      CppAD::cg::ArrayView<const Scalar> w_(w.data(),(size_t)w.size());
+      CppAD::cg::ArrayView<Scalar> hess_(values,hess_sparsity.nnz());
+      generatedFun_ptr->SparseHessian(x_,w_,hess_,&row,&col);
+    }
+    
+    /// \brief Evaluates the non-zero values of the sparse Hessian into hess_values.
+    template<typename Vector, typename WeightVector>
+    void evalSparseHessian(const Eigen::MatrixBase<Vector> & x,
+                           const Eigen::MatrixBase<WeightVector> & weights)
+    { evalSparseHessian(x,weights,hess_values.data()); }
+    
+    /// \brief Sparsity structure of the generated sparse Jacobian (available after initLib).
+    const SparsityStructure & jacobianSparsity() const { return jac_sparsity; }
+    
+    /// \brief Sparsity structure of the lower triangular part of the generated sparse Hessian (available after initLib).
+    const SparsityStructure & hessianSparsity() const { return hess_sparsity; }
+    
+    ///
+    /// \brief Returns a compressed sparse matrix mapping the last sparse Jacobian evaluation, without any copy.
+    ///
+    /// \tparam StorageOrder Must be consistent with the storage order set by setSparseStorageOrder.
+    ///
+    template<int StorageOrder>
+    Eigen::Map< Eigen::SparseMatrix<Scalar,StorageOrder,int> > sparseJacobian()
+    { return mapSparse<StorageOrder>(jac_sparsity,jac_values); }
+    
+    ///
+    /// \brief Returns a compressed sparse matrix mapping the lower triangular part of the last sparse Hessian evaluation, without any copy.
+    ///
+    /// \tparam StorageOrder Must be consistent with the storage order set by setSparseStorageOrder.
+    ///
+    template<int StorageOrder>
+    Eigen::Map< Eigen::SparseMatrix<Scalar,StorageOrder,int> > sparseHessian()
+    { return mapSparse<StorageOrder>(hess_sparsity,hess_values); }
+    
+    /// \brief Enables the generation of the dense Jacobian. Must be called before initLib.
+    void setBuildJacobian(const bool value) { build_jacobian = value; }
+    
+    /// \brief Enables the generation of the dense Hessian. Must be called before initLib.
+    void setBuildHessian(const bool value) { build_hessian = value; }
+    
+    /// \brief Enables the generation of the sparse Jacobian. Must be called before initLib.
+    void setBuildSparseJacobian(const bool value) { build_sparse_jacobian = value; }
+    
+    /// \brief Enables the generation of the sparse Hessian. Must be called before initLib.
+    void setBuildSparseHessian(const bool value) { build_sparse_hessian = value; }
+    
+    ///
+    /// \brief Enables the generation of a batched kernel, evaluating the function on N contiguous inputs within a single call
+    ///        (see evalFunctionBatch). The library is then compiled for the instruction set of the host (-march=native).
+    ///        Must be called before initLib.
+    ///
+    void setBuildBatch(const bool value) { build_batch = value; }
+    
+    ///
+    /// \brief Sets the number of samples evaluated together by the batched kernel (4 by default), i.e. the width of the
+    ///        vector registers in number of scalars. Must be called before initLib.
+    ///
+    void setBatchLanes(const Eigen::DenseIndex value) { assert(value > 0); batch_lanes = value; }
+    
+    /// \brief Sets the storage order (Eigen::RowMajor for CSR or Eigen::ColMajor for CSC) of the sparse Jacobian and Hessian. Must be called before initLib.
+    void setSparseStorageOrder(const int storage_order) { sparse_row_major = (storage_order == Eigen::RowMajor); }
+    
     /// \brief Dimension of the input vector
     Eigen::DenseIndex getInputDimension() const { return ad_X.size(); }
     /// \brief Dimension of the output vector
@@ -142,6 +518,216 @@ namespace pinocchio
     
   protected:
     
+    ///
+    /// \brief Upper bound of the sparsity pattern of the Jacobian (dim output x input) derived from the model topology.
+    ///        The default implementation returns a full pattern, leaving CppAD determine the actual sparsity.
+    ///
+    virtual BoolMatrixXs jacobianSparsityPattern() const
+    { return BoolMatrixXs::Constant(ad_Y.size(),ad_X.size(),true); }
+    
+    ///
+    /// \brief Upper bound of the sparsity pattern of the Hessian (dim input x input) derived from the model topology.
+    ///        The default implementation returns a full pattern, leaving CppAD determine the actual sparsity.
+    ///
+    virtual BoolMatrixXs hessianSparsityPattern() const
+    { return BoolMatrixXs::Constant(ad_X.size(),ad_X.size(),true); }
+    
+    ///
+    /// \brief Sets to true the blocks of pattern relating two joints coupled according to coupling.
+    ///
+    /// \param[in] coupling Joint coupling matrix (dim model.njoints), e.g. joint_support or joint_tree.
+    /// \param[in] row, col Offsets of the block in pattern.
+    /// \param[in] row_config, col_config If true, the rows (resp. columns) of the block are indexed by the configuration vector, otherwise by the tangent vector.
+    ///
+    void fillSparsityBlock(BoolMatrixXs & pattern,
+                           const BoolMatrixXs & coupling,
+                           const Eigen::DenseIndex row, const bool row_config,
+                           const Eigen::DenseIndex col, const bool col_config) const
+    {
+      for(JointIndex i = 1; i < (JointIndex)ad_model.njoints; ++i)
+      {
+        const Eigen::DenseIndex idx_i = row_config ? idx_q(ad_model.joints[i]) : idx_v(ad_model.joints[i]);
+        const Eigen::DenseIndex dim_i = row_config ? nq(ad_model.joints[i]) : nv(ad_model.joints[i]);
+        for(JointIndex j = 1; j < (JointIndex)ad_model.njoints; ++j)
+        {
+          if(!coupling(i,j)) continue;
+          const Eigen::DenseIndex idx_j = col_config ? idx_q(ad_model.joints[j]) : idx_v(ad_model.joints[j]);
+          const Eigen::DenseIndex dim_j = col_config ? nq(ad_model.joints[j]) : nv(ad_model.joints[j]);
+          pattern.block(row+idx_i,col+idx_j,dim_i,dim_j).setConstant(true);
+        }
+      }
+    }
+    
+    void computeJointCoupling(const Model & model)
+    {
+      joint_support = BoolMatrixXs::Constant(model.njoints,model.njoints,false);
+      joint_tree = BoolMatrixXs::Constant(model.njoints,model.njoints,false);
+      
+      std::vector<JointIndex> root(model.joints.size(),0);
+      for(JointIndex i = 1; i < (JointIndex)model.njoints; ++i)
+      {
+        root[i] = model.parents[i] == 0 ? i : root[model.parents[i]];
+        for(JointIndex j = i; j > 0; j = model.parents[j])
+          joint_support(i,j) = joint_support(j,i) = true;
+      }
+      
+      for(JointIndex i = 1; i < (JointIndex)model.njoints; ++i)
+        for(JointIndex j = 1; j < (JointIndex)model.njoints; ++j)
+          joint_tree(i,j) = (root[i] == root[j]);
+    }
+    
+    template<typename SparsitySet>
+    static void intersectSparsityPattern(const SparsitySet & sparsity,
+                                         BoolMatrixXs & pattern)
+    {
+      for(Eigen::DenseIndex i = 0; i < pattern.rows(); ++i)
+        for(Eigen::DenseIndex j = 0; j < pattern.cols(); ++j)
+          pattern(i,j) = pattern(i,j) && (sparsity[(size_t)i].count((size_t)j) > 0);
+    }
+    
+    ///
+    /// \brief Generates the C statements evaluating either the function (outputs named y) or its row-major
+    ///        dense Jacobian (outputs named jac) from the inputs x, using the temporaries v.
+    ///        No function is requested from LanguageC, so the statements do not declare any variable:
+    ///        the caller declares v with num_tmp elements and emits the statements in a nested block,
+    ///        so that they cannot clash with the declarations of the enclosing function.
+    ///
+    /// \param[in] jacobian Generates the Jacobian statements if true, the function ones otherwise.
+    /// \param[out] num_tmp Minimal size of the temporary array v.
+    ///
+    std::string generateBody(const bool jacobian, size_t & num_tmp)
+    {
+      CppAD::cg::CodeHandler<Scalar> handler;
+      CppAD::vector<CGScalar> ind_vars((size_t)ad_X.size());
+      handler.makeVariables(ind_vars);
+      CppAD::vector<CGScalar> dep_vars = jacobian ? ad_fun.Jacobian(ind_vars) : ad_fun.Forward(0,ind_vars);
+      
+      CppAD::cg::LanguageC<Scalar> langC(typeName());
+      CppAD::cg::LangCDefaultVariableNameGenerator<Scalar> nameGen(jacobian ? "jac" : "y");
+      std::ostringstream body;
+      handler.generateCode(body,langC,dep_vars,nameGen);
+      
+      num_tmp = std::max<size_t>(handler.getTemporaryVariableCount(),1);
+      return body.str();
+    }
+    
+    ///
+    /// \brief Generates the C source of the batched kernel.
+    ///
+    std::string generateBatchSource()
+    {
+      std::ostringstream code;
+      code << "#include <math.h>\n\n";
+      generateBatchFunction(code,function_name + "_batch");
+      return code.str();
+    }
+    
+    ///
+    /// \brief Generates the batched kernel. The samples are processed by blocks of batch_lanes: the inputs of a block
+    ///        are transposed into a lane-interleaved buffer (x[i*lanes + l] is the input i of the sample l), the body of the
+    ///        zero order forward evaluation is emitted inside loops over the lanes, and the outputs are transposed back.
+    ///        The temporaries are interleaved the same way, so that the iterations of a loop over the lanes are independent
+    ///        and access contiguous memory, which lets the compiler vectorize them across the samples.
+    ///        The lanes of the last block beyond n replicate its last sample and are not written back.
+    ///
+    void generateBatchFunction(std::ostream & code, const std::string & c_name)
+    {
+      size_t num_tmp;
+      const std::string body = interleaveLanes(generateBody(false,num_tmp),batch_lanes);
+      const std::string type_name = typeName();
+      const Eigen::DenseIndex nx = ad_X.size(), ny = ad_Y.size();
+      const Eigen::DenseIndex lanes = batch_lanes;
+      
+      std::ostringstream lane_loop;
+      lane_loop << "    for(l = 0; l < " << lanes << "; ++l)\n"
+                << "    {\n";
+      
+      code << "void " << c_name << "(" << type_name << " const * X, " << type_name << " * Y, unsigned long n)\n"
+           << "{\n"
+           << "  unsigned long k, i, l, m;\n"
+           << "  " << type_name << " x[" << nx*lanes << "];\n"
+           << "  " << type_name << " y[" << ny*lanes << "];\n"
+           << "  " << type_name << " v[" << (Eigen::DenseIndex)num_tmp*lanes << "];\n"
+           << "  for(k = 0; k < n; k += " << lanes << ")\n"
+           << "  {\n"
+           << "    m = n - k < " << lanes << " ? n - k : " << lanes << ";\n"
+           << "    for(l = 0; l < " << lanes << "; ++l)\n"
+           << "      for(i = 0; i < " << nx << "; ++i)\n"
+           << "        x[i*" << lanes << " + l] = X[(k + (l < m ? l : m - 1))*" << nx << " + i];\n"
+           << lane_loop.str();
+      
+      // Compilers give up vectorizing loops with too many memory accesses (e.g. GCC param loop-max-datarefs-for-datadeps):
+      // the body is split into several loops over the lanes, between top-level statements.
+      const size_t statements_per_loop = 32;
+      std::istringstream lines(body);
+      std::string line;
+      long depth = 0;
+      size_t num_statements = 0;
+      while(std::getline(lines,line))
+      {
+        code << line << "\n";
+        depth += std::count(line.begin(),line.end(),'{') - std::count(line.begin(),line.end(),'}');
+        const size_t last = line.find_last_not_of(" \t\r");
+        if(depth == 0 && last != std::string::npos && line[last] == ';'
+           && ++num_statements % statements_per_loop == 0)
+          code << "    }\n" << lane_loop.str();
+      }
+      
+      code << "    }\n"
+           << "    for(l = 0; l < m; ++l)\n"
+           << "      for(i = 0; i < " << ny << "; ++i)\n"
+           << "        Y[(k + l)*" << ny << " + i] = y[i*" << lanes << " + l];\n"
+           << "  }\n"
+           << "}\n";
+    }
+    
+    ///
+    /// \brief Rewrites the accesses x[i], y[i] and v[i] of a body generated by generateBody into the lane-interleaved
+    ///        accesses x[i*lanes + l], y[i*lanes + l] and v[i*lanes + l].
+    ///
+    static std::string interleaveLanes(const std::string & body, const Eigen::DenseIndex lanes)
+    {
+      std::ostringstream res;
+      size_t pos = 0;
+      while(pos < body.size())
+      {
+        const char c = body[pos];
+        const bool is_array = (c == 'x' || c == 'y' || c == 'v')
+                              && (pos == 0 || !(std::isalnum((unsigned char)body[pos-1]) || body[pos-1] == '_'))
+                              && pos + 1 < body.size() && body[pos+1] == '[';
+        size_t end = pos + 2;
+        while(is_array && end < body.size() && std::isdigit((unsigned char)body[end])) ++end;
+        
+        if(is_array && end > pos + 2 && end < body.size() && body[end] == ']')
+        {
+          res << c << "[" << body.substr(pos+2,end-pos-2) << "*" << lanes << " + l]";
+          pos = end + 1;
+        }
+        else
+        {
+          res << c;
+          ++pos;
+        }
+      }
+      return res.str();
+    }
+    
+    static std::string typeName()
+    { return sizeof(Scalar) == sizeof(float) ? "float" : "double"; }
+    
+    template<int StorageOrder>
+    static Eigen::Map< Eigen::SparseMatrix<Scalar,StorageOrder,int> >
+    mapSparse(SparsityStructure & sparsity, VectorXs & values)
+    {
+      assert(sparsity.row_major == (StorageOrder == Eigen::RowMajor)
+             && "The storage order does not match the generated sparse structure.");
+      return Eigen::Map< Eigen::SparseMatrix<Scalar,StorageOrder,int> >(sparsity.rows,sparsity.cols,
+                                                                          (Eigen::DenseIndex)sparsity.nnz(),
+                                                                          sparsity.outer_index.data(),
+                                                                          sparsity.inner_index.data(),
+                                                                          values.data());
+    }
+    
     ADModel ad_model;
     ADData ad_data;
     
@@ -156,6 +742,24 @@ namespace pinocchio
     /// \brief Options to build or not the Jacobian of he function
     bool build_jacobian;
     
+    /// \brief Options to build or not the Hessian of the weighted sum of the outputs
+    bool build_hessian;
+    
+    /// \brief Options to build or not the sparse Jacobian of the function
+    bool build_sparse_jacobian;
+    
+    /// \brief Options to build or not the sparse Hessian of the weighted sum of the outputs
+    bool build_sparse_hessian;
+    
+    /// \brief Storage order of the sparse Jacobian and Hessian (CSR if true, CSC otherwise)
+    bool sparse_row_major;
+    
+    /// \brief Options to build or not the batched evaluation kernel
+    bool build_batch;
+    
+    /// \brief Number of samples evaluated together by the batched kernel
+    Eigen::DenseIndex batch_lanes;
+    
     ADVectorXs ad_X, ad_Y;
     ADFun ad_fun;
     
@@ -165,12 +769,26 @@ namespace pinocchio
     VectorXs y;
     RowMatrixXs jac;
     
+    /// \brief Output weights of the Hessian and the resulting dense Hessian
+    VectorXs w;
+    RowMatrixXs hess;
+    
+    SparsityStructure jac_sparsity, hess_sparsity;
+    VectorXs jac_values, hess_values;
+    
+    /// \brief Joint coupling matrices: joint_support(i,j) is true if joint i supports joint j or conversely,
+    ///        joint_tree(i,j) is true if joints i and j belong to the same subtree attached to the universe.
+    BoolMatrixXs joint_support, joint_tree;
+    
     std::unique_ptr<CppAD::cg::ModelCSourceGen<Scalar> > cgen_ptr;
     std::unique_ptr<CppAD::cg::ModelLibraryCSourceGen<Scalar> > libcgen_ptr;
     std::unique_ptr<CppAD::cg::DynamicModelLibraryProcessor<Scalar> > dynamicLibManager_ptr;
     std::unique_ptr<CppAD::cg::DynamicLib<Scalar> > dynamicLib_ptr;
     std::unique_ptr<CppAD::cg::GenericModel<Scalar> > generatedFun_ptr;
     
+    typedef void (*BatchFunction)(const Scalar *, Scalar *, unsigned long);
+    BatchFunction batchFun_ptr;
+    
   }; // struct CodeGenBase
   
 } // namespace pinocchio
@@ -36,6 +36,11 @@ namespace pinocchio
 /// \brief Empty macro argument
 #define PINOCCHIO_MACRO_EMPTY_ARG
 
+/// \brief Times the enclosing scope when PINOCCHIO_WITH_PROFILER is defined (see pinocchio/utils/profiler.hpp), expands to nothing otherwise.
+#ifndef PINOCCHIO_WITH_PROFILER
+  #define PINOCCHIO_PROFILER_SCOPE(name)
+#endif
+
 /// \brief Helper to declare that a parameter is unused
 #define PINOCCHIO_UNUSED_VARIABLE(var) (void)(var)
 
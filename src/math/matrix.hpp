@@ -17,5 +17,72 @@ namespace pinocchio
   }
 
 
+  ///
+  /// \brief Inverse of a symmetric invertible 3x3 matrix by its cofactors.
+  ///
+  /// \details The computation is branch-free and only reads the upper triangular part of A.
+  ///          The output is exactly symmetric.
+  ///
+  /// \param[in] A symmetric invertible 3x3 matrix.
+  /// \param[out] Ainv the inverse of A. It must not alias A.
+  ///
+  template<typename Matrix3Like, typename Matrix3LikeOut>
+  inline void inverseSymmetric3x3(const Eigen::MatrixBase<Matrix3Like> & A,
+                                  const Eigen::MatrixBase<Matrix3LikeOut> & Ainv)
+  {
+    EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Matrix3Like,3,3)
+    EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Matrix3LikeOut,3,3)
+    typedef typename Matrix3Like::Scalar Scalar;
+    Matrix3LikeOut & res = const_cast<Matrix3LikeOut &>(Ainv.derived());
+
+    const Scalar c00 = A(1,1)*A(2,2) - A(1,2)*A(1,2);
+    const Scalar c01 = A(0,2)*A(1,2) - A(0,1)*A(2,2);
+    const Scalar c02 = A(0,1)*A(1,2) - A(0,2)*A(1,1);
+    const Scalar c11 = A(0,0)*A(2,2) - A(0,2)*A(0,2);
+    const Scalar c12 = A(0,1)*A(0,2) - A(0,0)*A(1,2);
+    const Scalar c22 = A(0,0)*A(1,1) - A(0,1)*A(0,1);
+    const Scalar inv_det = Scalar(1) / (A(0,0)*c00 + A(0,1)*c01 + A(0,2)*c02);
+
+    res(0,0) = c00*inv_det;
+    res(1,1) = c11*inv_det;
+    res(2,2) = c22*inv_det;
+    res(0,1) = res(1,0) = c01*inv_det;
+    res(0,2) = res(2,0) = c02*inv_det;
+    res(1,2) = res(2,1) = c12*inv_det;
+  }
+
+  ///
+  /// \brief Inverse of a symmetric positive definite 6x6 matrix by 3x3 blocks.
+  ///
+  /// \details With A = [ A00 A01 ; A01^T A11 ], the inverse is obtained from the inverses of A00 and of its
+  ///          Schur complement S = A11 - A01^T A00^{-1} A01, both computed by inverseSymmetric3x3.
+  ///          The computation is branch-free and cheaper than a generic LLT solve for 6x6 matrices such as
+  ///          the articulated inertias.
+  ///
+  /// \param[in] A symmetric positive definite 6x6 matrix.
+  /// \param[out] Ainv the inverse of A. It must not alias A.
+  ///
+  template<typename Matrix6Like, typename Matrix6LikeOut>
+  inline void inverseSymmetric6x6(const Eigen::MatrixBase<Matrix6Like> & A,
+                                  const Eigen::MatrixBase<Matrix6LikeOut> & Ainv)
+  {
+    EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Matrix6Like,6,6)
+    EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Matrix6LikeOut,6,6)
+    typedef typename Matrix6Like::Scalar Scalar;
+    typedef Eigen::Matrix<Scalar,3,3> Matrix3;
+    Matrix6LikeOut & res = const_cast<Matrix6LikeOut &>(Ainv.derived());
+
+    Matrix3 A00_inv; inverseSymmetric3x3(A.template topLeftCorner<3,3>(),A00_inv);
+    Matrix3 A00_inv_A01; A00_inv_A01.noalias() = A00_inv * A.template topRightCorner<3,3>();
+    Matrix3 S(A.template bottomRightCorner<3,3>());
+    S.noalias() -= A.template topRightCorner<3,3>().transpose() * A00_inv_A01;
+
+    inverseSymmetric3x3(S,res.template bottomRightCorner<3,3>());
+    res.template topRightCorner<3,3>().noalias() = -A00_inv_A01 * res.template bottomRightCorner<3,3>();
+    res.template bottomLeftCorner<3,3>() = res.template topRightCorner<3,3>().transpose();
+    res.template topLeftCorner<3,3>() = A00_inv;
+    res.template topLeftCorner<3,3>().noalias() -= res.template topRightCorner<3,3>() * A00_inv_A01.transpose();
+  }
+
 }
 #endif //#ifndef __math_matrix_hpp__
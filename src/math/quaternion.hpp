@@ -91,6 +91,43 @@ namespace pinocchio
 #endif
     }
     
+    ///
+    /// \brief Write the rotation matrix of the unit quaternion q into R.
+    ///
+    /// \details Branch-free expansion of the quaternion product, written directly in the destination
+    ///          (no temporary rotation matrix as with quat.matrix()).
+    ///
+    /// \param[in] q input unit quaternion.
+    /// \param[out] R the corresponding rotation matrix.
+    ///
+    /// \warning q is assumed to be normalized.
+    ///
+    template<typename QuaternionLike, typename Matrix3Like>
+    void toRotationMatrix(const Eigen::QuaternionBase<QuaternionLike> & q,
+                          const Eigen::MatrixBase<Matrix3Like> & R)
+    {
+      EIGEN_STATIC_ASSERT_MATRIX_SPECIFIC_SIZE(Matrix3Like,3,3)
+      typedef typename QuaternionLike::Scalar Scalar;
+      Matrix3Like & R_ = EIGEN_CONST_CAST(Matrix3Like,R);
+
+      const Scalar tx = Scalar(2)*q.x();
+      const Scalar ty = Scalar(2)*q.y();
+      const Scalar tz = Scalar(2)*q.z();
+      const Scalar twx = tx*q.w(), twy = ty*q.w(), twz = tz*q.w();
+      const Scalar txx = tx*q.x(), txy = ty*q.x(), txz = tz*q.x();
+      const Scalar tyy = ty*q.y(), tyz = tz*q.y(), tzz = tz*q.z();
+
+      R_.coeffRef(0,0) = Scalar(1)-(tyy+tzz);
+      R_.coeffRef(0,1) = txy-twz;
+      R_.coeffRef(0,2) = txz+twy;
+      R_.coeffRef(1,0) = txy+twz;
+      R_.coeffRef(1,1) = Scalar(1)-(txx+tzz);
+      R_.coeffRef(1,2) = tyz-twx;
+      R_.coeffRef(2,0) = txz-twy;
+      R_.coeffRef(2,1) = tyz+twx;
+      R_.coeffRef(2,2) = Scalar(1)-(txx+tyy);
+    }
+
     /// Uniformly random quaternion sphere.
     template<typename Derived>
     void uniformRandom(const Eigen::QuaternionBase<Derived> & q)
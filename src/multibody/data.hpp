@@ -8,6 +8,7 @@
 
 #include "pinocchio/spatial/fwd.hpp"
 #include "pinocchio/spatial/se3.hpp"
+#include "pinocchio/spatial/se3-quaternion.hpp"
 #include "pinocchio/spatial/force.hpp"
 #include "pinocchio/spatial/motion.hpp"
 #include "pinocchio/spatial/inertia.hpp"
@@ -34,6 +35,7 @@ namespace pinocchio
     typedef ModelTpl<Scalar,Options,JointCollectionTpl> Model;
     
     typedef SE3Tpl<Scalar,Options> SE3;
+    typedef SE3QuaternionTpl<Scalar,Options> SE3Quaternion;
     typedef MotionTpl<Scalar,Options> Motion;
     typedef ForceTpl<Scalar,Options> Force;
     typedef InertiaTpl<Scalar,Options> Inertia;
@@ -45,6 +47,10 @@ namespace pinocchio
     typedef pinocchio::FrameIndex FrameIndex;
     typedef std::vector<Index> IndexVector;
     
+    /// \brief Range of contiguous columns, stored as (first column, number of columns).
+    typedef std::pair<int,int> ColumnSpan;
+    typedef std::vector<ColumnSpan> ColumnSpanVector;
+    
     typedef JointModelTpl<Scalar,Options,JointCollectionTpl> JointModel;
     typedef JointDataTpl<Scalar,Options,JointCollectionTpl> JointData;
     
@@ -108,6 +114,11 @@ namespace pinocchio
 
     /// \brief Vector of relative joint placements (wrt the body parent).
     container::aligned_vector<SE3> liMi;
+
+    /// \brief Vector of absolute joint placements (wrt the world) in the quaternion representation.
+    ///        It is only filled by forwardKinematicsQuaternion and is left untouched by the other algorithms.
+    ///        It is empty until the first call to forwardKinematicsQuaternion.
+    container::aligned_vector<SE3Quaternion> oMi_quat;
     
     /// \brief Vector of joint torques (dim model.nv).
     TangentVectorType tau;
@@ -125,6 +136,10 @@ namespace pinocchio
     /// \brief Vector of absolute operationnel frame placements (wrt the world).
     container::aligned_vector<SE3> oMf;
 
+    /// \brief Vector of absolute operationnel frame placements (wrt the world) in the quaternion representation.
+    ///        It is only filled by updateFramePlacementsQuaternion, and is empty until its first call.
+    container::aligned_vector<SE3Quaternion> oMf_quat;
+
     /// \brief Vector of sub-tree composite rigid body inertias, i.e. the apparent inertia of the subtree supported by the joint
     ///        and expressed in the local frame of the joint..
     container::aligned_vector<Inertia> Ycrb;
@@ -240,6 +255,10 @@ namespace pinocchio
     /// \brief Subtree of the current row index (used in Cholesky Decomposition).
     std::vector<int> nvSubtree_fromRow;
     
+    /// \brief Columns of the joints supporting the joint *i* (*i* included), merged into contiguous spans sorted by
+    ///        increasing column (used by the Jacobian and Cholesky kernels to traverse the supports by blocks).
+    std::vector<ColumnSpanVector> supportSpans;
+    
     /// \brief Jacobian of joint placements.
     /// \note The columns of J corresponds to the basis of the spatial velocities of each joint and expressed at the origin of the inertial frame. In other words, if \f$ v_{J_{i}} = S_{i} \dot{q}_{i}\f$ is the relative velocity of the joint i regarding to its parent, then \f$J = \begin{bmatrix} ^{0}X_{1} S_{1} & \cdots & ^{0}X_{i} S_{i} & \cdots & ^{0}X_{\text{nj}} S_{\text{nj}} \end{bmatrix} \f$. This Jacobian has no special meaning. To get the jacobian of a precise joint, you need to call pinocchio::getJointJacobian
     Matrix6x J;
@@ -330,6 +349,7 @@ namespace pinocchio
   private:
     void computeLastChild(const Model & model);
     void computeParents_fromRow(const Model & model);
+    void computeSupportSpans(const Model & model);
 
   };
 
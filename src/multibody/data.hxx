@@ -34,10 +34,12 @@ namespace pinocchio
   , oh((std::size_t)model.njoints)
   , oMi((std::size_t)model.njoints)
   , liMi((std::size_t)model.njoints)
+  , oMi_quat()
   , tau(model.nv)
   , nle(model.nv)
   , g(model.nv)
   , oMf((std::size_t)model.nframes)
+  , oMf_quat()
   , Ycrb((std::size_t)model.njoints)
   , dYcrb((std::size_t)model.njoints)
   , M(model.nv,model.nv)
@@ -67,6 +69,7 @@ namespace pinocchio
   , tmp(model.nv)
   , parents_fromRow((std::size_t)model.nv)
   , nvSubtree_fromRow((std::size_t)model.nv)
+  , supportSpans((std::size_t)model.njoints)
   , J(6,model.nv)
   , dJ(6,model.nv)
   , dVdq(6,model.nv)
@@ -107,9 +110,13 @@ namespace pinocchio
     /* Init for Coriolis */
     C.setZero();
 
+    /* Init for the dynamics derivatives */
+    dFdq.setZero(); dFdv.setZero(); dFda.setZero();
+
     /* Init for Cholesky */
     U.setIdentity();
     computeParents_fromRow(model);
+    computeSupportSpans(model);
 
     /* Init Jacobian */
     J.setZero();
@@ -175,6 +182,30 @@ namespace pinocchio
     }
   }
 
+  template<typename Scalar, int Options, template<typename,int> class JointCollectionTpl>
+  inline void DataTpl<Scalar,Options,JointCollectionTpl>
+  ::computeSupportSpans(const Model & model)
+  {
+    typedef typename Model::Index Index;
+    
+    for(Index joint=1;joint<(Index)(model.njoints);joint++)
+    {
+      const Index & parent = model.parents[joint];
+      const int nvj    = nv   (model.joints[joint]);
+      const int idx_vj = idx_v(model.joints[joint]);
+      
+      ColumnSpanVector & spans = supportSpans[joint];
+      spans = supportSpans[parent];
+      if(nvj == 0) continue;
+      
+      // Serial chains numbered depth-first extend the last span of their parent.
+      if(!spans.empty() && spans.back().first + spans.back().second == idx_vj)
+        spans.back().second += nvj;
+      else
+        spans.push_back(ColumnSpan(idx_vj,nvj));
+    }
+  }
+
 } // namespace pinocchio
 
 /// @endcond
@@ -7,6 +7,7 @@
 
 #include "pinocchio/multibody/fcl.hpp"
 #include "pinocchio/multibody/model.hpp"
+#include "pinocchio/spatial/se3-quaternion.hpp"
 #include "pinocchio/container/aligned-vector.hpp"
 
 #include <iostream>
@@ -189,6 +190,7 @@ namespace pinocchio
     enum { Options = 0 };
     
     typedef SE3Tpl<Scalar,Options> SE3;
+    typedef SE3QuaternionTpl<Scalar,Options> SE3Quaternion;
     
     ///
     /// \brief Vector gathering the SE3 placements of the geometry objects relative to the world.
@@ -199,6 +201,21 @@ namespace pinocchio
     ///
     container::aligned_vector<SE3> oMg;
 
+    ///
+    /// \brief Placements of the geometry objects relative to the world in the quaternion representation.
+    ///        They are only updated by updateGeometryPlacementsQuaternion, which leaves oMg untouched.
+    ///        The vector is allocated by the first call to updateGeometryPlacementsQuaternion.
+    ///
+    container::aligned_vector<SE3Quaternion> oMg_quat;
+
+    ///
+    /// \brief Indexes of the geometry objects which are not attached to the universe.
+    ///
+    /// The objects attached to the universe are placed by the constructor of GeometryData.
+    /// Only the objects listed here are updated by the multi-threaded updateGeometryPlacements.
+    ///
+    std::vector<GeomIndex> movingObjects;
+
 #ifdef PINOCCHIO_WITH_HPP_FCL
     ///
     /// \brief Collision objects (ie a fcl placed geometry).
@@ -222,6 +239,21 @@ namespace pinocchio
     /// \brief Vector gathering the result of the distance computation for all the collision pairs.
     ///
     std::vector<fcl::DistanceResult> distanceResults;
+
+    ///
+    /// \brief Placements of the two geometry objects of each collision pair (at index 2*pairId and 2*pairId+1)
+    ///        when its distance was last computed by fcl.
+    ///
+    container::aligned_vector<SE3> distancePlacements;
+
+    ///
+    /// \brief Lower bounds on the distance of each collision pair.
+    ///
+    /// It equals distanceResults[pairId].min_distance right after computeDistance(geomModel,geomData,pairId),
+    /// and is decreased by the motion of the objects when computeDistances skips the pair.
+    /// It is minus infinity as long as the distance of the pair has never been computed.
+    ///
+    std::vector<double> distanceLowerBounds;
     
     ///
     /// \brief Defines what information should be computed by collision test.
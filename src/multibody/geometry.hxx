@@ -9,6 +9,7 @@
 #include <map>
 #include <list>
 #include <utility>
+#include <limits>
 
 /// @cond DEV
 
@@ -16,27 +17,45 @@ namespace pinocchio
 {
   inline GeometryData::GeometryData(const GeometryModel & modelGeom)
   : oMg(modelGeom.ngeoms)
-  
+  , oMg_quat()
+  , movingObjects()
 #ifdef PINOCCHIO_WITH_HPP_FCL
   , activeCollisionPairs(modelGeom.collisionPairs.size(), true)
   , distanceRequest (true, 0, 0, fcl::GST_INDEP)
   , distanceResults(modelGeom.collisionPairs.size())
+  , distancePlacements(2*modelGeom.collisionPairs.size())
+  , distanceLowerBounds(modelGeom.collisionPairs.size(), -std::numeric_limits<double>::infinity())
   , collisionRequest (1, false, false, 1, false, true, fcl::GST_INDEP)
   , collisionResults(modelGeom.collisionPairs.size())
   , radius()
   , collisionPairIndex(0)
   , innerObjects()
   , outerObjects()
+#endif // PINOCCHIO_WITH_HPP_FCL
   {
+#ifdef PINOCCHIO_WITH_HPP_FCL
     collisionObjects.reserve(modelGeom.geometryObjects.size());
     BOOST_FOREACH( const GeometryObject & geom, modelGeom.geometryObjects)
     { collisionObjects.push_back
       (fcl::CollisionObject(geom.fcl)); }
     fillInnerOuterObjectMaps(modelGeom);
+#endif // PINOCCHIO_WITH_HPP_FCL
+
+    // The objects attached to the universe are placed once and for all.
+    for(GeomIndex i = 0; i < (GeomIndex)modelGeom.ngeoms; ++i)
+    {
+      const GeometryObject & geom = modelGeom.geometryObjects[i];
+      if(geom.parentJoint > 0)
+      {
+        movingObjects.push_back(i);
+        continue;
+      }
+      oMg[i] = geom.placement;
+#ifdef PINOCCHIO_WITH_HPP_FCL
+      collisionObjects[i].setTransform(toFclTransform3f(oMg[i]));
+#endif // PINOCCHIO_WITH_HPP_FCL
+    }
   }
-#else
-  {}
-#endif // PINOCCHIO_WITH_HPP_FCL   
   
   template<typename S2, int O2, template<typename,int> class JointCollectionTpl>
   GeomIndex GeometryModel::addGeometryObject(const GeometryObject & object,
@@ -10,6 +10,7 @@
 #include "pinocchio/multibody/joint/joint-basic-visitors.hpp"
 #include "pinocchio/container/aligned-vector.hpp"
 #include "pinocchio/spatial/act-on-set.hpp"
+#include "pinocchio/math/matrix.hpp"
 
 namespace pinocchio
 {
@@ -82,7 +83,9 @@ namespace pinocchio
     , StU(nv,nv)
     {}
     
-    /// \brief Vector of joints
+    /// \brief Vector of joints.
+    /// \warning They are not updated by calc when the joint model is flattened
+    ///          (see JointModelCompositeTpl::isFlattened) and must not be read in that case.
     JointDataVector joints;
    
     /// \brief Transforms from previous joint to last joint
@@ -127,6 +130,7 @@ namespace pinocchio
     typedef SE3Tpl<Scalar,Options> SE3;
     typedef MotionTpl<Scalar,Options> Motion;
     typedef InertiaTpl<Scalar,Options> Inertia;
+    typedef Eigen::Matrix<Scalar,3,1,Options> Vector3;
   
     typedef container::aligned_vector<JointModelVariant> JointModelVector;
     
@@ -143,6 +147,7 @@ namespace pinocchio
     , jointPlacements()
     , m_nq(0)
     , m_nv(0)
+    , m_flattened(false)
     , njoints(0)
     {}
     
@@ -152,11 +157,13 @@ namespace pinocchio
     , jointPlacements()
     , m_nq(0)
     , m_nv(0)
+    , m_flattened(false)
     , njoints(0)
     {
       joints.reserve(size); jointPlacements.reserve(size);
       m_idx_q.reserve(size); m_idx_v.reserve(size);
       m_nqs.reserve(size); m_nvs.reserve(size);
+      m_flat_axes.reserve(size); m_flat_revolute.reserve(size);
     }
     
     ///
@@ -174,6 +181,7 @@ namespace pinocchio
     , m_nv(jmodel.nv())
     , m_idx_q(1,0), m_nqs(1,jmodel.nq())
     , m_idx_v(1,0), m_nvs(1,jmodel.nv())
+    , m_flattened(false)
     , njoints(1)
     {}
     
@@ -190,6 +198,8 @@ namespace pinocchio
     , m_nv(other.m_nv)
     , m_idx_q(other.m_idx_q), m_nqs(other.m_nqs)
     , m_idx_v(other.m_idx_v), m_nvs(other.m_nvs)
+    , m_flattened(other.m_flattened)
+    , m_flat_axes(other.m_flat_axes), m_flat_revolute(other.m_flat_revolute)
     , njoints(other.njoints)
     {}
     
@@ -202,6 +212,8 @@ namespace pinocchio
     ///
     /// \return A reference to *this
     ///
+    /// \note The flat representation is only built by setIndexes (see isFlattened).
+    ///
     template<typename JointModel>
     JointModelDerived & addJoint(const JointModelBase<JointModel> & jmodel,
                                  const SE3 & placement = SE3::Identity())
@@ -245,13 +257,31 @@ namespace pinocchio
       data.U.noalias() = I * data.S.matrix();
       data.StU.noalias() = data.S.matrix().transpose() * data.U;
       
-      // compute inverse
-      data.Dinv.setIdentity();
-      data.StU.llt().solveInPlace(data.Dinv);
+      // compute inverse, in closed form for the common stacks of one to three degrees of freedom
+      switch(m_nv)
+      {
+        case 1:
+          data.Dinv(0,0) = Scalar(1) / data.StU(0,0);
+          break;
+        case 2:
+        {
+          const Scalar inv_det = Scalar(1) / (data.StU(0,0)*data.StU(1,1) - data.StU(0,1)*data.StU(0,1));
+          data.Dinv(0,0) = data.StU(1,1)*inv_det;
+          data.Dinv(1,1) = data.StU(0,0)*inv_det;
+          data.Dinv(0,1) = data.Dinv(1,0) = -data.StU(0,1)*inv_det;
+          break;
+        }
+        case 3:
+          inverseSymmetric3x3(data.StU.template topLeftCorner<3,3>(),data.Dinv.template topLeftCorner<3,3>());
+          break;
+        default:
+          data.Dinv.setIdentity();
+          data.StU.llt().solveInPlace(data.Dinv);
+      }
       data.UDinv.noalias() = data.U * data.Dinv;
 
       if (update_I)
-        EIGEN_CONST_CAST(Matrix6Like,I) -= data.UDinv * data.U.transpose();
+        EIGEN_CONST_CAST(Matrix6Like,I).noalias() -= data.UDinv * data.U.transpose();
     }
 
     Scalar finiteDifferenceIncrement() const
@@ -269,12 +299,13 @@ namespace pinocchio
     int nq_impl() const { return m_nq; }
 
     /**
-     * @brief      Update the indexes of subjoints in the stack 
+     * @brief      Update the indexes of subjoints in the stack and rebuild the flat representation.
      */
     void setIndexes_impl(JointIndex id, int q, int v)
     {
       Base::setIndexes_impl(id, q, v);
       updateJointIndexes();
+      updateFlatRepresentation();
     }
 
     static std::string classname() { return std::string("JointModelComposite"); }
@@ -289,6 +320,9 @@ namespace pinocchio
       m_idx_v = other.m_idx_v;
       m_nqs = other.m_nqs;
       m_nvs = other.m_nvs;
+      m_flattened = other.m_flattened;
+      m_flat_axes = other.m_flat_axes;
+      m_flat_revolute = other.m_flat_revolute;
       joints = other.joints;
       jointPlacements = other.jointPlacements;
       njoints = other.njoints;
@@ -317,7 +351,6 @@ namespace pinocchio
     {
       typedef JointModelCompositeTpl<NewScalar,Options,JointCollectionTpl> ReturnType;
       ReturnType res((size_t)njoints);
-      res.setIndexes(id(),idx_q(),idx_v());
       res.m_nq = m_nq;
       res.m_nv = m_nv;
       res.m_idx_q = m_idx_q;
@@ -333,6 +366,7 @@ namespace pinocchio
         res.joints[k] = joints[k].template cast<NewScalar>();
         res.jointPlacements[k] = jointPlacements[k].template cast<NewScalar>();
       }
+      res.setIndexes(id(),idx_q(),idx_v());
       
       return res;
     }
@@ -342,6 +376,18 @@ namespace pinocchio
     /// \brief Vector of joint placements. Those placements correspond to the origin of the joint relatively to their parent.
     container::aligned_vector<SE3> jointPlacements;
 
+    ///
+    /// \brief Returns true if the composite is executed through its flat representation.
+    ///
+    /// \details It is the case when all the joints contained in the composite are 1-DoF revolute or prismatic joints
+    ///          (e.g. universal joints or gimbals built as stacks of revolute joints). calc then runs over the axes of
+    ///          the joints, without visiting their variants, and the data of the joints (JointDataCompositeTpl::joints)
+    ///          are left untouched.
+    ///          The flat representation is built by setIndexes, which is called by ModelTpl::addJoint. It must be
+    ///          called again if joints is modified afterwards, as for the other index tables of the composite.
+    ///
+    bool isFlattened() const { return m_flattened; }
+
     template<typename D>
     typename SizeDepType<NQ>::template SegmentReturn<D>::ConstType
     jointConfigSelector(const Eigen::MatrixBase<D>& a) const { return a.segment(Base::i_q,nq()); }
@@ -411,6 +457,18 @@ namespace pinocchio
         idx_q += m_nqs[i]; idx_v += m_nvs[i];
       }
     }
+
+    /// \brief Update the flat representation of the composition, see isFlattened.
+    void updateFlatRepresentation();
+
+    /// \brief Computes the transformation of the i-th joint of the flat representation for the configuration qi.
+    void flatJointTransform(const size_t i, const Scalar & qi, SE3 & M) const;
+
+    /// \brief Motion subspace of the i-th joint of the flat representation, expressed in its own frame.
+    Motion flatJointMotionAxis(const size_t i) const;
+
+    /// \brief Zero order step of calc on the flat representation.
+    void calcFlatStep(const size_t i, JointDataDerived & data, const Scalar & qi) const;
     
     
     /// \brief Dimensions of the config and tangent space of the composite joint.
@@ -426,6 +484,13 @@ namespace pinocchio
     std::vector<int> m_idx_v;
     /// \brief Dimension of the segment in the tangent vector
     std::vector<int> m_nvs;
+
+    /// \brief True if the composition is executed through its flat representation.
+    bool m_flattened;
+    /// \brief Axes of the joints in the flat representation.
+    container::aligned_vector<Vector3> m_flat_axes;
+    /// \brief Nature of the joints in the flat representation (revolute or prismatic).
+    std::vector<bool> m_flat_revolute;
     
   public:
     /// \brief Number of joints contained in the JointModelComposite
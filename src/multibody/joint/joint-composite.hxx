@@ -6,10 +6,114 @@
 #define __pinocchio_joint_composite_hxx__
 
 #include "pinocchio/multibody/visitor.hpp"
+#include "pinocchio/spatial/skew.hpp"
+#include "pinocchio/math/sincos.hpp"
 
 namespace pinocchio 
 {
 
+  ///
+  /// \brief Visitor returning the nature of a joint for the flat representation of JointModelCompositeTpl,
+  ///        and storing its axis.
+  ///
+  template<typename Scalar, int Options>
+  struct JointCompositeFlatAxisVisitor
+  : public boost::static_visitor<int>
+  {
+    enum { NOT_FLAT, REVOLUTE, PRISMATIC };
+    typedef Eigen::Matrix<Scalar,3,1,Options> Vector3;
+
+    explicit JointCompositeFlatAxisVisitor(Vector3 & axis) : axis(axis) {}
+
+    template<typename JointModel>
+    int operator()(const JointModelBase<JointModel> &) const
+    { return NOT_FLAT; }
+
+    template<int axis_id>
+    int operator()(const JointModelRevoluteTpl<Scalar,Options,axis_id> &) const
+    { axis = Vector3::Unit(axis_id); return REVOLUTE; }
+
+    int operator()(const JointModelRevoluteUnalignedTpl<Scalar,Options> & jmodel) const
+    { axis = jmodel.axis; return REVOLUTE; }
+
+    template<int axis_id>
+    int operator()(const JointModelPrismaticTpl<Scalar,Options,axis_id> &) const
+    { axis = Vector3::Unit(axis_id); return PRISMATIC; }
+
+    int operator()(const JointModelPrismaticUnalignedTpl<Scalar,Options> & jmodel) const
+    { axis = jmodel.axis; return PRISMATIC; }
+
+    Vector3 & axis;
+  };
+
+  template<typename Scalar, int Options, template<typename S, int O> class JointCollectionTpl>
+  inline void JointModelCompositeTpl<Scalar,Options,JointCollectionTpl>::updateFlatRepresentation()
+  {
+    typedef JointCompositeFlatAxisVisitor<Scalar,Options> Visitor;
+
+    m_flat_axes.resize(joints.size());
+    m_flat_revolute.resize(joints.size());
+    m_flattened = joints.size() > 0;
+    for(size_t i = 0; i < joints.size(); ++i)
+    {
+      const int type = boost::apply_visitor(Visitor(m_flat_axes[i]),joints[i]);
+      m_flat_revolute[i] = (type == Visitor::REVOLUTE);
+      m_flattened = m_flattened && (type != Visitor::NOT_FLAT);
+    }
+  }
+
+  template<typename Scalar, int Options, template<typename S, int O> class JointCollectionTpl>
+  inline void JointModelCompositeTpl<Scalar,Options,JointCollectionTpl>::
+  flatJointTransform(const size_t i, const Scalar & qi, SE3 & M) const
+  {
+    const Vector3 & axis = m_flat_axes[i];
+    if(m_flat_revolute[i])
+    {
+      Scalar sa, ca; SINCOS(qi,&sa,&ca);
+      M.rotation().noalias() = (Scalar(1) - ca) * axis * axis.transpose();
+      M.rotation().diagonal().array() += ca;
+      addSkew(sa * axis, M.rotation());
+      M.translation().setZero();
+    }
+    else
+    {
+      M.rotation().setIdentity();
+      M.translation() = qi * axis;
+    }
+  }
+
+  template<typename Scalar, int Options, template<typename S, int O> class JointCollectionTpl>
+  inline typename JointModelCompositeTpl<Scalar,Options,JointCollectionTpl>::Motion
+  JointModelCompositeTpl<Scalar,Options,JointCollectionTpl>::flatJointMotionAxis(const size_t i) const
+  {
+    if(m_flat_revolute[i])
+      return Motion(Vector3::Zero(),m_flat_axes[i]);
+    else
+      return Motion(m_flat_axes[i],Vector3::Zero());
+  }
+
+  template<typename Scalar, int Options, template<typename S, int O> class JointCollectionTpl>
+  inline void JointModelCompositeTpl<Scalar,Options,JointCollectionTpl>::
+  calcFlatStep(const size_t i, JointDataDerived & data, const Scalar & qi) const
+  {
+    const size_t succ = i+1; // successor
+    const int idx_v = m_idx_v[i] - m_idx_v[0];
+
+    SE3 jM; flatJointTransform(i,qi,jM);
+    data.pjMi[i] = jointPlacements[i] * jM;
+
+    if(succ == joints.size())
+    {
+      data.iMlast[i] = data.pjMi[i];
+      data.S.matrix().col(idx_v) = flatJointMotionAxis(i).toVector();
+    }
+    else
+    {
+      data.iMlast[i] = data.pjMi[i] * data.iMlast[succ];
+      data.S.matrix().col(idx_v) = data.iMlast[succ].actInv(flatJointMotionAxis(i)).toVector();
+    }
+  }
+
   template<typename Scalar, int Options, template<typename S, int O> class JointCollectionTpl, typename ConfigVectorType>
   struct JointCompositeCalcZeroOrderStep
   : fusion::JointVisitorBase< JointCompositeCalcZeroOrderStep<Scalar,Options,JointCollectionTpl,ConfigVectorType> >
@@ -61,6 +165,14 @@ namespace pinocchio
     assert(joints.size() > 0);
     assert(data.joints.size() == joints.size());
     
+    if(m_flattened)
+    {
+      for (int i=(int)(joints.size()-1); i >= 0; --i)
+        calcFlatStep((size_t)i,data,qs[m_idx_q[(size_t)i]]);
+      data.M = data.iMlast.front();
+      return;
+    }
+    
     typedef JointCompositeCalcZeroOrderStep<Scalar,Options,JointCollectionTpl,ConfigVectorType> Algo;
 
     for (int i=(int)(joints.size()-1); i >= 0; --i)
@@ -136,6 +248,29 @@ namespace pinocchio
     assert(joints.size() > 0);
     assert(jdata.joints.size() == joints.size());
     
+    if(m_flattened)
+    {
+      for (int i=(int)(joints.size()-1); i >= 0; --i)
+      {
+        calcFlatStep((size_t)i,jdata,qs[m_idx_q[(size_t)i]]);
+        
+        const int idx_v = m_idx_v[(size_t)i] - m_idx_v[0];
+        const Motion v_tmp(jdata.S.matrix().col(idx_v) * vs[m_idx_v[(size_t)i]]);
+        if((size_t)i == joints.size()-1)
+        {
+          jdata.v = v_tmp;
+          jdata.c.setZero();
+        }
+        else
+        {
+          jdata.v += v_tmp;
+          jdata.c -= jdata.v.cross(v_tmp);
+        }
+      }
+      jdata.M = jdata.iMlast.front();
+      return;
+    }
+    
     typedef JointCompositeCalcFirstOrderStep<Scalar,Options,JointCollectionTpl,ConfigVectorType,TangentVectorType> Algo;
 
     for (int i=(int)(joints.size()-1); i >= 0; --i)
@@ -13,6 +13,7 @@
 #include "pinocchio/multibody/constraint.hpp"
 #include "pinocchio/math/fwd.hpp"
 #include "pinocchio/math/quaternion.hpp"
+#include "pinocchio/math/matrix.hpp"
 
 namespace pinocchio
 {
@@ -232,7 +233,7 @@ namespace pinocchio
       //assert(math::fabs(quat.coeffs().squaredNorm()-1.) <= sqrt(Eigen::NumTraits<typename V::Scalar>::epsilon())); TODO: check validity of the rhs precision
       assert(math::fabs(quat.coeffs().squaredNorm()-1.) <= 1e-4);
       
-      M.rotation(quat.matrix());
+      quaternion::toRotationMatrix(quat,M.rotation());
       M.translation(q_joint.template head<3>());
     }
     
@@ -245,10 +246,10 @@ namespace pinocchio
       typedef Eigen::Map<const Quaternion> ConstQuaternionMap;
       
       typename ConfigVector::template ConstFixedSegmentReturnType<NQ>::Type q = qs.template segment<NQ>(idx_q());
-      data.M.translation(q.template head<3>());
+      data.M.translation() = q.template head<3>();
       
       ConstQuaternionMap quat(q.template tail<4>().data());
-      data.M.rotation(quat.matrix());
+      quaternion::toRotationMatrix(quat,data.M.rotation());
     }
     
     template<typename ConfigVector, typename TangentVector>
@@ -265,9 +266,9 @@ namespace pinocchio
     template<typename Matrix6Like>
     void calc_aba(JointDataDerived & data, const Eigen::MatrixBase<Matrix6Like> & I, const bool update_I) const
     {
+      // S is the identity: U = I, Dinv = I^{-1} and UDinv remains the identity set by the constructor.
       data.U = I;
-      data.Dinv.setIdentity();
-      I.llt().solveInPlace(data.Dinv);
+      inverseSymmetric6x6(I,data.Dinv);
       
       if (update_I)
         EIGEN_CONST_CAST(Matrix6Like,I).setZero();
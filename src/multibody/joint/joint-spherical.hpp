@@ -10,6 +10,8 @@
 #include "pinocchio/multibody/joint/joint-base.hpp"
 #include "pinocchio/multibody/constraint.hpp"
 #include "pinocchio/math/sincos.hpp"
+#include "pinocchio/math/quaternion.hpp"
+#include "pinocchio/math/matrix.hpp"
 #include "pinocchio/spatial/inertia.hpp"
 #include "pinocchio/spatial/skew.hpp"
 
@@ -386,7 +388,10 @@ namespace pinocchio
     D_t Dinv;
     UD_t UDinv;
 
-    JointDataSphericalTpl () : M(1), U(), Dinv(), UDinv() {}
+    JointDataSphericalTpl () : M(1), U(), Dinv(), UDinv()
+    {
+      UDinv.template middleRows<3>(Inertia::ANGULAR).setIdentity();
+    }
 
   }; // struct JointDataSphericalTpl
 
@@ -419,7 +424,7 @@ namespace pinocchio
       //assert(math::fabs(quat.coeffs().squaredNorm()-1.) <= sqrt(Eigen::NumTraits<typename V::Scalar>::epsilon())); TODO: check validity of the rhs precision
       assert(math::fabs(quat.coeffs().squaredNorm()-1.) <= 1e-4);
       
-      M.rotation(quat.matrix());
+      quaternion::toRotationMatrix(quat,M.rotation());
       M.translation().setZero();
     }
 
@@ -433,7 +438,7 @@ namespace pinocchio
       typename ConfigVector::template ConstFixedSegmentReturnType<NQ>::Type & q = qs.template segment<NQ>(idx_q());
       
       ConstQuaternionMap quat(q.data());
-      data.M.rotation(quat.matrix());
+      quaternion::toRotationMatrix(quat,data.M.rotation());
     }
 
     template<typename ConfigVector, typename TangentVector>
@@ -452,10 +457,9 @@ namespace pinocchio
       data.U = I.template block<6,3>(0,Inertia::ANGULAR);
       
       // compute inverse
-      data.Dinv.setIdentity();
-      data.U.template middleRows<3>(Inertia::ANGULAR).llt().solveInPlace(data.Dinv);
+      inverseSymmetric3x3(data.U.template middleRows<3>(Inertia::ANGULAR),data.Dinv);
       
-      data.UDinv.template middleRows<3>(Inertia::ANGULAR).setIdentity(); // can be put in data constructor
+      // the angular rows of UDinv are the identity, set by the constructor
       data.UDinv.template middleRows<3>(Inertia::LINEAR).noalias() = data.U.template block<3,3>(Inertia::LINEAR, 0) * data.Dinv;
       
       if (update_I)
@@ -242,6 +242,43 @@ namespace pinocchio
   
   SE3_DETAILS_DISPATCH_JOINT_COMPOSITE_3(DifferenceStepAlgo);
   
+  template<typename Visitor, typename JointModel> struct dDifferenceStepAlgo;
+  
+  template<typename LieGroup_t, typename ConfigVectorIn1, typename ConfigVectorIn2, typename JacobianMatrixType>
+  struct dDifferenceStep
+  : public fusion::JointVisitorBase< dDifferenceStep<LieGroup_t,ConfigVectorIn1,ConfigVectorIn2,JacobianMatrixType> >
+  {
+    typedef boost::fusion::vector<const ConfigVectorIn1 &,
+                                  const ConfigVectorIn2 &,
+                                  JacobianMatrixType &,
+                                  const ArgumentPosition &
+                                  > ArgsType;
+    
+    SE3_DETAILS_VISITOR_METHOD_ALGO_4(dDifferenceStepAlgo, dDifferenceStep)
+  };
+  
+  template<typename Visitor, typename JointModel>
+  struct dDifferenceStepAlgo
+  {
+    template<typename ConfigVectorIn1, typename ConfigVectorIn2, typename JacobianMatrixType>
+    static void run(const JointModelBase<JointModel> & jmodel,
+                    const Eigen::MatrixBase<ConfigVectorIn1> & q0,
+                    const Eigen::MatrixBase<ConfigVectorIn2> & q1,
+                    const Eigen::MatrixBase<JacobianMatrixType> & mat,
+                    const ArgumentPosition & arg)
+    {
+      typedef typename Visitor::LieGroupMap LieGroupMap;
+      
+      typename LieGroupMap::template operation<JointModel>::type lgo;
+      lgo.dDifference(jmodel.jointConfigSelector(q0.derived()),
+                      jmodel.jointConfigSelector(q1.derived()),
+                      jmodel.jointBlock(EIGEN_CONST_CAST(JacobianMatrixType,mat)),
+                      arg);
+    }
+  };
+  
+  SE3_DETAILS_DISPATCH_JOINT_COMPOSITE_4(dDifferenceStepAlgo);
+  
   template<typename Visitor, typename JointModel> struct SquaredDistanceStepAlgo;
   
   template<typename LieGroup_t, typename ConfigVectorIn1, typename ConfigVectorIn2, typename DistanceVectorOut>
@@ -431,6 +468,306 @@ namespace pinocchio
   
   SE3_DETAILS_DISPATCH_JOINT_COMPOSITE_2(IntegrateCoeffWiseJacobianStepAlgo);
   
+  namespace details
+  {
+    ///
+    /// \brief Applies the operations of a Lie group to a set of configurations stored column-wise.
+    ///
+    /// \details The generic version loops over the columns. The vector space operations act on the whole
+    ///          set at once, so that the joints of dimension one (revolute, prismatic) are vectorized over time.
+    ///
+    template<typename LieGroup>
+    struct TrajectoryOperation
+    {
+      template<typename ConfigMatrixIn, typename TangentMatrixIn, typename ConfigMatrixOut>
+      static void integrate(const LieGroup & lgo,
+                            const Eigen::MatrixBase<ConfigMatrixIn> & Q,
+                            const Eigen::MatrixBase<TangentMatrixIn> & V,
+                            const Eigen::MatrixBase<ConfigMatrixOut> & Qout)
+      {
+        ConfigMatrixOut & Qout_ = EIGEN_CONST_CAST(ConfigMatrixOut,Qout);
+        for(Eigen::DenseIndex t = 0; t < Q.cols(); ++t)
+          lgo.integrate(Q.col(t),V.col(t),Qout_.col(t));
+      }
+      
+      template<typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename TangentMatrixOut>
+      static void difference(const LieGroup & lgo,
+                             const Eigen::MatrixBase<ConfigMatrixIn1> & Q0,
+                             const Eigen::MatrixBase<ConfigMatrixIn2> & Q1,
+                             const Eigen::MatrixBase<TangentMatrixOut> & Vout)
+      {
+        TangentMatrixOut & Vout_ = EIGEN_CONST_CAST(TangentMatrixOut,Vout);
+        for(Eigen::DenseIndex t = 0; t < Q0.cols(); ++t)
+          lgo.difference(Q0.col(t),Q1.col(t),Vout_.col(t));
+      }
+      
+      template<typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename Scalar, typename ConfigMatrixOut>
+      static void interpolate(const LieGroup & lgo,
+                              const Eigen::MatrixBase<ConfigMatrixIn1> & Q0,
+                              const Eigen::MatrixBase<ConfigMatrixIn2> & Q1,
+                              const Scalar & u,
+                              const Eigen::MatrixBase<ConfigMatrixOut> & Qout)
+      {
+        ConfigMatrixOut & Qout_ = EIGEN_CONST_CAST(ConfigMatrixOut,Qout);
+        for(Eigen::DenseIndex t = 0; t < Q0.cols(); ++t)
+          lgo.interpolate(Q0.col(t),Q1.col(t),u,Qout_.col(t));
+      }
+      
+      template<typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename DistanceRowOut>
+      static void squaredDistance(const LieGroup & lgo,
+                                  const Eigen::MatrixBase<ConfigMatrixIn1> & Q0,
+                                  const Eigen::MatrixBase<ConfigMatrixIn2> & Q1,
+                                  const Eigen::MatrixBase<DistanceRowOut> & distances)
+      {
+        DistanceRowOut & distances_ = EIGEN_CONST_CAST(DistanceRowOut,distances);
+        for(Eigen::DenseIndex t = 0; t < Q0.cols(); ++t)
+          distances_[t] += lgo.squaredDistance(Q0.col(t),Q1.col(t));
+      }
+    };
+    
+    template<int Dim, typename _Scalar, int _Options>
+    struct TrajectoryOperation< VectorSpaceOperationTpl<Dim,_Scalar,_Options> >
+    {
+      typedef VectorSpaceOperationTpl<Dim,_Scalar,_Options> LieGroup;
+      
+      template<typename ConfigMatrixIn, typename TangentMatrixIn, typename ConfigMatrixOut>
+      static void integrate(const LieGroup &,
+                            const Eigen::MatrixBase<ConfigMatrixIn> & Q,
+                            const Eigen::MatrixBase<TangentMatrixIn> & V,
+                            const Eigen::MatrixBase<ConfigMatrixOut> & Qout)
+      {
+        EIGEN_CONST_CAST(ConfigMatrixOut,Qout) = Q + V;
+      }
+      
+      template<typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename TangentMatrixOut>
+      static void difference(const LieGroup &,
+                             const Eigen::MatrixBase<ConfigMatrixIn1> & Q0,
+                             const Eigen::MatrixBase<ConfigMatrixIn2> & Q1,
+                             const Eigen::MatrixBase<TangentMatrixOut> & Vout)
+      {
+        EIGEN_CONST_CAST(TangentMatrixOut,Vout) = Q1 - Q0;
+      }
+      
+      template<typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename Scalar, typename ConfigMatrixOut>
+      static void interpolate(const LieGroup &,
+                              const Eigen::MatrixBase<ConfigMatrixIn1> & Q0,
+                              const Eigen::MatrixBase<ConfigMatrixIn2> & Q1,
+                              const Scalar & u,
+                              const Eigen::MatrixBase<ConfigMatrixOut> & Qout)
+      {
+        ConfigMatrixOut & Qout_ = EIGEN_CONST_CAST(ConfigMatrixOut,Qout);
+        if     (u == 0) Qout_ = Q0;
+        else if(u == 1) Qout_ = Q1;
+        else            Qout_ = Q0 + u * (Q1 - Q0);
+      }
+      
+      template<typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename DistanceRowOut>
+      static void squaredDistance(const LieGroup &,
+                                  const Eigen::MatrixBase<ConfigMatrixIn1> & Q0,
+                                  const Eigen::MatrixBase<ConfigMatrixIn2> & Q1,
+                                  const Eigen::MatrixBase<DistanceRowOut> & distances)
+      {
+        EIGEN_CONST_CAST(DistanceRowOut,distances) += (Q1 - Q0).colwise().squaredNorm();
+      }
+    };
+  } // namespace details
+  
+  template<typename Visitor, typename JointModel> struct IntegrateTrajectoryStepAlgo;
+  
+  template<typename LieGroup_t, typename ConfigMatrixIn, typename TangentMatrixIn, typename ConfigMatrixOut>
+  struct IntegrateTrajectoryStep
+  : public fusion::JointVisitorBase< IntegrateTrajectoryStep<LieGroup_t,ConfigMatrixIn,TangentMatrixIn,ConfigMatrixOut> >
+  {
+    typedef boost::fusion::vector<const ConfigMatrixIn &,
+                                  const TangentMatrixIn &,
+                                  ConfigMatrixOut &
+                                  > ArgsType;
+    
+    SE3_DETAILS_VISITOR_METHOD_ALGO_3(IntegrateTrajectoryStepAlgo, IntegrateTrajectoryStep)
+  };
+  
+  template<typename Visitor, typename JointModel>
+  struct IntegrateTrajectoryStepAlgo
+  {
+    template<typename ConfigMatrixIn, typename TangentMatrixIn, typename ConfigMatrixOut>
+    static void run(const JointModelBase<JointModel> & jmodel,
+                    const Eigen::MatrixBase<ConfigMatrixIn> & Q,
+                    const Eigen::MatrixBase<TangentMatrixIn> & V,
+                    const Eigen::MatrixBase<ConfigMatrixOut> & Qout)
+    {
+      typedef typename Visitor::LieGroupMap LieGroupMap;
+      
+      typedef typename LieGroupMap::template operation<JointModel>::type LieGroup;
+      LieGroup lgo;
+      details::TrajectoryOperation<LieGroup>::integrate
+      (lgo,
+       SizeDepType<LieGroup::NQ>::middleRows(Q.derived(),jmodel.idx_q(),jmodel.nq()),
+       SizeDepType<LieGroup::NV>::middleRows(V.derived(),jmodel.idx_v(),jmodel.nv()),
+       SizeDepType<LieGroup::NQ>::middleRows(EIGEN_CONST_CAST(ConfigMatrixOut,Qout),jmodel.idx_q(),jmodel.nq()));
+    }
+  };
+  
+  SE3_DETAILS_DISPATCH_JOINT_COMPOSITE_3(IntegrateTrajectoryStepAlgo);
+  
+  template<typename Visitor, typename JointModel> struct DifferenceTrajectoryStepAlgo;
+  
+  template<typename LieGroup_t, typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename TangentMatrixOut>
+  struct DifferenceTrajectoryStep
+  : public fusion::JointVisitorBase< DifferenceTrajectoryStep<LieGroup_t,ConfigMatrixIn1,ConfigMatrixIn2,TangentMatrixOut> >
+  {
+    typedef boost::fusion::vector<const ConfigMatrixIn1 &,
+                                  const ConfigMatrixIn2 &,
+                                  TangentMatrixOut &
+                                  > ArgsType;
+    
+    SE3_DETAILS_VISITOR_METHOD_ALGO_3(DifferenceTrajectoryStepAlgo, DifferenceTrajectoryStep)
+  };
+  
+  template<typename Visitor, typename JointModel>
+  struct DifferenceTrajectoryStepAlgo
+  {
+    template<typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename TangentMatrixOut>
+    static void run(const JointModelBase<JointModel> & jmodel,
+                    const Eigen::MatrixBase<ConfigMatrixIn1> & Q0,
+                    const Eigen::MatrixBase<ConfigMatrixIn2> & Q1,
+                    const Eigen::MatrixBase<TangentMatrixOut> & Vout)
+    {
+      typedef typename Visitor::LieGroupMap LieGroupMap;
+      
+      typedef typename LieGroupMap::template operation<JointModel>::type LieGroup;
+      LieGroup lgo;
+      details::TrajectoryOperation<LieGroup>::difference
+      (lgo,
+       SizeDepType<LieGroup::NQ>::middleRows(Q0.derived(),jmodel.idx_q(),jmodel.nq()),
+       SizeDepType<LieGroup::NQ>::middleRows(Q1.derived(),jmodel.idx_q(),jmodel.nq()),
+       SizeDepType<LieGroup::NV>::middleRows(EIGEN_CONST_CAST(TangentMatrixOut,Vout),jmodel.idx_v(),jmodel.nv()));
+    }
+  };
+  
+  SE3_DETAILS_DISPATCH_JOINT_COMPOSITE_3(DifferenceTrajectoryStepAlgo);
+  
+  template<typename Visitor, typename JointModel> struct InterpolateTrajectoryStepAlgo;
+  
+  template<typename LieGroup_t, typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename Scalar, typename ConfigMatrixOut>
+  struct InterpolateTrajectoryStep
+  : public fusion::JointVisitorBase< InterpolateTrajectoryStep<LieGroup_t,ConfigMatrixIn1,ConfigMatrixIn2,Scalar,ConfigMatrixOut> >
+  {
+    typedef boost::fusion::vector<const ConfigMatrixIn1 &,
+                                  const ConfigMatrixIn2 &,
+                                  const Scalar &,
+                                  ConfigMatrixOut &
+                                  > ArgsType;
+    
+    SE3_DETAILS_VISITOR_METHOD_ALGO_4(InterpolateTrajectoryStepAlgo, InterpolateTrajectoryStep)
+  };
+  
+  template<typename Visitor, typename JointModel>
+  struct InterpolateTrajectoryStepAlgo
+  {
+    template<typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename Scalar, typename ConfigMatrixOut>
+    static void run(const JointModelBase<JointModel> & jmodel,
+                    const Eigen::MatrixBase<ConfigMatrixIn1> & Q0,
+                    const Eigen::MatrixBase<ConfigMatrixIn2> & Q1,
+                    const Scalar & u,
+                    const Eigen::MatrixBase<ConfigMatrixOut> & Qout)
+    {
+      typedef typename Visitor::LieGroupMap LieGroupMap;
+      
+      typedef typename LieGroupMap::template operation<JointModel>::type LieGroup;
+      LieGroup lgo;
+      details::TrajectoryOperation<LieGroup>::interpolate
+      (lgo,
+       SizeDepType<LieGroup::NQ>::middleRows(Q0.derived(),jmodel.idx_q(),jmodel.nq()),
+       SizeDepType<LieGroup::NQ>::middleRows(Q1.derived(),jmodel.idx_q(),jmodel.nq()),
+       u,
+       SizeDepType<LieGroup::NQ>::middleRows(EIGEN_CONST_CAST(ConfigMatrixOut,Qout),jmodel.idx_q(),jmodel.nq()));
+    }
+  };
+  
+  SE3_DETAILS_DISPATCH_JOINT_COMPOSITE_4(InterpolateTrajectoryStepAlgo);
+  
+  template<typename Visitor, typename JointModel> struct SquaredDistanceTrajectoryStepAlgo;
+  
+  template<typename LieGroup_t, typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename DistanceMatrixOut>
+  struct SquaredDistanceTrajectoryStep
+  : public fusion::JointVisitorBase< SquaredDistanceTrajectoryStep<LieGroup_t,ConfigMatrixIn1,ConfigMatrixIn2,DistanceMatrixOut> >
+  {
+    typedef boost::fusion::vector<const JointIndex &,
+                                  const ConfigMatrixIn1 &,
+                                  const ConfigMatrixIn2 &,
+                                  DistanceMatrixOut &
+                                  > ArgsType;
+    
+    SE3_DETAILS_VISITOR_METHOD_ALGO_4(SquaredDistanceTrajectoryStepAlgo, SquaredDistanceTrajectoryStep)
+  };
+  
+  template<typename Visitor, typename JointModel>
+  struct SquaredDistanceTrajectoryStepAlgo
+  {
+    template<typename ConfigMatrixIn1, typename ConfigMatrixIn2, typename DistanceMatrixOut>
+    static void run(const JointModelBase<JointModel> & jmodel,
+                    const JointIndex & i,
+                    const Eigen::MatrixBase<ConfigMatrixIn1> & Q0,
+                    const Eigen::MatrixBase<ConfigMatrixIn2> & Q1,
+                    const Eigen::MatrixBase<DistanceMatrixOut> & distances)
+    {
+      typedef typename Visitor::LieGroupMap LieGroupMap;
+      
+      typedef typename LieGroupMap::template operation<JointModel>::type LieGroup;
+      LieGroup lgo;
+      details::TrajectoryOperation<LieGroup>::squaredDistance
+      (lgo,
+       SizeDepType<LieGroup::NQ>::middleRows(Q0.derived(),jmodel.idx_q(),jmodel.nq()),
+       SizeDepType<LieGroup::NQ>::middleRows(Q1.derived(),jmodel.idx_q(),jmodel.nq()),
+       EIGEN_CONST_CAST(DistanceMatrixOut,distances).row((Eigen::DenseIndex)i));
+    }
+  };
+  
+  SE3_DETAILS_DISPATCH_JOINT_COMPOSITE_4(SquaredDistanceTrajectoryStepAlgo);
+  
+  template<typename Visitor, typename JointModel> struct dIntegrateTrajectoryStepAlgo;
+  
+  template<typename LieGroup_t, typename ConfigMatrixIn, typename TangentMatrixIn, typename JacobianMatrixType>
+  struct dIntegrateTrajectoryStep
+  : public fusion::JointVisitorBase< dIntegrateTrajectoryStep<LieGroup_t,ConfigMatrixIn,TangentMatrixIn,JacobianMatrixType> >
+  {
+    typedef boost::fusion::vector<const ConfigMatrixIn &,
+                                  const TangentMatrixIn &,
+                                  JacobianMatrixType &,
+                                  const ArgumentPosition &
+                                  > ArgsType;
+    
+    SE3_DETAILS_VISITOR_METHOD_ALGO_4(dIntegrateTrajectoryStepAlgo, dIntegrateTrajectoryStep)
+  };
+  
+  template<typename Visitor, typename JointModel>
+  struct dIntegrateTrajectoryStepAlgo
+  {
+    template<typename ConfigMatrixIn, typename TangentMatrixIn, typename JacobianMatrixType>
+    static void run(const JointModelBase<JointModel> & jmodel,
+                    const Eigen::MatrixBase<ConfigMatrixIn> & Q,
+                    const Eigen::MatrixBase<TangentMatrixIn> & V,
+                    const Eigen::MatrixBase<JacobianMatrixType> & J,
+                    const ArgumentPosition & arg)
+    {
+      typedef typename Visitor::LieGroupMap LieGroupMap;
+      
+      typedef typename LieGroupMap::template operation<JointModel>::type LieGroup;
+      LieGroup lgo;
+      JacobianMatrixType & J_ = EIGEN_CONST_CAST(JacobianMatrixType,J);
+      const Eigen::DenseIndex nv = J.rows();
+      for(Eigen::DenseIndex t = 0; t < Q.cols(); ++t)
+      {
+        lgo.dIntegrate(jmodel.jointConfigSelector(Q.col(t)),
+                       jmodel.jointVelocitySelector(V.col(t)),
+                       SizeDepType<LieGroup::NV>::block(J_,jmodel.idx_v(),t*nv+jmodel.idx_v(),jmodel.nv(),jmodel.nv()),
+                       arg);
+      }
+    }
+  };
+  
+  SE3_DETAILS_DISPATCH_JOINT_COMPOSITE_4(dIntegrateTrajectoryStepAlgo);
+  
 }
 
 #endif // ifndef __pinocchio_lie_group_algo_hxx__
@@ -235,6 +235,21 @@ SE3_LIE_GROUP_PUBLIC_INTERFACE_GENERIC(Derived,typename)
                      const Eigen::MatrixBase<ConfigR_t> & q1,
                      const Eigen::MatrixBase<JacobianOut_t>& J) const;
 
+    /**
+     * @brief      Computes the Jacobian of the difference operation with respect to q0 or q1.
+     *
+     * @param[in]  q0    the initial configuration vector.
+     * @param[in]  q1    the terminal configuration vector.
+     * @param[in]  arg   ARG0 (resp. ARG1) to get the Jacobian with respect to q0 (resp. q1).
+     *
+     * @param[out] J     the Jacobian of the difference operation.
+     */
+    template <class ConfigL_t, class ConfigR_t, class JacobianOut_t>
+    void dDifference(const Eigen::MatrixBase<ConfigL_t> & q0,
+                     const Eigen::MatrixBase<ConfigR_t> & q1,
+                     const Eigen::MatrixBase<JacobianOut_t>& J,
+                     const ArgumentPosition arg) const;
+
     /**
      * @brief      Squared distance between two joint configurations.
      *
@@ -181,6 +181,25 @@ namespace pinocchio {
     derived().template dDifference_impl<arg> (q0, q1, J);
   }
 
+  template <class Derived>
+  template <class ConfigL_t, class ConfigR_t, class JacobianOut_t>
+  void LieGroupBase<Derived>::dDifference(
+      const Eigen::MatrixBase<ConfigL_t> & q0,
+      const Eigen::MatrixBase<ConfigR_t> & q1,
+      const Eigen::MatrixBase<JacobianOut_t>& J,
+      const ArgumentPosition arg) const
+  {
+    assert((arg==ARG0||arg==ARG1) && "arg should be either ARG0 or ARG1");
+    
+    switch (arg) {
+      case ARG0:
+        derived().template dDifference<ARG0>(q0,q1,J); return;
+      case ARG1:
+        derived().template dDifference<ARG1>(q0,q1,J); return;
+      default: return;
+    }
+  }
+
   template <class Derived>
   template <class ConfigL_t, class ConfigR_t>
   typename LieGroupBase<Derived>::Scalar
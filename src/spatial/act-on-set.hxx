@@ -5,19 +5,57 @@
 #ifndef __pinocchio_act_on_set_hxx__
 #define __pinocchio_act_on_set_hxx__
 
+#include "pinocchio/spatial/skew.hpp"
+
 namespace pinocchio
 {
-  
-  namespace internal 
+
+  namespace internal
   {
 
+    /* The actions on sets with more than one column are computed by blocks of
+     * ACTION_ON_SET_BLOCK_SIZE columns. Each 3D component of a block is
+     * transformed at once by a 3x3 matrix product, the operators (rotations,
+     * fused rotation and cross products) being assembled once for the whole
+     * set. The intermediate results of a block live on the stack and are only
+     * written back once the block has been entirely read, so that the input
+     * and output sets may be the same matrix. */
+    enum { ACTION_ON_SET_BLOCK_SIZE = 8 };
+
+    template<typename Scalar, int Options>
+    struct ActionOnSetBlock
+    {
+      typedef Eigen::Matrix<Scalar,3,Eigen::Dynamic,Options,3,ACTION_ON_SET_BLOCK_SIZE> Type;
+    };
+
+    /* Writes src into dst according to Op. */
+    template<int Op, typename MatDst, typename MatSrc>
+    inline void assignActionOnSet(const Eigen::MatrixBase<MatDst> & dst,
+                                  const Eigen::MatrixBase<MatSrc> & src)
+    {
+      MatDst & dst_ = EIGEN_CONST_CAST(MatDst,dst);
+      switch(Op)
+      {
+        case SETTO:
+          dst_ = src;
+          break;
+        case ADDTO:
+          dst_ += src;
+          break;
+        case RMTO:
+          dst_ -= src;
+          break;
+        default:
+          assert(false && "Wrong Op requesed value");
+          break;
+      }
+    }
+
     template<int Op, typename Scalar, int Options, typename Mat, typename MatRet, int NCOLS>
     struct ForceSetSe3Action
     {
       /* Compute jF = jXi * iF, where jXi is the dual action matrix associated
-       * with m, and iF, jF are matrices whose columns are forces. The resolution
-       * is done by block operation. It is less efficient than the colwise
-       * operation and should not be used. */ 
+       * with m, and iF, jF are matrices whose columns are forces. */
       static void run(const SE3Tpl<Scalar,Options> & m,
                       const Eigen::MatrixBase<Mat> & iF,
                       Eigen::MatrixBase<MatRet> const & jF);
@@ -60,20 +98,32 @@ namespace pinocchio
       }
     };
     
-    /* Specialized implementation of block action, using colwise operation.  It
-     * is empirically much faster than the true block operation, although I do
-     * not understand why. */
+    /* Block implementation: f = R.f_in and n = R.n_in + [p]x.R.f_in, with the
+     * product [p]x.R computed once for the whole set. */
     template<int Op, typename Scalar, int Options, typename Mat, typename MatRet, int NCOLS>
     void ForceSetSe3Action<Op,Scalar,Options,Mat,MatRet,NCOLS>::
     run(const SE3Tpl<Scalar,Options> & m,
         const Eigen::MatrixBase<Mat> & iF,
         Eigen::MatrixBase<MatRet> const & jF)
     {
-      for(int col=0;col<jF.cols();++col)
+      typedef ForceTpl<Scalar,Options> Force;
+      typedef typename SE3Tpl<Scalar,Options>::Matrix3 Matrix3;
+      typedef typename ActionOnSetBlock<Scalar,Options>::Type Matrix3xBlock;
+
+      MatRet & jF_ = const_cast<Eigen::MatrixBase<MatRet> &>(jF).derived();
+      const Matrix3 & R = m.rotation();
+      const Matrix3 pxR(skew(m.translation()) * R);
+
+      Matrix3xBlock f, n;
+      for(Eigen::DenseIndex col = 0; col < jF.cols(); col += ACTION_ON_SET_BLOCK_SIZE)
       {
-        typename MatRet::ColXpr jFc
-        = const_cast<Eigen::MatrixBase<MatRet> &>(jF).col(col);
-        forceSet::se3Action<Op>(m,iF.col(col),jFc);
+        const Eigen::DenseIndex ncols = std::min<Eigen::DenseIndex>(ACTION_ON_SET_BLOCK_SIZE,jF.cols()-col);
+        f.noalias() = R * iF.template middleRows<3>(Force::LINEAR).middleCols(col,ncols);
+        n.noalias() = R * iF.template middleRows<3>(Force::ANGULAR).middleCols(col,ncols);
+        n.noalias() += pxR * iF.template middleRows<3>(Force::LINEAR).middleCols(col,ncols);
+
+        assignActionOnSet<Op>(jF_.template middleRows<3>(Force::LINEAR).middleCols(col,ncols),f);
+        assignActionOnSet<Op>(jF_.template middleRows<3>(Force::ANGULAR).middleCols(col,ncols),n);
       }
     }
     
@@ -130,17 +180,33 @@ namespace pinocchio
       }
     };
 
+    /* Block implementation: f = [w]x.f_in and n = [w]x.n_in + [v]x.f_in. */
     template<int Op, typename MotionDerived, typename Mat, typename MatRet, int NCOLS>
     void ForceSetMotionAction<Op,MotionDerived,Mat,MatRet,NCOLS>::
     run(const MotionDense<MotionDerived> & v,
         const Eigen::MatrixBase<Mat> & iF,
         Eigen::MatrixBase<MatRet> const & jF)
     {
-      for(int col=0;col<jF.cols();++col)
+      typedef typename traits<MotionDerived>::Scalar Scalar;
+      enum { Options = traits<MotionDerived>::Options };
+      typedef ForceTpl<Scalar,Options> Force;
+      typedef Eigen::Matrix<Scalar,3,3,Options> Matrix3;
+      typedef typename ActionOnSetBlock<Scalar,Options>::Type Matrix3xBlock;
+
+      MatRet & jF_ = const_cast<Eigen::MatrixBase<MatRet> &>(jF).derived();
+      const Matrix3 wx(skew(v.angular()));
+      const Matrix3 vx(skew(v.linear()));
+
+      Matrix3xBlock f, n;
+      for(Eigen::DenseIndex col = 0; col < jF.cols(); col += ACTION_ON_SET_BLOCK_SIZE)
       {
-        typename MatRet::ColXpr jFc
-        = const_cast<Eigen::MatrixBase<MatRet> &>(jF).col(col);
-        forceSet::motionAction<Op>(v,iF.col(col),jFc);
+        const Eigen::DenseIndex ncols = std::min<Eigen::DenseIndex>(ACTION_ON_SET_BLOCK_SIZE,jF.cols()-col);
+        f.noalias() = wx * iF.template middleRows<3>(Force::LINEAR).middleCols(col,ncols);
+        n.noalias() = wx * iF.template middleRows<3>(Force::ANGULAR).middleCols(col,ncols);
+        n.noalias() += vx * iF.template middleRows<3>(Force::LINEAR).middleCols(col,ncols);
+
+        assignActionOnSet<Op>(jF_.template middleRows<3>(Force::LINEAR).middleCols(col,ncols),f);
+        assignActionOnSet<Op>(jF_.template middleRows<3>(Force::ANGULAR).middleCols(col,ncols),n);
       }
     }
     
@@ -148,9 +214,7 @@ namespace pinocchio
     struct ForceSetSe3ActionInverse
     {
       /* Compute jF = jXi * iF, where jXi is the dual action matrix associated
-       * with m, and iF, jF are matrices whose columns are forces. The resolution
-       * is done by block operation. It is less efficient than the colwise
-       * operation and should not be used. */
+       * with m, and iF, jF are matrices whose columns are forces. */
       static void run(const SE3Tpl<Scalar,Options> & m,
                       const Eigen::MatrixBase<Mat> & iF,
                       Eigen::MatrixBase<MatRet> const & jF);
@@ -194,20 +258,32 @@ namespace pinocchio
       
     };
     
-    /* Specialized implementation of block action, using colwise operation.  It
-     * is empirically much faster than the true block operation, although I do
-     * not understand why. */
+    /* Block implementation: f = R^T.f_in and n = R^T.n_in - R^T.[p]x.f_in, with
+     * R^T.[p]x computed once for the whole set. */
     template<int Op, typename Scalar, int Options, typename Mat, typename MatRet, int NCOLS>
     void ForceSetSe3ActionInverse<Op,Scalar,Options,Mat,MatRet,NCOLS>::
     run(const SE3Tpl<Scalar,Options> & m,
         const Eigen::MatrixBase<Mat> & iF,
         Eigen::MatrixBase<MatRet> const & jF)
     {
-      for(int col=0;col<jF.cols();++col)
+      typedef ForceTpl<Scalar,Options> Force;
+      typedef typename SE3Tpl<Scalar,Options>::Matrix3 Matrix3;
+      typedef typename ActionOnSetBlock<Scalar,Options>::Type Matrix3xBlock;
+
+      MatRet & jF_ = const_cast<Eigen::MatrixBase<MatRet> &>(jF).derived();
+      const Matrix3 & R = m.rotation();
+      const Matrix3 Rtpx(R.transpose() * skew(m.translation()));
+
+      Matrix3xBlock f, n;
+      for(Eigen::DenseIndex col = 0; col < jF.cols(); col += ACTION_ON_SET_BLOCK_SIZE)
       {
-        typename MatRet::ColXpr jFc
-        = const_cast<Eigen::MatrixBase<MatRet> &>(jF).col(col);
-        forceSet::se3ActionInverse<Op>(m,iF.col(col),jFc);
+        const Eigen::DenseIndex ncols = std::min<Eigen::DenseIndex>(ACTION_ON_SET_BLOCK_SIZE,jF.cols()-col);
+        f.noalias() = R.transpose() * iF.template middleRows<3>(Force::LINEAR).middleCols(col,ncols);
+        n.noalias() = R.transpose() * iF.template middleRows<3>(Force::ANGULAR).middleCols(col,ncols);
+        n.noalias() -= Rtpx * iF.template middleRows<3>(Force::LINEAR).middleCols(col,ncols);
+
+        assignActionOnSet<Op>(jF_.template middleRows<3>(Force::LINEAR).middleCols(col,ncols),f);
+        assignActionOnSet<Op>(jF_.template middleRows<3>(Force::ANGULAR).middleCols(col,ncols),n);
       }
     }
     
@@ -315,20 +391,32 @@ namespace pinocchio
       }
     };
     
-    /* Specialized implementation of block action, using colwise operation.  It
-     * is empirically much faster than the true block operation, although I do
-     * not understand why. */
+    /* Block implementation: w = R.w_in and v = R.v_in + [p]x.R.w_in, with the
+     * product [p]x.R computed once for the whole set. */
     template<int Op, typename Scalar, int Options, typename Mat, typename MatRet, int NCOLS>
     void MotionSetSe3Action<Op,Scalar,Options,Mat,MatRet,NCOLS>::
     run(const SE3Tpl<Scalar,Options> & m,
         const Eigen::MatrixBase<Mat> & iV,
         Eigen::MatrixBase<MatRet> const & jV)
     {
-      for(int col=0;col<jV.cols();++col)
+      typedef MotionTpl<Scalar,Options> Motion;
+      typedef typename SE3Tpl<Scalar,Options>::Matrix3 Matrix3;
+      typedef typename ActionOnSetBlock<Scalar,Options>::Type Matrix3xBlock;
+
+      MatRet & jV_ = const_cast<Eigen::MatrixBase<MatRet> &>(jV).derived();
+      const Matrix3 & R = m.rotation();
+      const Matrix3 pxR(skew(m.translation()) * R);
+
+      Matrix3xBlock v, w;
+      for(Eigen::DenseIndex col = 0; col < jV.cols(); col += ACTION_ON_SET_BLOCK_SIZE)
       {
-        typename MatRet::ColXpr jVc
-        = const_cast<Eigen::MatrixBase<MatRet> &>(jV).col(col);
-        motionSet::se3Action<Op>(m,iV.col(col),jVc);
+        const Eigen::DenseIndex ncols = std::min<Eigen::DenseIndex>(ACTION_ON_SET_BLOCK_SIZE,jV.cols()-col);
+        w.noalias() = R * iV.template middleRows<3>(Motion::ANGULAR).middleCols(col,ncols);
+        v.noalias() = R * iV.template middleRows<3>(Motion::LINEAR).middleCols(col,ncols);
+        v.noalias() += pxR * iV.template middleRows<3>(Motion::ANGULAR).middleCols(col,ncols);
+
+        assignActionOnSet<Op>(jV_.template middleRows<3>(Motion::LINEAR).middleCols(col,ncols),v);
+        assignActionOnSet<Op>(jV_.template middleRows<3>(Motion::ANGULAR).middleCols(col,ncols),w);
       }
     }
     
@@ -343,17 +431,33 @@ namespace pinocchio
       
     };
     
+    /* Block implementation: v = [w]x.v_in + [v]x.w_in and w = [w]x.w_in. */
     template<int Op, typename MotionDerived, typename Mat, typename MatRet, int NCOLS>
     void MotionSetMotionAction<Op,MotionDerived,Mat,MatRet,NCOLS>::
     run(const MotionDense<MotionDerived> & v,
         const Eigen::MatrixBase<Mat> & iV,
         Eigen::MatrixBase<MatRet> const & jV)
     {
-      for(int col=0;col<jV.cols();++col)
+      typedef typename traits<MotionDerived>::Scalar Scalar;
+      enum { Options = traits<MotionDerived>::Options };
+      typedef MotionTpl<Scalar,Options> Motion;
+      typedef Eigen::Matrix<Scalar,3,3,Options> Matrix3;
+      typedef typename ActionOnSetBlock<Scalar,Options>::Type Matrix3xBlock;
+
+      MatRet & jV_ = const_cast<Eigen::MatrixBase<MatRet> &>(jV).derived();
+      const Matrix3 wx(skew(v.angular()));
+      const Matrix3 vx(skew(v.linear()));
+
+      Matrix3xBlock lin, ang;
+      for(Eigen::DenseIndex col = 0; col < jV.cols(); col += ACTION_ON_SET_BLOCK_SIZE)
       {
-        typename MatRet::ColXpr jVc
-        = const_cast<Eigen::MatrixBase<MatRet> &>(jV).col(col);
-        motionSet::motionAction<Op>(v,iV.col(col),jVc);
+        const Eigen::DenseIndex ncols = std::min<Eigen::DenseIndex>(ACTION_ON_SET_BLOCK_SIZE,jV.cols()-col);
+        lin.noalias() = wx * iV.template middleRows<3>(Motion::LINEAR).middleCols(col,ncols);
+        lin.noalias() += vx * iV.template middleRows<3>(Motion::ANGULAR).middleCols(col,ncols);
+        ang.noalias() = wx * iV.template middleRows<3>(Motion::ANGULAR).middleCols(col,ncols);
+
+        assignActionOnSet<Op>(jV_.template middleRows<3>(Motion::LINEAR).middleCols(col,ncols),lin);
+        assignActionOnSet<Op>(jV_.template middleRows<3>(Motion::ANGULAR).middleCols(col,ncols),ang);
       }
     }
     
@@ -395,9 +499,7 @@ namespace pinocchio
     struct MotionSetSe3ActionInverse
     {
       /* Compute jF = jXi * iF, where jXi is the action matrix associated
-       * with m, and iF, jF are matrices whose columns are motions. The resolution
-       * is done by block operation. It is less efficient than the colwise
-       * operation and should not be used. */
+       * with m, and iF, jF are matrices whose columns are motions. */
       static void run(const SE3Tpl<Scalar,Options> & m,
                       const Eigen::MatrixBase<Mat> & iF,
                       Eigen::MatrixBase<MatRet> const & jF);
@@ -440,20 +542,32 @@ namespace pinocchio
       }
     };
     
-    /* Specialized implementation of block action, using colwise operation.  It
-     * is empirically much faster than the true block operation, although I do
-     * not understand why. */
+    /* Block implementation: w = R^T.w_in and v = R^T.v_in - R^T.[p]x.w_in, with
+     * R^T.[p]x computed once for the whole set. */
     template<int Op, typename Scalar, int Options, typename Mat, typename MatRet, int NCOLS>
     void MotionSetSe3ActionInverse<Op,Scalar,Options,Mat,MatRet,NCOLS>::
     run(const SE3Tpl<Scalar,Options> & m,
         const Eigen::MatrixBase<Mat> & iV,
         Eigen::MatrixBase<MatRet> const & jV)
     {
-      for(int col=0;col<jV.cols();++col)
+      typedef MotionTpl<Scalar,Options> Motion;
+      typedef typename SE3Tpl<Scalar,Options>::Matrix3 Matrix3;
+      typedef typename ActionOnSetBlock<Scalar,Options>::Type Matrix3xBlock;
+
+      MatRet & jV_ = const_cast<Eigen::MatrixBase<MatRet> &>(jV).derived();
+      const Matrix3 & R = m.rotation();
+      const Matrix3 Rtpx(R.transpose() * skew(m.translation()));
+
+      Matrix3xBlock v, w;
+      for(Eigen::DenseIndex col = 0; col < jV.cols(); col += ACTION_ON_SET_BLOCK_SIZE)
       {
-        typename MatRet::ColXpr jVc
-        = const_cast<Eigen::MatrixBase<MatRet> &>(jV).col(col);
-        motionSet::se3ActionInverse<Op>(m,iV.col(col),jVc);
+        const Eigen::DenseIndex ncols = std::min<Eigen::DenseIndex>(ACTION_ON_SET_BLOCK_SIZE,jV.cols()-col);
+        w.noalias() = R.transpose() * iV.template middleRows<3>(Motion::ANGULAR).middleCols(col,ncols);
+        v.noalias() = R.transpose() * iV.template middleRows<3>(Motion::LINEAR).middleCols(col,ncols);
+        v.noalias() -= Rtpx * iV.template middleRows<3>(Motion::ANGULAR).middleCols(col,ncols);
+
+        assignActionOnSet<Op>(jV_.template middleRows<3>(Motion::LINEAR).middleCols(col,ncols),v);
+        assignActionOnSet<Op>(jV_.template middleRows<3>(Motion::ANGULAR).middleCols(col,ncols),w);
       }
     }
     
@@ -468,17 +582,36 @@ namespace pinocchio
       
     };
     
+    /* Block implementation: f = m.v_in - m.[c]x.w_in and
+     * n = m.[c]x.v_in + (I_c - m.[c]x.[c]x).w_in, the 3x3 blocks of the
+     * spatial inertia being assembled once for the whole set. */
     template<int Op, typename Scalar, int Options, typename Mat, typename MatRet, int NCOLS>
     void MotionSetInertiaAction<Op,Scalar,Options,Mat,MatRet,NCOLS>::
     run(const InertiaTpl<Scalar,Options> & I,
         const Eigen::MatrixBase<Mat> & iV,
         Eigen::MatrixBase<MatRet> const & jV)
     {
-      for(int col=0;col<jV.cols();++col)
+      typedef MotionTpl<Scalar,Options> Motion;
+      typedef typename InertiaTpl<Scalar,Options>::Matrix3 Matrix3;
+      typedef typename ActionOnSetBlock<Scalar,Options>::Type Matrix3xBlock;
+
+      MatRet & jV_ = const_cast<Eigen::MatrixBase<MatRet> &>(jV).derived();
+      const Scalar & mass = I.mass();
+      const Matrix3 cx(skew(I.lever()));
+      const Matrix3 mcx(mass * cx);
+      const Matrix3 Io(I.inertia().matrix() - mcx * cx);
+
+      Matrix3xBlock f, n;
+      for(Eigen::DenseIndex col = 0; col < jV.cols(); col += ACTION_ON_SET_BLOCK_SIZE)
       {
-        typename MatRet::ColXpr jVc
-        = const_cast<Eigen::MatrixBase<MatRet> &>(jV).col(col);
-        motionSet::inertiaAction<Op>(I,iV.col(col),jVc);
+        const Eigen::DenseIndex ncols = std::min<Eigen::DenseIndex>(ACTION_ON_SET_BLOCK_SIZE,jV.cols()-col);
+        f.noalias() = mass * iV.template middleRows<3>(Motion::LINEAR).middleCols(col,ncols);
+        f.noalias() -= mcx * iV.template middleRows<3>(Motion::ANGULAR).middleCols(col,ncols);
+        n.noalias() = mcx * iV.template middleRows<3>(Motion::LINEAR).middleCols(col,ncols);
+        n.noalias() += Io * iV.template middleRows<3>(Motion::ANGULAR).middleCols(col,ncols);
+
+        assignActionOnSet<Op>(jV_.template middleRows<3>(Motion::LINEAR).middleCols(col,ncols),f);
+        assignActionOnSet<Op>(jV_.template middleRows<3>(Motion::ANGULAR).middleCols(col,ncols),n);
       }
     }
     
@@ -518,18 +651,36 @@ namespace pinocchio
     template<int Op, typename ForceDerived, typename Mat, typename MatRet, int NCOLS>
     struct MotionSetActOnForce
     {
+      /* Block implementation: each column of the set acts on the same force, so
+       * that f_out = -[f]x.w_in and n_out = -[n]x.w_in - [f]x.v_in. */
       static void run(const Eigen::MatrixBase<Mat> & iV,
                       const ForceDense<ForceDerived> & f,
                       Eigen::MatrixBase<MatRet> const & jF)
       {
-        for(int col=0;col<jF.cols();++col)
+        typedef typename traits<ForceDerived>::Scalar Scalar;
+        enum { Options = traits<ForceDerived>::Options };
+        typedef MotionTpl<Scalar,Options> Motion;
+        typedef ForceTpl<Scalar,Options> Force;
+        typedef Eigen::Matrix<Scalar,3,3,Options> Matrix3;
+        typedef typename ActionOnSetBlock<Scalar,Options>::Type Matrix3xBlock;
+
+        MatRet & jF_ = const_cast<Eigen::MatrixBase<MatRet> &>(jF).derived();
+        const Matrix3 fx(skew(f.linear()));
+        const Matrix3 nx(skew(f.angular()));
+
+        Matrix3xBlock lin, ang;
+        for(Eigen::DenseIndex col = 0; col < jF.cols(); col += ACTION_ON_SET_BLOCK_SIZE)
         {
-          typename MatRet::ColXpr jFc
-          = const_cast<Eigen::MatrixBase<MatRet> &>(jF).col(col);
-          motionSet::act<Op>(iV.col(col),f,jFc);
+          const Eigen::DenseIndex ncols = std::min<Eigen::DenseIndex>(ACTION_ON_SET_BLOCK_SIZE,jF.cols()-col);
+          lin.noalias() = -fx * iV.template middleRows<3>(Motion::ANGULAR).middleCols(col,ncols);
+          ang.noalias() = -nx * iV.template middleRows<3>(Motion::ANGULAR).middleCols(col,ncols);
+          ang.noalias() -= fx * iV.template middleRows<3>(Motion::LINEAR).middleCols(col,ncols);
+
+          assignActionOnSet<Op>(jF_.template middleRows<3>(Force::LINEAR).middleCols(col,ncols),lin);
+          assignActionOnSet<Op>(jF_.template middleRows<3>(Force::ANGULAR).middleCols(col,ncols),ang);
         }
       }
-      
+
     };
     
     template<int Op, typename ForceDerived, typename Mat, typename MatRet>
@@ -7,6 +7,7 @@
 
 #include <hpp/fcl/math/transform.h>
 #include "pinocchio/spatial/se3.hpp"
+#include "pinocchio/spatial/se3-quaternion.hpp"
 
 namespace pinocchio
 {
@@ -15,6 +16,12 @@ namespace pinocchio
     return fcl::Transform3f(m.rotation(), m.translation());
   }
 
+  inline fcl::Transform3f toFclTransform3f(const SE3Quaternion & m)
+  {
+    const SE3Quaternion::Quaternion & q = m.rotation();
+    return fcl::Transform3f(fcl::Quaternion3f(q.w(),q.x(),q.y(),q.z()), m.translation());
+  }
+
   inline SE3 toPinocchioSE3(const fcl::Transform3f & tf)
   {
     return SE3(tf.getRotation(), tf.getTranslation());
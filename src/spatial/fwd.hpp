@@ -13,6 +13,7 @@ namespace pinocchio
 {
   
   template<typename Scalar, int Options=0> struct SE3Tpl;
+  template<typename Scalar, int Options=0> struct SE3QuaternionTpl;
 
   template<typename Derived> class MotionBase;
   template<typename Derived> class MotionDense;
@@ -34,6 +35,7 @@ namespace pinocchio
    */
 
   typedef SE3Tpl        <double,0> SE3;
+  typedef SE3QuaternionTpl<double,0> SE3Quaternion;
   typedef MotionTpl     <double,0> Motion;
   typedef ForceTpl      <double,0> Force;
   typedef InertiaTpl    <double,0> Inertia;
@@ -0,0 +1,247 @@
+//
+// Copyright (c) 2018 CNRS
+//
+
+#ifndef __pinocchio_se3_quaternion_hpp__
+#define __pinocchio_se3_quaternion_hpp__
+
+#include <Eigen/Geometry>
+
+#include "pinocchio/spatial/fwd.hpp"
+#include "pinocchio/spatial/se3.hpp"
+#include "pinocchio/spatial/motion.hpp"
+#include "pinocchio/spatial/force.hpp"
+#include "pinocchio/math/quaternion.hpp"
+
+namespace pinocchio
+{
+  ///
+  /// \brief Rigid transform aMb stored as a unit quaternion and a translation vector (7 scalars instead of
+  ///        the 12 scalars of SE3Tpl).
+  ///
+  /// \details It follows the same conventions as SE3Tpl: aMb(x) = aRb*x + aAB, where aRb is the rotation
+  ///          represented by the quaternion. It is intended for kinematics-heavy workloads over many
+  ///          placements (joints, frames, geometries), where the memory traffic dominates the cost of the
+  ///          computations. The rotation matrix is only formed on demand by toSE3.
+  ///
+  /// \remarks Compositions do not renormalize the quaternion. Call normalize() after long chains of
+  ///          compositions if needed.
+  ///
+  template<typename _Scalar, int _Options>
+  struct SE3QuaternionTpl
+  {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef _Scalar Scalar;
+    enum { Options = _Options };
+
+    typedef Eigen::Quaternion<Scalar,Options> Quaternion;
+    typedef Eigen::Matrix<Scalar,3,1,Options> Vector3;
+    typedef Eigen::Matrix<Scalar,3,3,Options> Matrix3;
+    typedef SE3Tpl<Scalar,Options> SE3;
+    typedef MotionTpl<Scalar,Options> Motion;
+    typedef ForceTpl<Scalar,Options> Force;
+
+    SE3QuaternionTpl() : quat(), trans() {}
+
+    template<typename QuaternionLike, typename Vector3Like>
+    SE3QuaternionTpl(const Eigen::QuaternionBase<QuaternionLike> & q,
+                     const Eigen::MatrixBase<Vector3Like> & p)
+    : quat(q), trans(p)
+    {
+      EIGEN_STATIC_ASSERT_VECTOR_SPECIFIC_SIZE(Vector3Like,3)
+    }
+
+    /// \brief Conversion from the rotation matrix representation.
+    template<int O2>
+    explicit SE3QuaternionTpl(const SE3Tpl<Scalar,O2> & M)
+    : quat(M.rotation()), trans(M.translation())
+    {}
+
+    static SE3QuaternionTpl Identity()
+    {
+      return SE3QuaternionTpl().setIdentity();
+    }
+
+    SE3QuaternionTpl & setIdentity()
+    { quat.setIdentity(); trans.setZero(); return *this; }
+
+    static SE3QuaternionTpl Random()
+    {
+      return SE3QuaternionTpl().setRandom();
+    }
+
+    SE3QuaternionTpl & setRandom()
+    {
+      quaternion::uniformRandom(quat);
+      trans.setRandom();
+      return *this;
+    }
+
+    /// \brief Conversion to the rotation matrix representation.
+    SE3 toSE3() const
+    {
+      return SE3(quat.toRotationMatrix(),trans);
+    }
+
+    /// \brief Writes the rotation matrix representation into M.
+    template<int O2>
+    void toSE3(SE3Tpl<Scalar,O2> & M) const
+    {
+      M.rotation() = quat.toRotationMatrix();
+      M.translation() = trans;
+    }
+
+    /// \brief Renormalizes the quaternion.
+    SE3QuaternionTpl & normalize()
+    { quat.normalize(); return *this; }
+
+    /// aXb = bXa.inverse()
+    SE3QuaternionTpl inverse() const
+    {
+      const Quaternion quat_inv(quat.conjugate());
+      return SE3QuaternionTpl(quat_inv,-(quat_inv*trans));
+    }
+
+    /// --- GROUP ACTIONS ON POINTS, M6, F6 AND PLACEMENTS ---
+
+    /// ap = aXb.act(bp)
+    template<typename Vector3Like>
+    Vector3 act(const Eigen::MatrixBase<Vector3Like> & p) const
+    {
+      EIGEN_STATIC_ASSERT_VECTOR_SPECIFIC_SIZE(Vector3Like,3)
+      return Vector3(quat*p + trans);
+    }
+
+    /// bp = aXb.actInv(ap)
+    template<typename Vector3Like>
+    Vector3 actInv(const Eigen::MatrixBase<Vector3Like> & p) const
+    {
+      EIGEN_STATIC_ASSERT_VECTOR_SPECIFIC_SIZE(Vector3Like,3)
+      return Vector3(quat.conjugate()*(p - trans));
+    }
+
+    /// av = aXb.act(bv)
+    template<typename MotionDerived>
+    Motion act(const MotionDense<MotionDerived> & v) const
+    {
+      Motion res;
+      res.angular().noalias() = quat*v.angular();
+      res.linear().noalias() = quat*v.linear();
+      res.linear() += trans.cross(res.angular());
+      return res;
+    }
+
+    /// bv = aXb.actInv(av)
+    template<typename MotionDerived>
+    Motion actInv(const MotionDense<MotionDerived> & v) const
+    {
+      const Quaternion quat_inv(quat.conjugate());
+      Motion res;
+      res.angular().noalias() = quat_inv*v.angular();
+      res.linear().noalias() = quat_inv*(v.linear() - trans.cross(v.angular()));
+      return res;
+    }
+
+    /// af = aXb.act(bf)
+    template<typename ForceDerived>
+    Force act(const ForceDense<ForceDerived> & f) const
+    {
+      Force res;
+      res.linear().noalias() = quat*f.linear();
+      res.angular().noalias() = quat*f.angular();
+      res.angular() += trans.cross(res.linear());
+      return res;
+    }
+
+    /// bf = aXb.actInv(af)
+    template<typename ForceDerived>
+    Force actInv(const ForceDense<ForceDerived> & f) const
+    {
+      const Quaternion quat_inv(quat.conjugate());
+      Force res;
+      res.linear().noalias() = quat_inv*f.linear();
+      res.angular().noalias() = quat_inv*(f.angular() - trans.cross(f.linear()));
+      return res;
+    }
+
+    /// aMc = aMb.act(bMc)
+    template<int O2>
+    SE3QuaternionTpl act(const SE3QuaternionTpl<Scalar,O2> & m2) const
+    {
+      return SE3QuaternionTpl(quat*m2.rotation(),trans + quat*m2.translation());
+    }
+
+    /// bMc = aMb.actInv(aMc)
+    template<int O2>
+    SE3QuaternionTpl actInv(const SE3QuaternionTpl<Scalar,O2> & m2) const
+    {
+      const Quaternion quat_inv(quat.conjugate());
+      return SE3QuaternionTpl(quat_inv*m2.rotation(),quat_inv*(m2.translation() - trans));
+    }
+
+    /// aMc = aMb * bMc
+    template<int O2>
+    SE3QuaternionTpl operator*(const SE3QuaternionTpl<Scalar,O2> & m2) const
+    { return act(m2); }
+
+    /// aMc = aMb * bMc, with bMc given in the rotation matrix representation.
+    template<int O2>
+    SE3QuaternionTpl operator*(const SE3Tpl<Scalar,O2> & m2) const
+    { return act(SE3QuaternionTpl(m2)); }
+
+    template<int O2>
+    bool operator==(const SE3QuaternionTpl<Scalar,O2> & m2) const
+    {
+      return quat.coeffs() == m2.rotation().coeffs() && trans == m2.translation();
+    }
+
+    template<int O2>
+    bool operator!=(const SE3QuaternionTpl<Scalar,O2> & m2) const
+    { return !(*this == m2); }
+
+    /// \remarks The quaternions q and -q define the same rotation and are considered as equal.
+    template<int O2>
+    bool isApprox(const SE3QuaternionTpl<Scalar,O2> & m2,
+                  const Scalar & prec = Eigen::NumTraits<Scalar>::dummy_precision()) const
+    {
+      return quaternion::defineSameRotation(quat,m2.rotation(),prec)
+      && trans.isApprox(m2.translation(),prec);
+    }
+
+    bool isIdentity(const Scalar & prec = Eigen::NumTraits<Scalar>::dummy_precision()) const
+    {
+      return quaternion::defineSameRotation(quat,Quaternion::Identity(),prec) && trans.isZero(prec);
+    }
+
+    const Quaternion & rotation() const { return quat; }
+    Quaternion & rotation() { return quat; }
+    const Vector3 & translation() const { return trans; }
+    Vector3 & translation() { return trans; }
+
+    /// \returns An expression of *this with the Scalar type casted to NewScalar.
+    template<typename NewScalar>
+    SE3QuaternionTpl<NewScalar,Options> cast() const
+    {
+      typedef SE3QuaternionTpl<NewScalar,Options> ReturnType;
+      return ReturnType(quat.template cast<NewScalar>(),
+                        trans.template cast<NewScalar>());
+    }
+
+    friend std::ostream & operator <<(std::ostream & os, const SE3QuaternionTpl & M)
+    {
+      os
+      << "  q = " << M.quat.coeffs().transpose() << std::endl
+      << "  p = " << M.trans.transpose() << std::endl;
+      return os;
+    }
+
+  protected:
+    Quaternion quat;
+    Vector3 trans;
+
+  }; // struct SE3QuaternionTpl
+
+} // namespace pinocchio
+
+#endif // ifndef __pinocchio_se3_quaternion_hpp__
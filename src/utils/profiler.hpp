@@ -0,0 +1,340 @@
+//
+// Copyright (c) 2018 CNRS
+//
+
+#ifndef __pinocchio_utils_profiler_hpp__
+#define __pinocchio_utils_profiler_hpp__
+
+#include <time.h>
+#include <stdint.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <iomanip>
+
+#if defined(__i386__) || defined(__x86_64__)
+  #include <x86intrin.h>
+#endif
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+///
+/// \brief Opt-in instrumentation of the algorithms.
+///
+/// \details When PINOCCHIO_WITH_PROFILER is defined (CMake option BUILD_WITH_PROFILER), the algorithms open
+///          a named scope for each invocation and each of their passes.
+///          The scopes are aggregated in a call tree that can be printed, or exported as collapsed stacks
+///          for flame graphs or as a Chrome trace (chrome://tracing, Perfetto).
+///          Otherwise, the PINOCCHIO_PROFILER_* macros expand to nothing and have no cost.
+///
+/// \remarks The profiler is not thread safe: scopes opened inside an OpenMP parallel region are ignored.
+///
+#ifdef PINOCCHIO_WITH_PROFILER
+  #define PINOCCHIO_PROFILER_CONCAT_IMPL(a,b) a##b
+  #define PINOCCHIO_PROFILER_CONCAT(a,b) PINOCCHIO_PROFILER_CONCAT_IMPL(a,b)
+  /// \brief Times the enclosing scope under the given name (a string whose lifetime exceeds the profiler's one).
+  #define PINOCCHIO_PROFILER_SCOPE(name) \
+    ::pinocchio::profiler::ScopedTimer PINOCCHIO_PROFILER_CONCAT(pinocchio_profiler_scope_,__LINE__)(name)
+#else
+  #define PINOCCHIO_PROFILER_SCOPE(name)
+#endif
+
+namespace pinocchio
+{
+  namespace profiler
+  {
+    /// \brief Time stamp counter, or nanoseconds on architectures without one.
+    inline uint64_t cycles()
+    {
+#if defined(__i386__) || defined(__x86_64__)
+      return (uint64_t)__rdtsc();
+#else
+      struct timespec t; clock_gettime(CLOCK_MONOTONIC,&t);
+      return (uint64_t)t.tv_sec*1000000000ull + (uint64_t)t.tv_nsec;
+#endif
+    }
+
+    inline uint64_t nanoseconds()
+    {
+      struct timespec t; clock_gettime(CLOCK_MONOTONIC,&t);
+      return (uint64_t)t.tv_sec*1000000000ull + (uint64_t)t.tv_nsec;
+    }
+
+    ///
+    /// \brief Node of the call tree, aggregating all the invocations of a scope within the same parent scope.
+    ///
+    struct Node
+    {
+      Node(const char * name, Node * parent)
+      : name(name), parent(parent)
+      , count(0), total_cycles(0), total_ns(0), min_ns(0), max_ns(0)
+      {}
+
+      ~Node()
+      {
+        for(size_t k = 0; k < children.size(); ++k)
+          delete children[k];
+      }
+
+      Node * child(const char * child_name)
+      {
+        for(size_t k = 0; k < children.size(); ++k)
+          if(children[k]->name == child_name || std::strcmp(children[k]->name,child_name) == 0)
+            return children[k];
+        children.push_back(new Node(child_name,this));
+        return children.back();
+      }
+
+      /// \brief Time spent in this scope but not in any of its children.
+      uint64_t self_ns() const
+      {
+        uint64_t children_ns = 0;
+        for(size_t k = 0; k < children.size(); ++k)
+          children_ns += children[k]->total_ns;
+        return children_ns < total_ns ? total_ns - children_ns : 0;
+      }
+
+      /// \brief Path of the node from the root, with separator between the scope names.
+      std::string path(const char * separator) const
+      {
+        if(parent == NULL || parent->parent == NULL) return name;
+        return parent->path(separator) + separator + name;
+      }
+
+      const char * name;
+      Node * parent;
+      std::vector<Node *> children;
+
+      size_t count;
+      uint64_t total_cycles, total_ns, min_ns, max_ns;
+
+    private:
+      Node(const Node &);
+      Node & operator=(const Node &);
+    };
+
+    ///
+    /// \brief Single invocation of a scope, kept for the Chrome trace export.
+    ///
+    struct Event
+    {
+      const Node * node;
+      uint64_t begin_ns, end_ns;
+    };
+
+    ///
+    /// \brief Records the scopes opened by PINOCCHIO_PROFILER_SCOPE.
+    ///
+    class Profiler
+    {
+    public:
+
+      static Profiler & instance()
+      {
+        static Profiler profiler;
+        return profiler;
+      }
+
+      /// \brief Clears all the recorded timings. Must not be called while a scope is open.
+      void reset()
+      {
+        for(size_t k = 0; k < m_root.children.size(); ++k)
+          delete m_root.children[k];
+        m_root.children.clear();
+        m_stack.clear();
+        m_events.clear();
+        m_origin_ns = nanoseconds();
+      }
+
+      ///
+      /// \brief Enables or disables the recording of each invocation, needed by writeChromeTrace.
+      ///
+      /// \param[in] max_events Maximal number of recorded events, the next ones are dropped.
+      ///
+      void setRecordEvents(const bool record, const size_t max_events = 1000000)
+      {
+        m_record_events = record;
+        m_max_events = max_events;
+      }
+
+      void enter(const char * name)
+      {
+        if(inParallelRegion()) return;
+
+        Frame frame;
+        frame.node = (m_stack.empty() ? &m_root : m_stack.back().node)->child(name);
+        frame.begin_ns = nanoseconds();
+        frame.begin_cycles = cycles();
+        m_stack.push_back(frame);
+      }
+
+      void leave()
+      {
+        if(inParallelRegion() || m_stack.empty()) return;
+
+        const uint64_t end_cycles = cycles();
+        const uint64_t end_ns = nanoseconds();
+
+        const Frame & frame = m_stack.back();
+        Node & node = *frame.node;
+        const uint64_t duration = end_ns - frame.begin_ns;
+
+        if(node.count == 0 || duration < node.min_ns) node.min_ns = duration;
+        if(duration > node.max_ns) node.max_ns = duration;
+        node.total_ns += duration;
+        node.total_cycles += end_cycles - frame.begin_cycles;
+        ++node.count;
+
+        if(m_record_events && m_events.size() < m_max_events)
+        {
+          Event event;
+          event.node = &node;
+          event.begin_ns = frame.begin_ns; event.end_ns = end_ns;
+          m_events.push_back(event);
+        }
+
+        m_stack.pop_back();
+      }
+
+      /// \brief Root of the call tree. Its children are the outermost scopes.
+      const Node & root() const { return m_root; }
+
+      const std::vector<Event> & events() const { return m_events; }
+
+      /// \brief Finds a node from its path, e.g. "rnea/forward pass/JointModelFreeFlyer".
+      const Node * find(const std::string & path) const
+      {
+        const Node * node = &m_root;
+        size_t begin = 0;
+        while(node != NULL && begin <= path.size())
+        {
+          size_t end = path.find('/',begin);
+          if(end == std::string::npos) end = path.size();
+          const std::string name = path.substr(begin,end-begin);
+          const Node * next = NULL;
+          for(size_t k = 0; k < node->children.size(); ++k)
+            if(name == node->children[k]->name) { next = node->children[k]; break; }
+          node = next;
+          begin = end+1;
+        }
+        return node;
+      }
+
+      ///
+      /// \brief Prints the call tree with, for each scope, the number of calls, the total time,
+      ///        the mean time and cycles per call and the share of the parent scope.
+      ///
+      void report(std::ostream & os) const
+      {
+        os << std::left << std::setw(48) << "scope"
+           << std::right << std::setw(10) << "calls" << std::setw(14) << "total (us)"
+           << std::setw(12) << "mean (ns)" << std::setw(14) << "mean (cycles)" << std::setw(10) << "parent %" << std::endl;
+        for(size_t k = 0; k < m_root.children.size(); ++k)
+          report(os,*m_root.children[k],0);
+      }
+
+      ///
+      /// \brief Writes the call tree as collapsed stacks, one "scope;scope;scope self_time_ns" line per node,
+      ///        as expected by flamegraph.pl or speedscope.
+      ///
+      void writeFlameGraph(std::ostream & os) const
+      {
+        for(size_t k = 0; k < m_root.children.size(); ++k)
+          writeFlameGraph(os,*m_root.children[k]);
+      }
+
+      ///
+      /// \brief Writes the recorded events in the Chrome trace event format.
+      ///
+      /// \remarks Requires setRecordEvents(true) before the profiled calls.
+      ///
+      void writeChromeTrace(std::ostream & os) const
+      {
+        os << "{\"traceEvents\":[" << std::endl;
+        os << std::fixed << std::setprecision(3);
+        for(size_t k = 0; k < m_events.size(); ++k)
+        {
+          const Event & event = m_events[k];
+          os << "{\"name\":\"" << event.node->name << "\",\"cat\":\"pinocchio\",\"ph\":\"X\""
+             << ",\"ts\":" << 1e-3*(double)(event.begin_ns - m_origin_ns)
+             << ",\"dur\":" << 1e-3*(double)(event.end_ns - event.begin_ns)
+             << ",\"pid\":0,\"tid\":0}" << (k+1 < m_events.size() ? "," : "") << std::endl;
+        }
+        os << "],\"displayTimeUnit\":\"ns\"}" << std::endl;
+      }
+
+    protected:
+
+      struct Frame
+      {
+        Node * node;
+        uint64_t begin_ns, begin_cycles;
+      };
+
+      Profiler()
+      : m_root("",NULL), m_record_events(false), m_max_events(0)
+      , m_origin_ns(nanoseconds())
+      {}
+
+      static bool inParallelRegion()
+      {
+#ifdef _OPENMP
+        return omp_in_parallel() != 0;
+#else
+        return false;
+#endif
+      }
+
+      static void report(std::ostream & os, const Node & node, const int depth)
+      {
+        const double mean_ns = node.count ? (double)node.total_ns/(double)node.count : 0.;
+        const double mean_cycles = node.count ? (double)node.total_cycles/(double)node.count : 0.;
+        const bool has_parent = node.parent != NULL && node.parent->parent != NULL && node.parent->total_ns > 0;
+
+        os << std::left << std::setw(48) << (std::string(2*(size_t)depth,' ') + node.name)
+           << std::right << std::fixed << std::setprecision(1)
+           << std::setw(10) << node.count << std::setw(14) << 1e-3*(double)node.total_ns
+           << std::setw(12) << mean_ns << std::setw(14) << mean_cycles;
+        if(has_parent)
+          os << std::setw(10) << 100.*(double)node.total_ns/(double)node.parent->total_ns;
+        os << std::endl;
+
+        for(size_t k = 0; k < node.children.size(); ++k)
+          report(os,*node.children[k],depth+1);
+      }
+
+      static void writeFlameGraph(std::ostream & os, const Node & node)
+      {
+        os << node.path(";") << " " << node.self_ns() << std::endl;
+        for(size_t k = 0; k < node.children.size(); ++k)
+          writeFlameGraph(os,*node.children[k]);
+      }
+
+      Node m_root;
+      std::vector<Frame> m_stack;
+      std::vector<Event> m_events;
+      bool m_record_events;
+      size_t m_max_events;
+      uint64_t m_origin_ns;
+
+    private:
+      Profiler(const Profiler &);
+      Profiler & operator=(const Profiler &);
+    };
+
+    ///
+    /// \brief Opens a scope of the profiler for its lifetime.
+    ///
+    struct ScopedTimer
+    {
+      explicit ScopedTimer(const char * name) { Profiler::instance().enter(name); }
+      ~ScopedTimer() { Profiler::instance().leave(); }
+    };
+
+  } // namespace profiler
+} // namespace pinocchio
+
+#endif // ifndef __pinocchio_utils_profiler_hpp__
@@ -83,6 +83,40 @@ BOOST_AUTO_TEST_CASE ( test_cholesky )
   BOOST_CHECK(Mv.isApprox(M*v, 1e-12));
   Mv = v;                 pinocchio::cholesky::UDUtv(model,data,Mv);
   BOOST_CHECK(Mv.isApprox(M*v, 1e-12));
+  
+  // Multiple right-hand sides
+  const Eigen::MatrixXd B = Eigen::MatrixXd::Random(model.nv,7);
+  
+  Eigen::MatrixXd UB = B; pinocchio::cholesky::Uv(model,data,UB);
+  BOOST_CHECK(UB.isApprox(U*B, 1e-12));
+  
+  Eigen::MatrixXd UtB = B; pinocchio::cholesky::Utv(model,data,UtB);
+  BOOST_CHECK(UtB.isApprox(U.transpose()*B, 1e-12));
+  
+  Eigen::MatrixXd UiB = B; pinocchio::cholesky::Uiv(model,data,UiB);
+  BOOST_CHECK(UiB.isApprox(U.inverse()*B, 1e-12));
+  
+  Eigen::MatrixXd UtiB = B; pinocchio::cholesky::Utiv(model,data,UtiB);
+  BOOST_CHECK(UtiB.isApprox(U.transpose().inverse()*B, 1e-12));
+  
+  Eigen::MatrixXd MiB = B; pinocchio::cholesky::solve(model,data,MiB);
+  BOOST_CHECK(MiB.isApprox(M.inverse()*B, 1e-12));
+  
+  Eigen::MatrixXd MB = pinocchio::cholesky::Mv(model,data,B);
+  BOOST_CHECK(MB.isApprox(M*B, 1e-12));
+  MB = B;                 pinocchio::cholesky::UDUtv(model,data,MB);
+  BOOST_CHECK(MB.isApprox(M*B, 1e-12));
+  
+  // Column-major blocks and row-major matrices
+  Eigen::MatrixXd BB = Eigen::MatrixXd::Random(model.nv,10);
+  Eigen::MatrixXd BB_ref = BB;
+  pinocchio::cholesky::solve(model,data,BB.middleCols(2,5));
+  BOOST_CHECK(BB.middleCols(2,5).isApprox(M.inverse()*BB_ref.middleCols(2,5), 1e-12));
+  BOOST_CHECK(BB.leftCols(2) == BB_ref.leftCols(2));
+  
+  typedef Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> RowMatrixXd;
+  RowMatrixXd Brow = B; pinocchio::cholesky::solve(model,data,Brow);
+  BOOST_CHECK(Brow.isApprox(M.inverse()*B, 1e-12));
 }
 
 
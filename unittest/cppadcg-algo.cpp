@@ -14,10 +14,19 @@
 #include "pinocchio/algorithm/rnea.hpp"
 #include "pinocchio/algorithm/aba.hpp"
 #include "pinocchio/algorithm/joint-configuration.hpp"
+#include "pinocchio/algorithm/frames.hpp"
+#include "pinocchio/algorithm/center-of-mass.hpp"
+#include "pinocchio/algorithm/centroidal.hpp"
+#include "pinocchio/algorithm/centroidal-derivatives.hpp"
+
+#include "pinocchio/codegen/code-generator-algo.hpp"
 
 #include "pinocchio/parsers/sample-models.hpp"
 
 #include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <dlfcn.h>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/utility/binary.hpp>
@@ -111,4 +120,378 @@ BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
     BOOST_CHECK(M_map.isApprox(data.M));
   }
 
+  BOOST_AUTO_TEST_CASE(test_frames_forward_kinematics_code_generation)
+  {
+    using namespace pinocchio;
+    
+    Model model;
+    buildModels::humanoidRandom(model);
+    model.lowerPositionLimit.head<3>().fill(-1.);
+    model.upperPositionLimit.head<3>().fill(1.);
+    Data data(model);
+    
+    std::vector<FrameIndex> frame_ids;
+    for(FrameIndex frame_id = 1; frame_id < (FrameIndex)model.nframes; ++frame_id)
+      frame_ids.push_back(frame_id);
+    
+    CodeGenFramesForwardKinematics<double> frames_fk_code_gen(model,frame_ids);
+    frames_fk_code_gen.initLib();
+    frames_fk_code_gen.loadLib();
+    
+    const Eigen::VectorXd q = randomConfiguration(model);
+    frames_fk_code_gen.evalFunction(q);
+    
+    framesForwardKinematics(model,data,q);
+    for(size_t k = 0; k < frame_ids.size(); ++k)
+      BOOST_CHECK(frames_fk_code_gen.oMf[k].isApprox(data.oMf[frame_ids[k]]));
+  }
+  
+  BOOST_AUTO_TEST_CASE(test_frame_jacobians_code_generation)
+  {
+    using namespace pinocchio;
+    
+    Model model;
+    buildModels::humanoidRandom(model);
+    model.lowerPositionLimit.head<3>().fill(-1.);
+    model.upperPositionLimit.head<3>().fill(1.);
+    Data data(model);
+    
+    std::vector<FrameIndex> frame_ids;
+    for(FrameIndex frame_id = 1; frame_id < (FrameIndex)model.nframes; ++frame_id)
+      frame_ids.push_back(frame_id);
+    
+    const Eigen::VectorXd q = randomConfiguration(model);
+    computeJointJacobians(model,data,q);
+    updateFramePlacements(model,data);
+    
+    const ReferenceFrame rfs[2] = {LOCAL, WORLD};
+    for(int r = 0; r < 2; ++r)
+    {
+      CodeGenFrameJacobians<double> frame_jacobians_code_gen(model,frame_ids,rfs[r]);
+      frame_jacobians_code_gen.initLib();
+      frame_jacobians_code_gen.loadLib();
+      frame_jacobians_code_gen.evalFunction(q);
+      
+      for(size_t k = 0; k < frame_ids.size(); ++k)
+      {
+        Data::Matrix6x J_ref(Data::Matrix6x::Zero(6,model.nv));
+        getFrameJacobian(model,data,frame_ids[k],rfs[r],J_ref);
+        BOOST_CHECK(frame_jacobians_code_gen.J[k].isApprox(J_ref));
+      }
+    }
+  }
+  
+  BOOST_AUTO_TEST_CASE(test_frame_jacobians_time_variation_code_generation)
+  {
+    using namespace pinocchio;
+    
+    Model model;
+    buildModels::humanoidRandom(model);
+    model.lowerPositionLimit.head<3>().fill(-1.);
+    model.upperPositionLimit.head<3>().fill(1.);
+    Data data(model);
+    
+    std::vector<FrameIndex> frame_ids;
+    for(FrameIndex frame_id = 1; frame_id < (FrameIndex)model.nframes; ++frame_id)
+      frame_ids.push_back(frame_id);
+    
+    CodeGenFrameJacobiansTimeVariation<double> frame_jacobians_time_variation_code_gen(model,frame_ids,LOCAL);
+    frame_jacobians_time_variation_code_gen.initLib();
+    frame_jacobians_time_variation_code_gen.loadLib();
+    
+    const Eigen::VectorXd q = randomConfiguration(model);
+    const Eigen::VectorXd v = Eigen::VectorXd::Random(model.nv);
+    frame_jacobians_time_variation_code_gen.evalFunction(q,v);
+    
+    computeJointJacobiansTimeVariation(model,data,q,v);
+    updateFramePlacements(model,data);
+    for(size_t k = 0; k < frame_ids.size(); ++k)
+    {
+      Data::Matrix6x dJ_ref(Data::Matrix6x::Zero(6,model.nv));
+      getFrameJacobianTimeVariation(model,data,frame_ids[k],LOCAL,dJ_ref);
+      BOOST_CHECK(frame_jacobians_time_variation_code_gen.dJ[k].isApprox(dJ_ref));
+    }
+  }
+  
+  BOOST_AUTO_TEST_CASE(test_ccrba_code_generation)
+  {
+    using namespace pinocchio;
+    
+    Model model;
+    buildModels::humanoidRandom(model);
+    model.lowerPositionLimit.head<3>().fill(-1.);
+    model.upperPositionLimit.head<3>().fill(1.);
+    Data data(model);
+    
+    CodeGenCCRBA<double> ccrba_code_gen(model);
+    ccrba_code_gen.initLib();
+    ccrba_code_gen.loadLib();
+    
+    const Eigen::VectorXd q = randomConfiguration(model);
+    const Eigen::VectorXd v = Eigen::VectorXd::Random(model.nv);
+    ccrba_code_gen.evalFunction(q,v);
+    
+    ccrba(model,data,q,v);
+    BOOST_CHECK(ccrba_code_gen.Ag.isApprox(data.Ag));
+  }
+  
+  BOOST_AUTO_TEST_CASE(test_dccrba_code_generation)
+  {
+    using namespace pinocchio;
+    
+    Model model;
+    buildModels::humanoidRandom(model);
+    model.lowerPositionLimit.head<3>().fill(-1.);
+    model.upperPositionLimit.head<3>().fill(1.);
+    Data data(model);
+    
+    CodeGenDCCRBA<double> dccrba_code_gen(model);
+    dccrba_code_gen.initLib();
+    dccrba_code_gen.loadLib();
+    
+    const Eigen::VectorXd q = randomConfiguration(model);
+    const Eigen::VectorXd v = Eigen::VectorXd::Random(model.nv);
+    dccrba_code_gen.evalFunction(q,v);
+    
+    dccrba(model,data,q,v);
+    BOOST_CHECK(dccrba_code_gen.Ag.isApprox(data.Ag));
+    BOOST_CHECK(dccrba_code_gen.dAg.isApprox(data.dAg));
+  }
+  
+  BOOST_AUTO_TEST_CASE(test_jacobian_center_of_mass_code_generation)
+  {
+    using namespace pinocchio;
+    
+    Model model;
+    buildModels::humanoidRandom(model);
+    model.lowerPositionLimit.head<3>().fill(-1.);
+    model.upperPositionLimit.head<3>().fill(1.);
+    Data data(model);
+    
+    CodeGenJacobianCenterOfMass<double> jacobian_com_code_gen(model);
+    jacobian_com_code_gen.initLib();
+    jacobian_com_code_gen.loadLib();
+    
+    const Eigen::VectorXd q = randomConfiguration(model);
+    jacobian_com_code_gen.evalFunction(q);
+    
+    jacobianCenterOfMass(model,data,q,false);
+    BOOST_CHECK(jacobian_com_code_gen.com.isApprox(data.com[0]));
+    BOOST_CHECK(jacobian_com_code_gen.Jcom.isApprox(data.Jcom));
+  }
+  
+  BOOST_AUTO_TEST_CASE(test_centroidal_dynamics_derivatives_code_generation)
+  {
+    using namespace pinocchio;
+    
+    Model model;
+    buildModels::humanoidRandom(model);
+    model.lowerPositionLimit.head<3>().fill(-1.);
+    model.upperPositionLimit.head<3>().fill(1.);
+    Data data(model);
+    
+    CodeGenCentroidalDynamicsDerivatives<double> centroidal_derivatives_code_gen(model);
+    centroidal_derivatives_code_gen.initLib();
+    centroidal_derivatives_code_gen.loadLib();
+    
+    const Eigen::VectorXd q = randomConfiguration(model);
+    const Eigen::VectorXd v = Eigen::VectorXd::Random(model.nv);
+    const Eigen::VectorXd a = Eigen::VectorXd::Random(model.nv);
+    centroidal_derivatives_code_gen.evalFunction(q,v,a);
+    
+    Data::Matrix6x dhdot_dq(Data::Matrix6x::Zero(6,model.nv));
+    Data::Matrix6x dhdot_dv(Data::Matrix6x::Zero(6,model.nv));
+    Data::Matrix6x dhdot_da(Data::Matrix6x::Zero(6,model.nv));
+    computeCentroidalDynamicsDerivatives(model,data,q,v,a,dhdot_dq,dhdot_dv,dhdot_da);
+    
+    BOOST_CHECK(centroidal_derivatives_code_gen.dhdot_dq.isApprox(dhdot_dq));
+    BOOST_CHECK(centroidal_derivatives_code_gen.dhdot_dv.isApprox(dhdot_dv));
+    BOOST_CHECK(centroidal_derivatives_code_gen.dhdot_da.isApprox(dhdot_da));
+  }
+
+  BOOST_AUTO_TEST_CASE(test_sparse_jacobian_code_generation)
+  {
+    using namespace pinocchio;
+    typedef Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> RowMatrixXd;
+    
+    Model model;
+    buildModels::humanoidRandom(model);
+    model.lowerPositionLimit.head<3>().fill(-1.);
+    model.upperPositionLimit.head<3>().fill(1.);
+    
+    const Eigen::VectorXd q = randomConfiguration(model);
+    const Eigen::VectorXd v = Eigen::VectorXd::Random(model.nv);
+    const Eigen::VectorXd a = Eigen::VectorXd::Random(model.nv);
+    
+    const Eigen::DenseIndex nx = model.nq + 2*model.nv;
+    
+    // RNEA, with the joint_support pattern and a CSR storage
+    {
+      CodeGenRNEA<double> rnea_code_gen(model);
+      rnea_code_gen.setBuildSparseJacobian(true);
+      rnea_code_gen.setSparseStorageOrder(Eigen::RowMajor);
+      rnea_code_gen.initLib();
+      rnea_code_gen.loadLib();
+      
+      rnea_code_gen.evalJacobian(q,v,a);
+      Eigen::MatrixXd jac_ref(model.nv,nx);
+      jac_ref << rnea_code_gen.dtau_dq, rnea_code_gen.dtau_dv, rnea_code_gen.dtau_da;
+      
+      rnea_code_gen.evalSparseJacobian(q,v,a);
+      Eigen::Map< Eigen::SparseMatrix<double,Eigen::RowMajor,int> > jac_sparse
+      = rnea_code_gen.sparseJacobian<Eigen::RowMajor>();
+      BOOST_CHECK((size_t)jac_sparse.nonZeros() == rnea_code_gen.jacobianSparsity().nnz());
+      BOOST_CHECK((size_t)jac_sparse.nonZeros() < (size_t)(model.nv*nx));
+      
+      // rebuild the dense matrix from the (row, col, value) triplets
+      const std::vector<size_t> & rows = rnea_code_gen.jacobianSparsity().row_indexes;
+      const std::vector<size_t> & cols = rnea_code_gen.jacobianSparsity().col_indexes;
+      Eigen::MatrixXd jac_dense(Eigen::MatrixXd::Zero(model.nv,nx));
+      for(size_t k = 0; k < rows.size(); ++k)
+        jac_dense((Eigen::DenseIndex)rows[k],(Eigen::DenseIndex)cols[k]) = jac_sparse.valuePtr()[k];
+      
+      BOOST_CHECK(jac_dense.isApprox(jac_ref));
+      BOOST_CHECK(Eigen::MatrixXd(jac_sparse.toDense()).isApprox(jac_ref));
+    }
+    
+    // ABA, with the joint_tree pattern and a CSC storage
+    {
+      CodeGenABA<double> aba_code_gen(model);
+      aba_code_gen.setBuildSparseJacobian(true);
+      aba_code_gen.setSparseStorageOrder(Eigen::ColMajor);
+      aba_code_gen.initLib();
+      aba_code_gen.loadLib();
+      
+      aba_code_gen.evalJacobian(q,v,a);
+      Eigen::MatrixXd jac_ref(model.nv,nx);
+      jac_ref << aba_code_gen.da_dq, aba_code_gen.da_dv, aba_code_gen.da_dtau;
+      
+      aba_code_gen.evalSparseJacobian(q,v,a);
+      Eigen::Map< Eigen::SparseMatrix<double,Eigen::ColMajor,int> > jac_sparse
+      = aba_code_gen.sparseJacobian<Eigen::ColMajor>();
+      BOOST_CHECK((size_t)jac_sparse.nonZeros() == aba_code_gen.jacobianSparsity().nnz());
+      
+      const std::vector<size_t> & rows = aba_code_gen.jacobianSparsity().row_indexes;
+      const std::vector<size_t> & cols = aba_code_gen.jacobianSparsity().col_indexes;
+      RowMatrixXd jac_dense(RowMatrixXd::Zero(model.nv,nx));
+      for(size_t k = 0; k < rows.size(); ++k)
+        jac_dense((Eigen::DenseIndex)rows[k],(Eigen::DenseIndex)cols[k]) = jac_sparse.valuePtr()[k];
+      
+      BOOST_CHECK(jac_dense.isApprox(jac_ref));
+      BOOST_CHECK(Eigen::MatrixXd(jac_sparse.toDense()).isApprox(jac_ref));
+    }
+  }
+
+  BOOST_AUTO_TEST_CASE(test_batch_code_generation)
+  {
+    using namespace pinocchio;
+    
+    Model model;
+    buildModels::humanoidRandom(model);
+    model.lowerPositionLimit.head<3>().fill(-1.);
+    model.upperPositionLimit.head<3>().fill(1.);
+    
+    CodeGenRNEA<double> rnea_code_gen(model);
+    rnea_code_gen.setBuildBatch(true);
+    rnea_code_gen.initLib();
+    rnea_code_gen.loadLib();
+    
+    // N is neither a multiple of the number of threads nor of the number of lanes of the kernel (4 by default),
+    // so that the last chunk is smaller than the others and ends with a partial block of lanes.
+    const Eigen::DenseIndex N = 7;
+    const int num_threads = 3;
+    
+    const Eigen::DenseIndex nq = model.nq, nv = model.nv;
+    Eigen::MatrixXd X(rnea_code_gen.getInputDimension(),N);
+    for(Eigen::DenseIndex k = 0; k < N; ++k)
+    {
+      X.col(k).head(nq) = randomConfiguration(model);
+      X.col(k).tail(2*nv).setRandom();
+    }
+    
+    Eigen::MatrixXd Y_ref(rnea_code_gen.getOutputDimension(),N);
+    for(Eigen::DenseIndex k = 0; k < N; ++k)
+    {
+      rnea_code_gen.evalFunction(X.col(k).head(nq),X.col(k).segment(nq,nv),X.col(k).tail(nv));
+      Y_ref.col(k) = rnea_code_gen.res;
+    }
+    
+    Eigen::MatrixXd Y(Eigen::MatrixXd::Zero(rnea_code_gen.getOutputDimension(),N));
+    rnea_code_gen.evalFunctionBatch(X,Y,num_threads);
+    BOOST_CHECK(Y.isApprox(Y_ref));
+    
+    Y.setZero();
+    rnea_code_gen.evalFunctionBatch(X,Y);
+    BOOST_CHECK(Y.isApprox(Y_ref));
+    
+    // a single input
+    Y.setZero();
+    rnea_code_gen.evalFunctionBatch(X.leftCols(1),Y.leftCols(1),num_threads);
+    BOOST_CHECK(Y.leftCols(1).isApprox(Y_ref.leftCols(1)));
+  }
+
+  BOOST_AUTO_TEST_CASE(test_standalone_source_code_generation)
+  {
+    using namespace pinocchio;
+    
+    Model model;
+    buildModels::humanoidRandom(model);
+    model.lowerPositionLimit.head<3>().fill(-1.);
+    model.upperPositionLimit.head<3>().fill(1.);
+    
+    CodeGenRNEA<double> rnea_code_gen(model);
+    rnea_code_gen.setBuildBatch(true);
+    rnea_code_gen.initLib();
+    rnea_code_gen.loadLib();
+    
+    // the standalone source reuses the function recorded by initLib
+    const std::string c_name = "standalone_rnea";
+    {
+      std::ofstream source((c_name + ".c").c_str());
+      source << "#include <math.h>\n\n";
+      rnea_code_gen.generateStandaloneSource(source,c_name);
+    }
+    
+    const std::string command = "gcc -std=c99 -O1 -shared -fPIC " + c_name + ".c -o ./lib" + c_name + ".so -lm";
+    BOOST_REQUIRE(std::system(command.c_str()) == 0);
+    
+    void * handle = dlopen(("./lib" + c_name + ".so").c_str(),RTLD_NOW);
+    BOOST_REQUIRE(handle != NULL);
+    
+    typedef void (*Function)(const double *, double *);
+    typedef void (*BatchFunction)(const double *, double *, unsigned long);
+    Function rnea_standalone = reinterpret_cast<Function>(dlsym(handle,c_name.c_str()));
+    Function rnea_jacobian_standalone = reinterpret_cast<Function>(dlsym(handle,(c_name + "_jacobian").c_str()));
+    BatchFunction rnea_batch_standalone = reinterpret_cast<BatchFunction>(dlsym(handle,(c_name + "_batch").c_str()));
+    BOOST_REQUIRE(rnea_standalone != NULL && rnea_jacobian_standalone != NULL && rnea_batch_standalone != NULL);
+    
+    const Eigen::DenseIndex nq = model.nq, nv = model.nv;
+    const Eigen::DenseIndex nx = rnea_code_gen.getInputDimension();
+    Eigen::VectorXd x(nx);
+    x << randomConfiguration(model), Eigen::VectorXd::Random(2*nv);
+    
+    rnea_code_gen.evalFunction(x.head(nq),x.segment(nq,nv),x.tail(nv));
+    rnea_code_gen.evalJacobian(x.head(nq),x.segment(nq,nv),x.tail(nv));
+    
+    Eigen::VectorXd tau(nv);
+    rnea_standalone(x.data(),tau.data());
+    BOOST_CHECK(tau.isApprox(rnea_code_gen.res));
+    
+    Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> jac(nv,nx);
+    rnea_jacobian_standalone(x.data(),jac.data());
+    BOOST_CHECK(jac.leftCols(nq).isApprox(rnea_code_gen.dtau_dq));
+    BOOST_CHECK(jac.middleCols(nq,nv).isApprox(rnea_code_gen.dtau_dv));
+    BOOST_CHECK(jac.rightCols(nv).isApprox(rnea_code_gen.dtau_da));
+    
+    const Eigen::DenseIndex N = 3;
+    Eigen::MatrixXd X(nx,N), Y(nv,N), Y_ref(nv,N);
+    for(Eigen::DenseIndex k = 0; k < N; ++k)
+      X.col(k) << randomConfiguration(model), Eigen::VectorXd::Random(2*nv);
+    rnea_code_gen.evalFunctionBatch(X,Y_ref);
+    rnea_batch_standalone(X.data(),Y.data(),(unsigned long)N);
+    BOOST_CHECK(Y.isApprox(Y_ref));
+    
+    dlclose(handle);
+  }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -103,6 +103,34 @@ BOOST_AUTO_TEST_CASE ( test_update_placements )
   BOOST_CHECK(data.oMf[frame_idx].isApprox(data_ref.oMf[frame_idx]));
 }
 
+BOOST_AUTO_TEST_CASE ( test_update_placements_quaternion )
+{
+  using namespace Eigen;
+  using namespace pinocchio;
+
+  pinocchio::Model model;
+  pinocchio::buildModels::humanoidRandom(model);
+  Model::Index parent_idx = model.existJointName("rarm2_joint")?model.getJointId("rarm2_joint"):(Model::Index)(model.njoints-1);
+  const std::string & frame_name = std::string( model.names[parent_idx]+ "_frame");
+  const SE3 & framePlacement = SE3::Random();
+  const Model::FrameIndex frame_idx = model.addFrame(Frame (frame_name, parent_idx, 0, framePlacement, OP_FRAME));
+  pinocchio::Data data(model);
+  pinocchio::Data data_ref(model);
+
+  // Placements edited after addFrame
+  model.frames[frame_idx].placement = SE3::Random();
+  model.jointPlacements[parent_idx] = SE3::Random();
+
+  VectorXd q = VectorXd::Ones(model.nq);
+  q.middleRows<4> (3).normalize();
+
+  framesForwardKinematics(model, data_ref, q);
+  framesForwardKinematicsQuaternion(model, data, q);
+
+  for(Model::FrameIndex i = 0; i < (Model::FrameIndex)model.nframes; ++i)
+    BOOST_CHECK(data.oMf_quat[i].toSE3().isApprox(data_ref.oMf[i]));
+}
+
 BOOST_AUTO_TEST_CASE ( test_update_single_placement )
 {
   using namespace Eigen;
@@ -229,6 +257,51 @@ BOOST_AUTO_TEST_CASE ( test_jacobian )
   BOOST_CHECK(Jff.isApprox(Jjj));
 }
 
+BOOST_AUTO_TEST_CASE ( test_frame_jacobians )
+{
+  using namespace Eigen;
+  using namespace pinocchio;
+  
+  Model model;
+  buildModels::humanoidRandom(model);
+  const Model::JointIndex parent_idx = (Model::JointIndex)(model.njoints-1);
+  const SE3 framePlacement = SE3::Random();
+  model.addFrame(Frame("frame1", parent_idx, 0, framePlacement, OP_FRAME));
+  model.addFrame(Frame("frame2", parent_idx, 0, framePlacement, OP_FRAME));
+  model.addFrame(Frame("frame3", parent_idx, 0, SE3::Random(), OP_FRAME));
+  
+  pinocchio::Data data(model);
+  
+  model.lowerPositionLimit.head<7>().fill(-1.);
+  model.upperPositionLimit.head<7>().fill( 1.);
+  VectorXd q = randomConfiguration(model);
+  
+  std::vector<Model::FrameIndex> frame_ids;
+  for(Model::FrameIndex k = 0; k < (Model::FrameIndex)model.nframes; k += 3)
+    frame_ids.push_back(k);
+  frame_ids.push_back(model.getFrameId("frame1"));
+  frame_ids.push_back(model.getFrameId("frame2"));
+  frame_ids.push_back(model.getFrameId("frame3"));
+  frame_ids.push_back(model.getFrameId("frame1"));
+  
+  computeJointJacobians(model,data,q);
+  framesForwardKinematics(model,data,q);
+  
+  const ReferenceFrame rfs[2] = {LOCAL, WORLD};
+  for(int r = 0; r < 2; ++r)
+  {
+    MatrixXd J(6*(DenseIndex)frame_ids.size(),model.nv); J.setZero();
+    getFrameJacobians(model,data,frame_ids,rfs[r],J);
+    
+    for(size_t k = 0; k < frame_ids.size(); ++k)
+    {
+      Data::Matrix6x J_ref(6,model.nv); J_ref.setZero();
+      getFrameJacobian(model,data,frame_ids[k],rfs[r],J_ref);
+      BOOST_CHECK(J.middleRows<6>(6*(DenseIndex)k).isApprox(J_ref));
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE ( test_frame_jacobian_time_variation )
 {
   using namespace Eigen;
@@ -12,6 +12,7 @@
 #include "pinocchio/multibody/geometry.hpp"
 #include "pinocchio/algorithm/kinematics.hpp"
 #include "pinocchio/algorithm/geometry.hpp"
+#include "pinocchio/algorithm/joint-configuration.hpp"
 #include "pinocchio/parsers/urdf.hpp"
 
 #include <vector>
@@ -106,6 +107,383 @@ BOOST_AUTO_TEST_CASE ( simple_boxes )
   BOOST_CHECK(computeCollision(geomModel,geomData,0) == false);
 }
 
+BOOST_AUTO_TEST_CASE ( continuous_collisions )
+{
+  using namespace pinocchio;
+  Model model;
+  GeometryModel geomModel;
+
+  boost::shared_ptr<fcl::Box> sample(new fcl::Box(1, 1, 1));
+  const char * names[2] = { "planar1", "planar2" };
+  for(int k = 0; k < 2; ++k)
+  {
+    const std::string name(names[k]);
+    Model::JointIndex idx = model.addJoint(0,JointModelPlanar(),SE3::Identity(),name + "_joint");
+    model.appendBodyToJoint(idx,Inertia::Random(),SE3::Identity());
+    geomModel.addGeometryObject(GeometryObject(name + "_collision_object",0,idx,
+                                               sample,SE3::Identity(), "", Eigen::Vector3d::Ones()));
+  }
+  geomModel.addAllCollisionPairs();
+
+  Data data(model);
+  GeometryData geomData(geomModel);
+  computeBodyRadius(model, geomModel, geomData);
+
+  Eigen::VectorXd q0(model.nq), q1(model.nq);
+  // Both end points are collision free but the first box goes through the second one.
+  q0 << -3, 0, 1, 0,
+         0, 0, 1, 0 ;
+  q1 <<  3, 0, 0, 1,
+         0, 0, 1, 0 ;
+  BOOST_CHECK(computeCollisions(model,data,geomModel,geomData,q0) == false);
+  BOOST_CHECK(computeCollisions(model,data,geomModel,geomData,q1) == false);
+  BOOST_CHECK(computeContinuousCollisions(model,data,geomModel,geomData,q0,q1) == true);
+  BOOST_CHECK(geomData.collisionPairIndex == 0);
+
+  // The first box rotates and moves away from the second one.
+  q1 << -3, 2, 0, 1,
+         0, 0, 1, 0 ;
+  BOOST_CHECK(computeContinuousCollisions(model,data,geomModel,geomData,q0,q1) == false);
+
+  // Both boxes translate side by side.
+  q0 <<  0, 0, 1, 0,
+         3, 0, 1, 0 ;
+  q1 <<  0, 2, 1, 0,
+         3, 2, 1, 0 ;
+  BOOST_CHECK(computeContinuousCollisions(model,data,geomModel,geomData,q0,q1) == false);
+}
+
+BOOST_AUTO_TEST_CASE ( continuous_collisions_prismatic_lever_arm )
+{
+  using namespace pinocchio;
+  Model model;
+  GeometryModel geomModel;
+
+  // An arm made of a revolute joint followed by a prismatic one, and a fixed obstacle.
+  // At q0, the prismatic joint is retracted so the lever arm of the revolute joint is zero:
+  // the bound must account for the travel of the prismatic joint along the segment.
+  boost::shared_ptr<fcl::Box> sample(new fcl::Box(0.5, 0.5, 0.5));
+  Model::JointIndex revolute = model.addJoint(0,JointModelRZ(),SE3::Identity(),"revolute");
+  Model::JointIndex prismatic = model.addJoint(revolute,JointModelPX(),SE3::Identity(),"prismatic");
+  model.appendBodyToJoint(prismatic,Inertia::Random(),SE3::Identity());
+  geomModel.addGeometryObject(GeometryObject("arm_collision_object",0,prismatic,
+                                             sample,SE3::Identity(), "", Eigen::Vector3d::Ones()));
+  Model::JointIndex obstacle = model.addJoint(0,JointModelPlanar(),SE3::Identity(),"obstacle");
+  model.appendBodyToJoint(obstacle,Inertia::Random(),SE3::Identity());
+  geomModel.addGeometryObject(GeometryObject("obstacle_collision_object",0,obstacle,
+                                             sample,SE3::Identity(), "", Eigen::Vector3d::Ones()));
+  geomModel.addAllCollisionPairs();
+
+  Data data(model);
+  GeometryData geomData(geomModel);
+  computeBodyRadius(model, geomModel, geomData);
+
+  // The arm sweeps a quarter of a circle while extending: at s = 0.5, the box is at (1.06,1.06), on the obstacle.
+  Eigen::VectorXd q0(model.nq), q1(model.nq);
+  q0 << 0.,     0., 1.06, 1.06, 1., 0.;
+  q1 << M_PI/2, 3., 1.06, 1.06, 1., 0.;
+  BOOST_CHECK(computeCollisions(model,data,geomModel,geomData,q0) == false);
+  BOOST_CHECK(computeCollisions(model,data,geomModel,geomData,q1) == false);
+  BOOST_CHECK(computeContinuousCollisions(model,data,geomModel,geomData,q0,q1) == true);
+
+  // The obstacle is out of reach of the arm.
+  q0.tail<4>() << 5., -5., 1., 0.;
+  q1.tail<4>() << 5., -5., 1., 0.;
+  BOOST_CHECK(computeContinuousCollisions(model,data,geomModel,geomData,q0,q1) == false);
+}
+
+BOOST_AUTO_TEST_CASE ( continuous_collisions_composite )
+{
+  using namespace pinocchio;
+  Model model;
+  GeometryModel geomModel;
+
+  boost::shared_ptr<fcl::Box> sample(new fcl::Box(1, 1, 1));
+  JointModelComposite jmodel_composite((JointModelRX()));
+  jmodel_composite.addJoint(JointModelPY(),SE3::Random());
+  Model::JointIndex idx = model.addJoint(0,jmodel_composite,SE3::Identity(),"composite");
+  model.appendBodyToJoint(idx,Inertia::Random(),SE3::Identity());
+  geomModel.addGeometryObject(GeometryObject("composite_collision_object",0,idx,
+                                             sample,SE3::Identity(), "", Eigen::Vector3d::Ones()));
+  idx = model.addJoint(0,JointModelPlanar(),SE3::Identity(),"planar");
+  model.appendBodyToJoint(idx,Inertia::Random(),SE3::Identity());
+  geomModel.addGeometryObject(GeometryObject("planar_collision_object",0,idx,
+                                             sample,SE3::Identity(), "", Eigen::Vector3d::Ones()));
+  geomModel.addAllCollisionPairs();
+
+  Data data(model);
+  GeometryData geomData(geomModel);
+  computeBodyRadius(model, geomModel, geomData);
+
+  Eigen::VectorXd q0(model.nq), q1(model.nq);
+  q0 << 0., 0., 5., 5., 1., 0.;
+  q1 << 1., 1., 5., 5., 1., 0.;
+  BOOST_CHECK_THROW(computeContinuousCollisions(model,data,geomModel,geomData,q0,q1),std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE ( distance_culling )
+{
+  using namespace pinocchio;
+  Model model;
+  GeometryModel geomModel;
+
+  boost::shared_ptr<fcl::Box> sample(new fcl::Box(1, 1, 1));
+  const char * names[3] = { "planar1", "planar2", "planar3" };
+  for(int k = 0; k < 3; ++k)
+  {
+    const std::string name(names[k]);
+    Model::JointIndex idx = model.addJoint(0,JointModelPlanar(),SE3::Identity(),name + "_joint");
+    model.appendBodyToJoint(idx,Inertia::Random(),SE3::Identity());
+    geomModel.addGeometryObject(GeometryObject(name + "_collision_object",0,idx,
+                                               sample,SE3::Identity(), "", Eigen::Vector3d::Ones()));
+  }
+  geomModel.addAllCollisionPairs();
+  BOOST_REQUIRE(geomModel.collisionPairs.size() == 3);
+
+  Data data(model);
+  GeometryData geomData(geomModel), geomDataRef(geomModel);
+  const double threshold = 0.5;
+
+  // Pair 0: (planar1,planar2), pair 1: (planar1,planar3), pair 2: (planar2,planar3).
+  Eigen::VectorXd q(model.nq);
+  q << -3, 0, 1, 0,
+        0, 0, 1, 0,
+       10, 0, 1, 0 ;
+  // The first call always computes the distances.
+  BOOST_CHECK(computeDistances(model,data,geomModel,geomData,q,threshold) == 0);
+  BOOST_CHECK_CLOSE(geomData.distanceResults[0].min_distance, 2., 1e-6);
+  BOOST_CHECK_CLOSE(geomData.distanceResults[1].min_distance, 12., 1e-6);
+  BOOST_CHECK(geomData.distanceLowerBounds[0] == geomData.distanceResults[0].min_distance);
+
+  // Small motion: all the pairs are farther than the threshold. Only the closest one is evaluated again,
+  // the two other ones are skipped as they cannot be closer, and keep their previous result.
+  q << -2.9, 0.05, std::cos(0.01), std::sin(0.01),
+          0,    0,              1,              0,
+       10.1,    0,              1,              0 ;
+  BOOST_CHECK(computeDistances(model,data,geomModel,geomData,q,threshold) == 0);
+  BOOST_CHECK(computeDistances(model,data,geomModel,geomDataRef,q) == 0);
+  BOOST_CHECK_CLOSE(geomData.distanceResults[0].min_distance, geomDataRef.distanceResults[0].min_distance, 1e-6);
+  BOOST_CHECK_CLOSE(geomData.distanceResults[1].min_distance, 12., 1e-6);
+  BOOST_CHECK_CLOSE(geomData.distanceResults[2].min_distance, 9., 1e-6);
+  BOOST_CHECK(geomData.distanceLowerBounds[1] > threshold);
+  BOOST_CHECK(geomData.distanceLowerBounds[2] > threshold);
+
+  // The true distances are always above the lower bounds.
+  for(std::size_t cp = 0; cp < geomModel.collisionPairs.size(); ++cp)
+    BOOST_CHECK(geomData.distanceLowerBounds[cp] <= geomDataRef.distanceResults[cp].min_distance + 1e-9);
+
+  // Closer than the threshold: the distance is computed again.
+  q << -1.3, 0, 1, 0,
+          0, 0, 1, 0,
+       10.1, 0, 1, 0 ;
+  BOOST_CHECK(computeDistances(model,data,geomModel,geomData,q,threshold) == 0);
+  computeDistances(model,data,geomModel,geomDataRef,q);
+  BOOST_CHECK_CLOSE(geomData.distanceResults[0].min_distance, geomDataRef.distanceResults[0].min_distance, 1e-6);
+  BOOST_CHECK_CLOSE(geomData.distanceResults[0].min_distance, 0.3, 1e-6);
+
+  // The third box moves far away: the lower bound of the pair (planar2,planar3) drops to 0.8, below the distance
+  // of the first pair, but its actual distance is 17.2. The returned index is the one of the smallest distance,
+  // not of the smallest lower bound.
+  q <<   -3, 0, 1, 0,
+          0, 0, 1, 0,
+       18.2, 0, 1, 0 ;
+  BOOST_CHECK(computeDistances(model,data,geomModel,geomData,q,threshold) == 0);
+  BOOST_CHECK(computeDistances(model,data,geomModel,geomDataRef,q) == 0);
+  BOOST_CHECK_CLOSE(geomData.distanceResults[0].min_distance, 2., 1e-6);
+  BOOST_CHECK_CLOSE(geomData.distanceResults[2].min_distance, 17.2, 1e-6);
+
+  // The third box gets the closest one.
+  q << -1.4, 0, 1, 0,
+          0, 0, 1, 0,
+        1.2, 0, 1, 0 ;
+  BOOST_CHECK(computeDistances(model,data,geomModel,geomData,q,threshold) == 2);
+  BOOST_CHECK(computeDistances(model,data,geomModel,geomDataRef,q) == 2);
+  BOOST_CHECK_CLOSE(geomData.distanceResults[2].min_distance, 0.2, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE ( distance_derivatives )
+{
+  using namespace pinocchio;
+  Model model;
+  GeometryModel geomModel;
+
+  boost::shared_ptr<fcl::Box> sample(new fcl::Box(1, 1, 1));
+  const char * names[2] = { "planar1", "planar2" };
+  for(int k = 0; k < 2; ++k)
+  {
+    const std::string name(names[k]);
+    Model::JointIndex idx = model.addJoint(0,JointModelPlanar(),SE3::Identity(),name + "_joint");
+    model.appendBodyToJoint(idx,Inertia::Random(),SE3::Identity());
+    geomModel.addGeometryObject(GeometryObject(name + "_collision_object",0,idx,
+                                               sample,SE3::Identity(), "", Eigen::Vector3d::Ones()));
+  }
+  geomModel.addAllCollisionPairs();
+
+  Data data(model);
+  GeometryData geomData(geomModel);
+
+  Eigen::VectorXd q(model.nq);
+  q << -3, 0.2, std::cos(0.3), std::sin(0.3),
+        0, 0, 1, 0 ;
+
+  Eigen::MatrixXd dd_dq(geomModel.collisionPairs.size(),model.nv);
+  computeDistancesDerivatives(model,data,geomModel,geomData,q,dd_dq);
+  const double d0 = geomData.distanceResults[0].min_distance;
+
+  Eigen::MatrixXd dd_dq_fd(geomModel.collisionPairs.size(),model.nv);
+  Eigen::VectorXd v_eps(Eigen::VectorXd::Zero(model.nv));
+  const double eps = 1e-6;
+  for(int k = 0; k < model.nv; ++k)
+  {
+    v_eps[k] = eps;
+    computeDistances(model,data,geomModel,geomData,integrate(model,q,v_eps));
+    dd_dq_fd(0,k) = (geomData.distanceResults[0].min_distance - d0) / eps;
+    v_eps[k] = 0.;
+  }
+
+  BOOST_CHECK(dd_dq.isApprox(dd_dq_fd,sqrt(eps)));
+}
+
+BOOST_AUTO_TEST_CASE ( distance_derivatives_finite_differences )
+{
+  using namespace pinocchio;
+  Model model;
+  GeometryModel geomModel;
+
+  // A free-flyer carrying a revolute joint, and an obstacle on a planar joint.
+  // The geometries are offset from their joints, so that the world and local frames of the objects differ.
+  boost::shared_ptr<fcl::Sphere> sphere(new fcl::Sphere(0.3));
+  boost::shared_ptr<fcl::Box> box(new fcl::Box(0.4, 0.6, 0.8));
+  Model::JointIndex root = model.addJoint(0,JointModelFreeFlyer(),SE3::Identity(),"root");
+  model.appendBodyToJoint(root,Inertia::Random(),SE3::Identity());
+  Model::JointIndex arm = model.addJoint(root,JointModelRY(),
+                                         SE3(Eigen::Matrix3d::Identity(),Eigen::Vector3d(0.,0.,1.)),"arm");
+  model.appendBodyToJoint(arm,Inertia::Random(),SE3::Identity());
+  Model::JointIndex obstacle = model.addJoint(0,JointModelPlanar(),SE3::Identity(),"obstacle");
+  model.appendBodyToJoint(obstacle,Inertia::Random(),SE3::Identity());
+
+  geomModel.addGeometryObject(GeometryObject("root_collision_object",0,root,
+                                             box,SE3(Eigen::Matrix3d::Identity(),Eigen::Vector3d(0.2,0.,0.)),
+                                             "", Eigen::Vector3d::Ones()));
+  geomModel.addGeometryObject(GeometryObject("arm_collision_object",0,arm,
+                                             sphere,SE3(Eigen::Matrix3d::Identity(),Eigen::Vector3d(0.,0.,0.7)),
+                                             "", Eigen::Vector3d::Ones()));
+  geomModel.addGeometryObject(GeometryObject("obstacle_collision_object",0,obstacle,
+                                             sphere,SE3(Eigen::Matrix3d::Identity(),Eigen::Vector3d(0.5,0.,0.5)),
+                                             "", Eigen::Vector3d::Ones()));
+  geomModel.addAllCollisionPairs();
+
+  Data data(model);
+  GeometryData geomData(geomModel);
+
+  Eigen::VectorXd q(model.nq);
+  q << 0.1, -0.2, 0.3, Eigen::Quaterniond(Eigen::AngleAxisd(0.4,Eigen::Vector3d(1.,2.,3.).normalized())).coeffs(),
+       0.7,
+       2.5, 1., std::cos(0.5), std::sin(0.5);
+
+  const Eigen::DenseIndex num_pairs = (Eigen::DenseIndex)geomModel.collisionPairs.size();
+  Eigen::MatrixXd dd_dq(num_pairs,model.nv);
+  computeDistancesDerivatives(model,data,geomModel,geomData,q,dd_dq);
+
+  Eigen::VectorXd d0(num_pairs);
+  for(Eigen::DenseIndex cp = 0; cp < num_pairs; ++cp)
+  {
+    d0[cp] = geomData.distanceResults[(size_t)cp].min_distance;
+    BOOST_REQUIRE(d0[cp] > 0.);
+  }
+
+  Eigen::MatrixXd dd_dq_fd(num_pairs,model.nv);
+  Eigen::VectorXd v_eps(Eigen::VectorXd::Zero(model.nv));
+  const double eps = 1e-6;
+  for(int k = 0; k < model.nv; ++k)
+  {
+    v_eps[k] = eps;
+    computeDistances(model,data,geomModel,geomData,integrate(model,q,v_eps));
+    for(Eigen::DenseIndex cp = 0; cp < num_pairs; ++cp)
+      dd_dq_fd(cp,k) = (geomData.distanceResults[(size_t)cp].min_distance - d0[cp]) / eps;
+    v_eps[k] = 0.;
+  }
+
+  BOOST_CHECK(dd_dq.isApprox(dd_dq_fd,sqrt(eps)));
+  // The pair (root,arm) only depends on the revolute joint.
+  BOOST_CHECK(dd_dq.row(0).head<6>().isZero());
+}
+
+BOOST_AUTO_TEST_CASE ( parallel_placements )
+{
+  using namespace pinocchio;
+  Model model;
+  GeometryModel geomModel;
+
+  boost::shared_ptr<fcl::Box> sample(new fcl::Box(1, 1, 1));
+  const char * names[2] = { "planar1", "planar2" };
+  for(int k = 0; k < 2; ++k)
+  {
+    const std::string name(names[k]);
+    Model::JointIndex idx = model.addJoint(0,JointModelPlanar(),SE3::Identity(),name + "_joint");
+    model.appendBodyToJoint(idx,Inertia::Random(),SE3::Identity());
+    geomModel.addGeometryObject(GeometryObject(name + "_collision_object",0,idx,
+                                               sample,SE3::Random(), "", Eigen::Vector3d::Ones()));
+  }
+  // Static obstacle
+  geomModel.addGeometryObject(GeometryObject("obstacle",0,0,sample,SE3::Random(), "", Eigen::Vector3d::Ones()));
+  // Placement edited after addGeometryObject
+  geomModel.geometryObjects[1].placement = SE3::Random();
+
+  Data data(model);
+  GeometryData geomData(geomModel), geomDataRef(geomModel);
+  BOOST_CHECK(geomData.movingObjects.size() == 2);
+  BOOST_CHECK(geomData.oMg[2].isApprox(geomModel.geometryObjects[2].placement));
+
+  Eigen::VectorXd q(model.nq);
+  q << -3, 0.2, std::cos(0.3), std::sin(0.3),
+        1, 0.5, 1, 0 ;
+  forwardKinematics(model,data,q);
+  updateGeometryPlacements(model,data,geomModel,geomDataRef);
+  updateGeometryPlacements(model,data,geomModel,geomData,2);
+
+  for(GeomIndex i = 0; i < geomModel.ngeoms; ++i)
+  {
+    BOOST_CHECK(geomData.oMg[i].isApprox(geomDataRef.oMg[i]));
+    BOOST_CHECK(toPinocchioSE3(geomData.collisionObjects[i].getTransform()).isApprox(geomDataRef.oMg[i]));
+  }
+}
+
+BOOST_AUTO_TEST_CASE ( quaternion_placements )
+{
+  using namespace pinocchio;
+  Model model;
+  GeometryModel geomModel;
+
+  boost::shared_ptr<fcl::Box> sample(new fcl::Box(1, 1, 1));
+  Model::JointIndex idx = model.addJoint(0,JointModelFreeFlyer(),SE3::Random(),"ff_joint");
+  model.appendBodyToJoint(idx,Inertia::Random(),SE3::Identity());
+  idx = model.addJoint(idx,JointModelRX(),SE3::Random(),"rx_joint");
+  model.appendBodyToJoint(idx,Inertia::Random(),SE3::Identity());
+  geomModel.addGeometryObject(GeometryObject("ff_collision_object",0,1,sample,SE3::Random(), "", Eigen::Vector3d::Ones()));
+  geomModel.addGeometryObject(GeometryObject("rx_collision_object",0,idx,sample,SE3::Random(), "", Eigen::Vector3d::Ones()));
+  // Static obstacle
+  geomModel.addGeometryObject(GeometryObject("obstacle",0,0,sample,SE3::Random(), "", Eigen::Vector3d::Ones()));
+  // Placement edited after addGeometryObject
+  geomModel.geometryObjects[1].placement = SE3::Random();
+
+  Data data(model), dataRef(model);
+  GeometryData geomData(geomModel), geomDataRef(geomModel);
+  BOOST_CHECK(geomData.oMg_quat.empty());
+
+  model.lowerPositionLimit.fill(-1.);
+  model.upperPositionLimit.fill(1.);
+  Eigen::VectorXd q = randomConfiguration(model);
+  updateGeometryPlacements(model,dataRef,geomModel,geomDataRef,q);
+  updateGeometryPlacementsQuaternion(model,data,geomModel,geomData,q);
+
+  for(GeomIndex i = 0; i < geomModel.ngeoms; ++i)
+  {
+    BOOST_CHECK(geomData.oMg_quat[i].toSE3().isApprox(geomDataRef.oMg[i]));
+    BOOST_CHECK(toPinocchioSE3(geomData.collisionObjects[i].getTransform()).isApprox(geomDataRef.oMg[i]));
+  }
+}
+
 BOOST_AUTO_TEST_CASE ( loading_model )
 {
   typedef pinocchio::Model Model;
@@ -0,0 +1,122 @@
+//
+// Copyright (c) 2018 CNRS
+//
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/multibody/data.hpp"
+#include "pinocchio/algorithm/inverse-kinematics.hpp"
+#include "pinocchio/algorithm/frames.hpp"
+#include "pinocchio/algorithm/joint-configuration.hpp"
+#include "pinocchio/spatial/explog.hpp"
+#include "pinocchio/parsers/sample-models.hpp"
+
+#include <iostream>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/utility/binary.hpp>
+
+BOOST_AUTO_TEST_SUITE ( BOOST_TEST_MODULE )
+
+BOOST_AUTO_TEST_CASE ( test_single_frame_task )
+{
+  using namespace pinocchio;
+  Model model;
+  buildModels::manipulator(model);
+  Data data(model), data_ref(model);
+
+  const Model::FrameIndex frame_id = model.getFrameId("effector_body");
+
+  // Reachable target
+  const Eigen::VectorXd q_ref = randomConfiguration(model);
+  framesForwardKinematics(model,data_ref,q_ref);
+
+  InverseKinematics ik(model);
+  BOOST_CHECK(ik.addFrameTask(frame_id,data_ref.oMf[frame_id]) == 0);
+
+  Eigen::VectorXd q = q_ref + 0.2 * Eigen::VectorXd::Ones(model.nq);
+  q = q.cwiseMax(model.lowerPositionLimit).cwiseMin(model.upperPositionLimit);
+  BOOST_CHECK(ik.solve(data,q));
+  BOOST_CHECK(ik.errorNorm < ik.tolerance);
+  BOOST_CHECK(ik.iterations > 0);
+
+  framesForwardKinematics(model,data,q);
+  BOOST_CHECK(data.oMf[frame_id].isApprox(data_ref.oMf[frame_id],1e-6));
+  BOOST_CHECK((q.array() >= model.lowerPositionLimit.array()).all());
+  BOOST_CHECK((q.array() <= model.upperPositionLimit.array()).all());
+
+  // Already at the solution
+  BOOST_CHECK(ik.solve(data,q));
+  BOOST_CHECK(ik.iterations == 0);
+}
+
+BOOST_AUTO_TEST_CASE ( test_weighted_tasks )
+{
+  using namespace pinocchio;
+  Model model;
+  buildModels::humanoidRandom(model);
+  Data data(model), data_ref(model);
+
+  const Model::FrameIndex rhand = model.getFrameId("rarm6_body");
+  const Model::FrameIndex lhand = model.getFrameId("larm6_body");
+  const Model::FrameIndex lfoot = model.getFrameId("lleg6_body");
+
+  const Eigen::VectorXd q_ref = randomConfiguration(model);
+  framesForwardKinematics(model,data_ref,q_ref);
+
+  // Position of the right hand only, full placement of the left hand and of the left foot.
+  InverseKinematics::Vector6 position_only;
+  position_only << 1., 1., 1., 0., 0., 0.;
+
+  InverseKinematics ik(model);
+  ik.addFrameTask(rhand,data_ref.oMf[rhand],position_only);
+  ik.addFrameTask(lhand,data_ref.oMf[lhand],10.);
+  ik.addFrameTask(lfoot,data_ref.oMf[lfoot]);
+
+  Eigen::VectorXd q = integrate(model,q_ref,Eigen::VectorXd::Constant(model.nv,0.1));
+  BOOST_CHECK(ik.solve(data,q));
+
+  framesForwardKinematics(model,data,q);
+  BOOST_CHECK(data.oMf[rhand].translation().isApprox(data_ref.oMf[rhand].translation(),1e-6));
+  BOOST_CHECK(data.oMf[lhand].isApprox(data_ref.oMf[lhand],1e-6));
+  BOOST_CHECK(data.oMf[lfoot].isApprox(data_ref.oMf[lfoot],1e-6));
+}
+
+BOOST_AUTO_TEST_CASE ( test_batch )
+{
+  using namespace pinocchio;
+  Model model;
+  buildModels::manipulator(model);
+  Data data(model);
+
+  const Model::FrameIndex frame_id = model.getFrameId("effector_body");
+  InverseKinematics ik(model);
+  ik.addFrameTask(frame_id,SE3::Identity());
+
+  const int N = 16;
+  Eigen::MatrixXd Q_ref(model.nq,N), Q(model.nq,N);
+  container::aligned_vector<SE3> targets;
+  for(int j = 0; j < N; ++j)
+  {
+    const Eigen::VectorXd q_ref = randomConfiguration(model);
+    Q_ref.col(j) = q_ref;
+    framesForwardKinematics(model,data,q_ref);
+    targets.push_back(data.oMf[frame_id]);
+
+    Q.col(j) = Q_ref.col(j) + 0.1 * Eigen::VectorXd::Ones(model.nq);
+    Q.col(j) = Q.col(j).cwiseMax(model.lowerPositionLimit).cwiseMin(model.upperPositionLimit);
+  }
+
+  Eigen::MatrixXd Q_serial(Q);
+  BOOST_CHECK(ik.solveBatch(targets,Q_serial) == N);
+  BOOST_CHECK(ik.solveBatch(targets,Q,4) == N);
+  BOOST_CHECK(Q.isApprox(Q_serial));
+
+  for(int j = 0; j < N; ++j)
+  {
+    const Eigen::VectorXd q = Q.col(j);
+    framesForwardKinematics(model,data,q);
+    BOOST_CHECK(log6(targets[(std::size_t)j].actInv(data.oMf[frame_id])).toVector().norm() <= ik.tolerance);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -68,6 +68,48 @@ BOOST_AUTO_TEST_CASE ( test_jacobian )
 
 }
 
+BOOST_AUTO_TEST_CASE ( test_support_spans )
+{
+  using namespace pinocchio;
+
+  pinocchio::Model model;
+  pinocchio::buildModels::humanoidRandom(model);
+  pinocchio::Data data(model);
+
+  BOOST_CHECK(data.supportSpans[0].empty());
+  for(Model::JointIndex i=1; i<(Model::JointIndex)model.njoints; ++i)
+  {
+    // Columns of the supporting joints, obtained by walking the parents row by row
+    std::vector<bool> support((size_t)model.nv,false);
+    const int colRef = model.joints[i].idx_v()+model.joints[i].nv()-1;
+    for(int j=colRef;j>=0;j=data.parents_fromRow[(size_t)j])
+      support[(size_t)j] = true;
+
+    std::vector<bool> support_spans((size_t)model.nv,false);
+    const Data::ColumnSpanVector & spans = data.supportSpans[i];
+    for(size_t k=0; k<spans.size(); ++k)
+    {
+      BOOST_CHECK(spans[k].second > 0);
+      if(k > 0) // sorted and merged
+        BOOST_CHECK(spans[k].first > spans[k-1].first+spans[k-1].second);
+      for(int j=spans[k].first; j<spans[k].first+spans[k].second; ++j)
+        support_spans[(size_t)j] = true;
+    }
+    BOOST_CHECK(support_spans == support);
+  }
+
+  // The root joint and the chain of the first leg are merged into a single span
+  const Model::JointIndex lleg = model.getJointId("lleg6_joint");
+  BOOST_CHECK(data.supportSpans[lleg].size() == 1);
+  BOOST_CHECK(data.supportSpans[lleg][0].first == 0);
+  BOOST_CHECK(data.supportSpans[lleg][0].second == model.joints[lleg].idx_v()+model.joints[lleg].nv());
+
+  // The chain of the second leg is a span of its own
+  const Model::JointIndex rleg = model.getJointId("rleg6_joint");
+  BOOST_CHECK(data.supportSpans[rleg].size() == 2);
+  BOOST_CHECK(data.supportSpans[rleg][1].first == model.joints[model.getJointId("rleg1_joint")].idx_v());
+}
+
 BOOST_AUTO_TEST_CASE ( test_jacobian_time_variation )
 {
   using namespace Eigen;
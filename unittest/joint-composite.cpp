@@ -5,6 +5,7 @@
 #include "pinocchio/multibody/joint/joint-composite.hpp"
 #include "pinocchio/algorithm/joint-configuration.hpp"
 #include "pinocchio/algorithm/kinematics.hpp"
+#include "pinocchio/algorithm/aba.hpp"
 
 #include <boost/test/unit_test.hpp>
 #include <boost/utility/binary.hpp>
@@ -277,5 +278,83 @@ BOOST_AUTO_TEST_CASE(test_kinematics)
   BOOST_CHECK(data.a.back().isApprox(data_c.a.back()));
 }
 
-BOOST_AUTO_TEST_SUITE_END ()
+BOOST_AUTO_TEST_CASE(test_flattened)
+{
+  JointModelComposite jmodel_gimbal((JointModelRZ()));
+  jmodel_gimbal.addJoint(JointModelRY()).addJoint(JointModelRX());
+  BOOST_CHECK(!jmodel_gimbal.isFlattened());
+  jmodel_gimbal.setIndexes(0,0,0);
+  BOOST_CHECK(jmodel_gimbal.isFlattened());
+  
+  JointModelComposite jmodel_not_flat((JointModelRZ()));
+  jmodel_not_flat.addJoint(JointModelSpherical());
+  jmodel_not_flat.setIndexes(0,0,0);
+  BOOST_CHECK(!jmodel_not_flat.isFlattened());
+  BOOST_CHECK(JointModelComposite(jmodel_gimbal).isFlattened());
+  BOOST_CHECK(jmodel_gimbal.cast<double>().isFlattened());
+  
+  // The flat representation follows the joints once setIndexes is called again.
+  {
+    JointModelComposite jmodel_ref((JointModelRZ()));
+    jmodel_ref.addJoint(JointModelRX()).addJoint(JointModelRX());
+    jmodel_ref.setIndexes(0,0,0);
+    
+    jmodel_gimbal.joints[1] = JointModelRX();
+    jmodel_gimbal.setIndexes(0,0,0);
+    BOOST_CHECK(jmodel_gimbal.isFlattened());
+    
+    JointDataComposite jdata_gimbal = jmodel_gimbal.createData(), jdata_ref = jmodel_ref.createData();
+    const VectorXd q(VectorXd::Random(3));
+    jmodel_gimbal.calc(jdata_gimbal,q);
+    jmodel_ref.calc(jdata_ref,q);
+    BOOST_CHECK(jdata_gimbal.M.isApprox(jdata_ref.M));
+    BOOST_CHECK(jdata_gimbal.S.matrix().isApprox(jdata_ref.S.matrix()));
+  }
+  
+  // Universal joint, gimbal and a mixed revolute/prismatic stack, compared to the same chains of simple joints
+  for(int nv = 2; nv <= 4; ++nv)
+  {
+    Model model, model_c;
+    JointModelComposite jmodel_composite;
+    JointIndex parent = 0;
+    for(int k = 0; k < nv; ++k)
+    {
+      const SE3 placement(SE3::Random());
+      if(k == 2)
+      {
+        parent = model.addJoint(parent,JointModelPY(),placement,"joint");
+        jmodel_composite.addJoint(JointModelPY(),placement);
+      }
+      else
+      {
+        const JointModelRevoluteUnaligned jmodel(Eigen::Vector3d::Random().normalized());
+        parent = model.addJoint(parent,jmodel,placement,"joint");
+        jmodel_composite.addJoint(jmodel,placement);
+      }
+    }
+    model.appendBodyToJoint(parent,Inertia::Random());
+    
+    const JointIndex idx_c = model_c.addJoint(0,jmodel_composite,SE3::Identity(),"joint");
+    BOOST_CHECK(boost::get<JointModelComposite>(model_c.joints[idx_c]).isFlattened());
+    model_c.appendBodyToJoint(idx_c,model.inertias.back());
+    
+    Data data(model), data_c(model_c);
+    
+    VectorXd q(VectorXd::Random(model.nq));
+    VectorXd v(VectorXd::Random(model.nv));
+    VectorXd tau(VectorXd::Random(model.nv));
+    
+    forwardKinematics(model,data,q,v);
+    forwardKinematics(model_c,data_c,q,v);
+    
+    BOOST_CHECK(data.oMi.back().isApprox(data_c.oMi.back()));
+    BOOST_CHECK(data.v.back().isApprox(data_c.v.back()));
+    
+    aba(model,data,q,v,tau);
+    aba(model_c,data_c,q,v,tau);
+    
+    BOOST_CHECK(data.ddq.isApprox(data_c.ddq));
+  }
+}
 
+BOOST_AUTO_TEST_SUITE_END ()
@@ -243,4 +243,71 @@ BOOST_AUTO_TEST_CASE ( integrateCoeffWiseJacobian_test )
   BOOST_CHECK(jac.isApprox(jac_fd,sqrt(eps)));
 }
 
+BOOST_AUTO_TEST_CASE ( dDifference_test )
+{
+  Model model; buildModel(model);
+  
+  Eigen::VectorXd q0(randomConfiguration(model)), q1(randomConfiguration(model));
+  Eigen::MatrixXd J0(Eigen::MatrixXd::Zero(model.nv,model.nv)), J1(Eigen::MatrixXd::Zero(model.nv,model.nv));
+  
+  dDifference(model,q0,q1,J0,ARG0);
+  dDifference(model,q0,q1,J1,ARG1);
+  
+  Eigen::MatrixXd J0_fd(model.nv,model.nv), J1_fd(model.nv,model.nv);
+  const Eigen::VectorXd d(difference(model,q0,q1));
+  const double eps = 1e-8;
+  Eigen::VectorXd v_eps(Eigen::VectorXd::Zero(model.nv));
+  for(int k = 0; k < model.nv; ++k)
+  {
+    v_eps[k] = eps;
+    J0_fd.col(k) = (difference(model,integrate(model,q0,v_eps),q1) - d)/eps;
+    J1_fd.col(k) = (difference(model,q0,integrate(model,q1,v_eps)) - d)/eps;
+    v_eps[k] = 0.;
+  }
+  
+  BOOST_CHECK(J0.isApprox(J0_fd,sqrt(eps)));
+  BOOST_CHECK(J1.isApprox(J1_fd,sqrt(eps)));
+}
+
+BOOST_AUTO_TEST_CASE ( trajectory_test )
+{
+  Model model; buildModel(model);
+  
+  const Eigen::DenseIndex T = 5;
+  Eigen::MatrixXd Q0(model.nq,T), Q1(model.nq,T), V(Eigen::MatrixXd::Random(model.nv,T));
+  for(Eigen::DenseIndex t = 0; t < T; ++t)
+  {
+    Q0.col(t) = randomConfiguration(model);
+    Q1.col(t) = randomConfiguration(model);
+  }
+  
+  Eigen::MatrixXd Qout(model.nq,T), Vout(model.nv,T), distances(model.njoints-1,T);
+  Eigen::MatrixXd J(model.nv,T*model.nv), J_ref(model.nv,model.nv);
+  
+  integrateTrajectory(model,Q0,V,Qout);
+  for(Eigen::DenseIndex t = 0; t < T; ++t)
+    BOOST_CHECK(Qout.col(t).isApprox(integrate(model,Q0.col(t),V.col(t))));
+  
+  differenceTrajectory(model,Q0,Q1,Vout);
+  for(Eigen::DenseIndex t = 0; t < T; ++t)
+    BOOST_CHECK(Vout.col(t).isApprox(difference(model,Q0.col(t),Q1.col(t))));
+  
+  interpolateTrajectory(model,Q0,Q1,0.3,Qout);
+  for(Eigen::DenseIndex t = 0; t < T; ++t)
+    BOOST_CHECK(Qout.col(t).isApprox(interpolate(model,Q0.col(t),Q1.col(t),0.3)));
+  
+  squaredDistanceTrajectory(model,Q0,Q1,distances);
+  for(Eigen::DenseIndex t = 0; t < T; ++t)
+    BOOST_CHECK(distances.col(t).isApprox(squaredDistance(model,Q0.col(t),Q1.col(t))));
+  
+  J.setZero();
+  dIntegrateTrajectory(model,Q0,V,J,ARG1);
+  for(Eigen::DenseIndex t = 0; t < T; ++t)
+  {
+    J_ref.setZero();
+    dIntegrate(model,Q0.col(t),V.col(t),J_ref,ARG1);
+    BOOST_CHECK(J.middleCols(t*model.nv,model.nv).isApprox(J_ref));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
@@ -6,6 +6,8 @@
 #include <iostream>
 
 #include "pinocchio/math/fwd.hpp"
+#include "pinocchio/math/matrix.hpp"
+#include "pinocchio/math/quaternion.hpp"
 #include "pinocchio/spatial/force.hpp"
 #include "pinocchio/spatial/motion.hpp"
 #include "pinocchio/spatial/se3.hpp"
@@ -334,6 +336,86 @@ BOOST_AUTO_TEST_CASE (vsFreeFlyer)
 BOOST_AUTO_TEST_SUITE_END ()
 
 
+BOOST_AUTO_TEST_SUITE (JointSpecializedKernels)
+
+/// \brief Random articulated inertia, obtained by adding a random SPD matrix to a random rigid inertia.
+Inertia::Matrix6 randomArticulatedInertia()
+{
+  const Inertia::Matrix6 A(Inertia::Matrix6::Random());
+  return Inertia::Random().matrix() + A*A.transpose();
+}
+
+BOOST_AUTO_TEST_CASE (inverseSymmetric)
+{
+  const Inertia::Matrix6 I(randomArticulatedInertia());
+
+  Eigen::Matrix3d Ainv;
+  inverseSymmetric3x3(I.topLeftCorner<3,3>(),Ainv);
+  BOOST_CHECK(Ainv.isApprox(I.topLeftCorner<3,3>().inverse()));
+
+  Inertia::Matrix6 Iinv;
+  inverseSymmetric6x6(I,Iinv);
+  BOOST_CHECK(Iinv.isApprox(I.inverse()));
+  BOOST_CHECK((Iinv*I).isIdentity(1e-8));
+}
+
+BOOST_AUTO_TEST_CASE (calc)
+{
+  Eigen::Quaterniond quat(Eigen::Vector4d::Random().normalized());
+  Eigen::Matrix3d R;
+  quaternion::toRotationMatrix(quat,R);
+  BOOST_CHECK(R.isApprox(quat.toRotationMatrix()));
+
+  JointModelFreeFlyer jmodel_ff; jmodel_ff.setIndexes(1,0,0);
+  JointDataFreeFlyer jdata_ff(jmodel_ff.createData());
+  Eigen::Matrix<double,7,1> q_ff; q_ff << Eigen::Vector3d::Random(), quat.coeffs();
+  jmodel_ff.calc(jdata_ff,q_ff);
+  BOOST_CHECK(jdata_ff.M.isApprox(SE3(quat.toRotationMatrix(),q_ff.head<3>())));
+
+  JointModelSpherical jmodel_s; jmodel_s.setIndexes(1,0,0);
+  JointDataSpherical jdata_s(jmodel_s.createData());
+  jmodel_s.calc(jdata_s,quat.coeffs());
+  BOOST_CHECK(jdata_s.M.isApprox(SE3(quat.toRotationMatrix(),Eigen::Vector3d::Zero())));
+}
+
+BOOST_AUTO_TEST_CASE (calc_aba)
+{
+  typedef Inertia::Matrix6 Matrix6;
+  const Matrix6 I(randomArticulatedInertia());
+
+  // Free-flyer: S = Id
+  {
+    JointModelFreeFlyer jmodel; jmodel.setIndexes(1,0,0);
+    JointDataFreeFlyer jdata(jmodel.createData());
+    Matrix6 Ia(I);
+    jmodel.calc_aba(jdata,Ia,true);
+
+    BOOST_CHECK(jdata.U.isApprox(I));
+    BOOST_CHECK(jdata.Dinv.isApprox(I.inverse()));
+    BOOST_CHECK(jdata.UDinv.isIdentity());
+    BOOST_CHECK(Ia.isZero());
+  }
+
+  // Spherical: generic formulas with the dense motion subspace
+  {
+    JointModelSpherical jmodel; jmodel.setIndexes(1,0,0);
+    JointDataSpherical jdata(jmodel.createData());
+    Matrix6 Ia(I);
+    jmodel.calc_aba(jdata,Ia,true);
+
+    const Eigen::Matrix<double,6,3> S(jdata.S.matrix());
+    const Eigen::Matrix<double,6,3> U_ref(I*S);
+    const Eigen::Matrix3d Dinv_ref((S.transpose()*U_ref).inverse());
+    const Eigen::Matrix<double,6,3> UDinv_ref(U_ref*Dinv_ref);
+    BOOST_CHECK(jdata.U.isApprox(U_ref));
+    BOOST_CHECK(jdata.Dinv.isApprox(Dinv_ref));
+    BOOST_CHECK(jdata.UDinv.isApprox(UDinv_ref));
+    BOOST_CHECK(Ia.isApprox(I - UDinv_ref*U_ref.transpose(),1e-10));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
 BOOST_AUTO_TEST_SUITE (JointSphericalZYX)
   
   BOOST_AUTO_TEST_CASE(spatial)
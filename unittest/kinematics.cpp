@@ -89,4 +89,81 @@ BOOST_AUTO_TEST_CASE(test_kinematics_second)
   }
 }
 
+BOOST_AUTO_TEST_CASE(test_kinematics_quaternion)
+{
+  using namespace Eigen;
+  using namespace pinocchio;
+  
+  Model model;
+  buildModels::humanoidRandom(model);
+  
+  Data data(model), data_ref(model);
+  BOOST_CHECK(data.oMi_quat.empty());
+  
+  model.lowerPositionLimit.head<3>().fill(-1.);
+  model.upperPositionLimit.head<3>().fill(1.);
+  VectorXd q = randomConfiguration(model);
+  
+  forwardKinematics(model,data_ref,q);
+  forwardKinematicsQuaternion(model,data,q);
+  BOOST_CHECK(data.oMi_quat.size() == (size_t)model.njoints);
+  
+  for(Model::JointIndex i = 0; i < (Model::JointIndex)model.njoints; ++i)
+  {
+    BOOST_CHECK(data.oMi_quat[i].toSE3().isApprox(data_ref.oMi[i]));
+    BOOST_CHECK(data.oMi_quat[i].isApprox(SE3Quaternion(data_ref.oMi[i])));
+  }
+  
+  updateGlobalPlacementsFromQuaternion(model,data);
+  for(Model::JointIndex i = 0; i < (Model::JointIndex)model.njoints; ++i)
+    BOOST_CHECK(data.oMi[i].isApprox(data_ref.oMi[i]));
+}
+
+BOOST_AUTO_TEST_CASE(test_kinematics_quaternion_all_joints)
+{
+  using namespace Eigen;
+  using namespace pinocchio;
+  
+  JointModelComposite jmodel_composite(JointModelRX(),SE3::Random());
+  jmodel_composite.addJoint(JointModelPY(),SE3::Random());
+  
+  Model model;
+  Model::JointIndex idx = 0;
+  idx = model.addJoint(idx,JointModelFreeFlyer(),SE3::Random(),"free_flyer");
+  idx = model.addJoint(idx,JointModelRX(),SE3::Random(),"rx");
+  idx = model.addJoint(idx,JointModelRY(),SE3::Random(),"ry");
+  idx = model.addJoint(idx,JointModelRZ(),SE3::Random(),"rz");
+  idx = model.addJoint(idx,JointModelRUBX(),SE3::Random(),"rubx");
+  idx = model.addJoint(idx,JointModelRUBZ(),SE3::Random(),"rubz");
+  idx = model.addJoint(idx,JointModelPX(),SE3::Random(),"px");
+  idx = model.addJoint(idx,JointModelPZ(),SE3::Random(),"pz");
+  idx = model.addJoint(idx,JointModelSpherical(),SE3::Random(),"spherical");
+  idx = model.addJoint(idx,JointModelSphericalZYX(),SE3::Random(),"spherical_zyx");
+  idx = model.addJoint(idx,JointModelTranslation(),SE3::Random(),"translation");
+  idx = model.addJoint(idx,JointModelPlanar(),SE3::Random(),"planar");
+  idx = model.addJoint(idx,JointModelRevoluteUnaligned(Vector3d::Random().normalized()),SE3::Random(),"revolute_unaligned");
+  idx = model.addJoint(idx,JointModelPrismaticUnaligned(Vector3d::Random().normalized()),SE3::Random(),"prismatic_unaligned");
+  idx = model.addJoint(idx,jmodel_composite,SE3::Random(),"composite");
+  model.addJoint(0,JointModelFreeFlyer(),SE3::Random(),"second_root");
+  
+  // Placements edited after addJoint, including an identity one.
+  model.jointPlacements[2] = SE3::Random();
+  model.jointPlacements[3].rotation().setIdentity();
+  
+  // Angles up to 3 rad cover both branches of the half-angle formula of the revolute joints.
+  model.lowerPositionLimit.fill(-3.);
+  model.upperPositionLimit.fill(3.);
+  
+  Data data(model), data_ref(model);
+  for(int k = 0; k < 20; ++k)
+  {
+    const VectorXd q = randomConfiguration(model);
+    forwardKinematics(model,data_ref,q);
+    forwardKinematicsQuaternion(model,data,q);
+    
+    for(Model::JointIndex i = 1; i < (Model::JointIndex)model.njoints; ++i)
+      BOOST_CHECK(data.oMi_quat[i].toSE3().isApprox(data_ref.oMi[i]));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -3,6 +3,12 @@
 //
 
 #include "pinocchio/multibody/model.hpp"
+#include "pinocchio/multibody/data.hpp"
+#include "pinocchio/algorithm/model.hpp"
+#include "pinocchio/algorithm/check.hpp"
+#include "pinocchio/algorithm/crba.hpp"
+#include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/joint-configuration.hpp"
 #include "pinocchio/parsers/sample-models.hpp"
 
 #include <boost/test/unit_test.hpp>
@@ -43,4 +49,85 @@ BOOST_AUTO_TEST_SUITE ( BOOST_TEST_MODULE )
     BOOST_CHECK(model.cast<long double>().cast<double>() == model);
   }
 
+  BOOST_AUTO_TEST_CASE(test_finalize_model)
+  {
+    Model humanoid;
+    buildModels::humanoidRandom(humanoid);
+
+    // The sample models are already numbered in depth-first order.
+    Model humanoid_finalized;
+    finalizeModel(humanoid,humanoid_finalized);
+    BOOST_CHECK(humanoid_finalized == humanoid);
+
+    // Tree where the joints are added breadth first:
+    //   j1 -> (j2 -> j4, j3)
+    const SE3 M1(SE3::Random()), M2(SE3::Random()), M3(SE3::Random()), M4(SE3::Random());
+    const Inertia I1(Inertia::Random()), I2(Inertia::Random()), I3(Inertia::Random()), I4(Inertia::Random());
+
+    Model model;
+    JointIndex j1 = model.addJoint(0,JointModelFreeFlyer(),M1,"j1");
+    JointIndex j2 = model.addJoint(j1,JointModelRX(),M2,"j2");
+    JointIndex j3 = model.addJoint(j1,JointModelSpherical(),M3,"j3");
+    JointIndex j4 = model.addJoint(j2,JointModelPY(),M4,"j4");
+    model.appendBodyToJoint(j1,I1);
+    model.appendBodyToJoint(j2,I2);
+    model.appendBodyToJoint(j3,I3);
+    model.appendBodyToJoint(j4,I4);
+    for(JointIndex i=1; i<(JointIndex)model.njoints; ++i)
+      model.addJointFrame(i);
+    model.addBodyFrame("b4",j4);
+    model.lowerPositionLimit.setRandom();
+    model.rotorInertia.setRandom();
+
+    BOOST_CHECK(!model.check(Data(model)));
+
+    // Same tree, added in depth-first order.
+    Model model_ref;
+    j1 = model_ref.addJoint(0,JointModelFreeFlyer(),M1,"j1");
+    j2 = model_ref.addJoint(j1,JointModelRX(),M2,"j2");
+    j4 = model_ref.addJoint(j2,JointModelPY(),M4,"j4");
+    j3 = model_ref.addJoint(j1,JointModelSpherical(),M3,"j3");
+    model_ref.appendBodyToJoint(j1,I1);
+    model_ref.appendBodyToJoint(j2,I2);
+    model_ref.appendBodyToJoint(j3,I3);
+    model_ref.appendBodyToJoint(j4,I4);
+
+    Model finalized_model;
+    const std::vector<JointIndex> perm = finalizeModel(model,finalized_model);
+    Data data(finalized_model);
+    BOOST_CHECK(finalized_model.check(data));
+
+    BOOST_CHECK(perm.size() == (size_t)model.njoints);
+    BOOST_CHECK(finalized_model.nq == model.nq);
+    BOOST_CHECK(finalized_model.nv == model.nv);
+    BOOST_CHECK(finalized_model.parents == model_ref.parents);
+    BOOST_CHECK(finalized_model.names == model_ref.names);
+    BOOST_CHECK(finalized_model.subtrees == model_ref.subtrees);
+    BOOST_CHECK(finalized_model.neutralConfiguration == model_ref.neutralConfiguration);
+    BOOST_CHECK(finalized_model.frames[finalized_model.getFrameId("b4",BODY)].parent == j4);
+    for(JointIndex k=1; k<perm.size(); ++k)
+    {
+      const JointModel & jref = model.joints[perm[k]];
+      const JointModel & jmodel = finalized_model.joints[k];
+      BOOST_CHECK(jmodel.id() == k);
+      BOOST_CHECK(jmodel.idx_q() == model_ref.joints[k].idx_q());
+      BOOST_CHECK(jmodel.idx_v() == model_ref.joints[k].idx_v());
+      BOOST_CHECK(finalized_model.inertias[k] == model_ref.inertias[k]);
+      BOOST_CHECK(finalized_model.jointPlacements[k] == model_ref.jointPlacements[k]);
+      BOOST_CHECK(finalized_model.lowerPositionLimit.segment(jmodel.idx_q(),jmodel.nq())
+                  == model.lowerPositionLimit.segment(jref.idx_q(),jref.nq()));
+      BOOST_CHECK(finalized_model.rotorInertia.segment(jmodel.idx_v(),jmodel.nv())
+                  == model.rotorInertia.segment(jref.idx_v(),jref.nv()));
+    }
+
+    const Eigen::VectorXd q = randomConfiguration(model_ref,-Eigen::VectorXd::Ones(model.nq),
+                                                  Eigen::VectorXd::Ones(model.nq));
+    const Eigen::VectorXd v = Eigen::VectorXd::Random(model.nv);
+    const Eigen::VectorXd a = Eigen::VectorXd::Random(model.nv);
+
+    Data data_ref(model_ref);
+    BOOST_CHECK(rnea(finalized_model,data,q,v,a).isApprox(rnea(model_ref,data_ref,q,v,a)));
+    BOOST_CHECK(crba(finalized_model,data,q).isApprox(crba(model_ref,data_ref,q)));
+  }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,91 @@
+//
+// Copyright(c) 2018 CNRS
+//
+
+#ifndef PINOCCHIO_WITH_PROFILER
+  #define PINOCCHIO_WITH_PROFILER
+#endif
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/multibody/data.hpp"
+#include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/aba.hpp"
+#include "pinocchio/algorithm/joint-configuration.hpp"
+#include "pinocchio/parsers/sample-models.hpp"
+#include "pinocchio/utils/profiler.hpp"
+
+#include <iostream>
+#include <sstream>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/utility/binary.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+BOOST_AUTO_TEST_CASE(test_profiler_call_tree)
+{
+  using namespace Eigen;
+  using namespace pinocchio;
+  using namespace pinocchio::profiler;
+
+  Model model;
+  buildModels::humanoidRandom(model);
+  Data data(model);
+
+  model.lowerPositionLimit.head<3>().fill(-1.);
+  model.upperPositionLimit.head<3>().fill(1.);
+  VectorXd q = randomConfiguration(model);
+  VectorXd v(VectorXd::Random(model.nv));
+  VectorXd a(VectorXd::Random(model.nv));
+
+  Profiler & profiler = Profiler::instance();
+  profiler.reset();
+  profiler.setRecordEvents(true);
+
+  const size_t NBT = 10;
+  for(size_t k = 0; k < NBT; ++k)
+  {
+    rnea(model,data,q,v,a);
+    aba(model,data,q,v,a);
+  }
+
+  const Node * rnea_node = profiler.find("rnea");
+  BOOST_REQUIRE(rnea_node != NULL);
+  BOOST_CHECK(rnea_node->count == NBT);
+  BOOST_CHECK(rnea_node->total_ns >= rnea_node->max_ns);
+  BOOST_CHECK(rnea_node->max_ns >= rnea_node->min_ns);
+
+  const Node * forward = profiler.find("rnea/forward pass");
+  const Node * backward = profiler.find("rnea/backward pass");
+  BOOST_REQUIRE(forward != NULL && backward != NULL);
+  BOOST_CHECK(forward->total_ns + backward->total_ns <= rnea_node->total_ns);
+
+  // Scopes are only opened by the algorithms and their passes, not by the joint visits
+  BOOST_CHECK(forward->children.empty());
+  BOOST_CHECK(forward->count == NBT);
+
+  BOOST_CHECK(profiler.find("aba/forward pass 1") != NULL);
+  BOOST_CHECK(profiler.find("aba/backward pass") != NULL);
+  BOOST_CHECK(profiler.find("aba/forward pass 2") != NULL);
+  BOOST_CHECK(profiler.find("crba") == NULL);
+
+  std::ostringstream report;
+  profiler.report(report);
+  BOOST_CHECK(report.str().find("forward pass") != std::string::npos);
+
+  std::ostringstream flame_graph;
+  profiler.writeFlameGraph(flame_graph);
+  BOOST_CHECK(flame_graph.str().find("rnea;forward pass ") != std::string::npos);
+
+  std::ostringstream trace;
+  profiler.writeChromeTrace(trace);
+  BOOST_CHECK(trace.str().find("\"traceEvents\"") != std::string::npos);
+  BOOST_CHECK(profiler.events().size() == 7*NBT); // rnea: 1+2 scopes, aba: 1+3 scopes
+
+  profiler.reset();
+  BOOST_CHECK(profiler.root().children.empty());
+  BOOST_CHECK(profiler.events().empty());
+  profiler.setRecordEvents(false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
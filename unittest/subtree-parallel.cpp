@@ -0,0 +1,137 @@
+//
+// Copyright (c) 2018 CNRS
+//
+
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/multibody/data.hpp"
+#include "pinocchio/algorithm/subtree-parallel.hpp"
+#include "pinocchio/algorithm/joint-configuration.hpp"
+#include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/rnea-derivatives.hpp"
+#include "pinocchio/algorithm/aba.hpp"
+#include "pinocchio/algorithm/aba-derivatives.hpp"
+#include "pinocchio/algorithm/crba.hpp"
+#include "pinocchio/algorithm/model.hpp"
+#include "pinocchio/parsers/sample-models.hpp"
+
+#include <iostream>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/utility/binary.hpp>
+
+namespace
+{
+  /// Records the rank at which each joint is visited.
+  struct VisitOrder
+  {
+    explicit VisitOrder(std::vector<int> & rank) : rank(rank), counter(0) {}
+
+    void operator()(const pinocchio::Model::JointIndex i) const
+    {
+#ifdef PINOCCHIO_WITH_OPENMP
+      #pragma omp critical
+#endif
+      rank[i] = counter++;
+    }
+
+    std::vector<int> & rank;
+    mutable int counter;
+  };
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+BOOST_AUTO_TEST_CASE(test_visit_order)
+{
+  using namespace pinocchio;
+  Model model;
+  buildModels::humanoidRandom(model);
+
+  for(int num_threads = 1; num_threads <= 4; num_threads += 3)
+  {
+    std::vector<int> forward_rank((std::size_t)model.njoints,-1), backward_rank((std::size_t)model.njoints,-1);
+    forwardPassParallel(model,VisitOrder(forward_rank),num_threads);
+    backwardPassParallel(model,VisitOrder(backward_rank),num_threads);
+
+    for(Model::JointIndex i = 1; i < (Model::JointIndex)model.njoints; ++i)
+    {
+      BOOST_CHECK(forward_rank[i] >= 0);
+      BOOST_CHECK(backward_rank[i] >= 0);
+      const Model::JointIndex parent = model.parents[i];
+      if(parent == 0) continue;
+      BOOST_CHECK(forward_rank[parent] < forward_rank[i]);
+      BOOST_CHECK(backward_rank[parent] > backward_rank[i]);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_depth_first_numbering)
+{
+  using namespace pinocchio;
+  Model model;
+  const JointIndex j1 = model.addJoint(0,JointModelRX(),SE3::Random(),"j1");
+  const JointIndex j2 = model.addJoint(j1,JointModelRY(),SE3::Random(),"j2");
+  model.addJoint(j1,JointModelRZ(),SE3::Random(),"j3");
+  model.addJoint(j2,JointModelPX(),SE3::Random(),"j4"); // subtree of j2 is {2,4}
+  
+  std::vector<int> rank((std::size_t)model.njoints,-1);
+  forwardPassParallel(model,VisitOrder(rank),1);
+  backwardPassParallel(model,VisitOrder(rank),1);
+  BOOST_CHECK_THROW(forwardPassParallel(model,VisitOrder(rank),2),std::invalid_argument);
+  BOOST_CHECK_THROW(backwardPassParallel(model,VisitOrder(rank),2),std::invalid_argument);
+  
+  Model finalized_model;
+  finalizeModel(model,finalized_model);
+  forwardPassParallel(finalized_model,VisitOrder(rank),2);
+  backwardPassParallel(finalized_model,VisitOrder(rank),2);
+}
+
+BOOST_AUTO_TEST_CASE(test_algorithms)
+{
+  using namespace Eigen;
+  using namespace pinocchio;
+
+  Model model;
+  buildModels::humanoidRandom(model);
+  Data data(model), data_ref(model);
+
+  model.lowerPositionLimit.head<3>().fill(-1.);
+  model.upperPositionLimit.head<3>().fill(1.);
+  const VectorXd q = randomConfiguration(model);
+  const VectorXd v = VectorXd::Random(model.nv);
+  const VectorXd a = VectorXd::Random(model.nv);
+  const VectorXd tau = VectorXd::Random(model.nv);
+  const int num_threads = 4;
+
+  rnea(model,data_ref,q,v,a);
+  rneaParallel(model,data,q,v,a,num_threads);
+  BOOST_CHECK(data.tau.isApprox(data_ref.tau));
+
+  aba(model,data_ref,q,v,tau);
+  abaParallel(model,data,q,v,tau,num_threads);
+  BOOST_CHECK(data.ddq.isApprox(data_ref.ddq));
+
+  crba(model,data_ref,q);
+  crbaParallel(model,data,q,num_threads);
+  BOOST_CHECK(data.M.triangularView<Upper>().toDenseMatrix().isApprox(data_ref.M.triangularView<Upper>().toDenseMatrix()));
+
+  MatrixXd drnea_dq_ref(MatrixXd::Zero(model.nv,model.nv)), drnea_dq(MatrixXd::Zero(model.nv,model.nv));
+  MatrixXd drnea_dv_ref(MatrixXd::Zero(model.nv,model.nv)), drnea_dv(MatrixXd::Zero(model.nv,model.nv));
+  MatrixXd drnea_da_ref(MatrixXd::Zero(model.nv,model.nv)), drnea_da(MatrixXd::Zero(model.nv,model.nv));
+  computeRNEADerivatives(model,data_ref,q,v,a,drnea_dq_ref,drnea_dv_ref,drnea_da_ref);
+  computeRNEADerivativesParallel(model,data,q,v,a,drnea_dq,drnea_dv,drnea_da,num_threads);
+  BOOST_CHECK(drnea_dq.isApprox(drnea_dq_ref));
+  BOOST_CHECK(drnea_dv.isApprox(drnea_dv_ref));
+  BOOST_CHECK(drnea_da.isApprox(drnea_da_ref));
+
+  MatrixXd daba_dq_ref(MatrixXd::Zero(model.nv,model.nv)), daba_dq(MatrixXd::Zero(model.nv,model.nv));
+  MatrixXd daba_dv_ref(MatrixXd::Zero(model.nv,model.nv)), daba_dv(MatrixXd::Zero(model.nv,model.nv));
+  MatrixXd daba_dtau_ref(MatrixXd::Zero(model.nv,model.nv)), daba_dtau(MatrixXd::Zero(model.nv,model.nv));
+  computeABADerivatives(model,data_ref,q,v,tau,daba_dq_ref,daba_dv_ref,daba_dtau_ref);
+  computeABADerivativesParallel(model,data,q,v,tau,daba_dq,daba_dv,daba_dtau,num_threads);
+  BOOST_CHECK(daba_dq.isApprox(daba_dq_ref));
+  BOOST_CHECK(daba_dv.isApprox(daba_dv_ref));
+  BOOST_CHECK(daba_dtau.isApprox(daba_dtau_ref));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
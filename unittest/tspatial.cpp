@@ -7,6 +7,7 @@
 #include "pinocchio/spatial/force.hpp"
 #include "pinocchio/spatial/motion.hpp"
 #include "pinocchio/spatial/se3.hpp"
+#include "pinocchio/spatial/se3-quaternion.hpp"
 #include "pinocchio/spatial/inertia.hpp"
 #include "pinocchio/spatial/act-on-set.hpp"
 #include "pinocchio/spatial/explog.hpp"
@@ -77,6 +78,55 @@ BOOST_AUTO_TEST_CASE ( test_SE3 )
   BOOST_CHECK(amb_float.isApprox(amb.cast<float>()));
 }
 
+BOOST_AUTO_TEST_CASE ( test_SE3Quaternion )
+{
+  using namespace pinocchio;
+  typedef SE3Quaternion::Vector3 Vector3;
+
+  SE3 amb = SE3::Random();
+  SE3 bmc = SE3::Random();
+  SE3Quaternion amb_quat(amb), bmc_quat(bmc);
+
+  // Test conversions
+  BOOST_CHECK(amb_quat.toSE3().isApprox(amb, 1e-12));
+  SE3 amb_conv; amb_quat.toSE3(amb_conv);
+  BOOST_CHECK(amb_conv.isApprox(amb, 1e-12));
+
+  // Test internal product and inverse
+  BOOST_CHECK((amb_quat*bmc_quat).toSE3().isApprox(amb*bmc, 1e-12));
+  BOOST_CHECK((amb_quat*bmc).toSE3().isApprox(amb*bmc, 1e-12));
+  BOOST_CHECK(amb_quat.actInv(amb_quat*bmc_quat).isApprox(bmc_quat, 1e-12));
+  BOOST_CHECK(amb_quat.inverse().toSE3().isApprox(amb.inverse(), 1e-12));
+  BOOST_CHECK((amb_quat*amb_quat.inverse()).isIdentity(1e-12));
+
+  // Test point action
+  Vector3 p = Vector3::Random();
+  BOOST_CHECK(amb_quat.act(p).isApprox(amb.act(p), 1e-12));
+  BOOST_CHECK(amb_quat.actInv(p).isApprox(amb.actInv(p), 1e-12));
+
+  // Test motion and force actions
+  Motion v = Motion::Random();
+  BOOST_CHECK(amb_quat.act(v).isApprox(amb.act(v), 1e-12));
+  BOOST_CHECK(amb_quat.actInv(v).isApprox(amb.actInv(v), 1e-12));
+  Force f = Force::Random();
+  BOOST_CHECK(amb_quat.act(f).isApprox(amb.act(f), 1e-12));
+  BOOST_CHECK(amb_quat.actInv(f).isApprox(amb.actInv(f), 1e-12));
+
+  // Test isApprox: q and -q define the same rotation
+  SE3Quaternion amb_opp(amb_quat);
+  amb_opp.rotation().coeffs() *= -1.;
+  BOOST_CHECK(amb_opp.isApprox(amb_quat));
+  BOOST_CHECK(amb_opp != amb_quat);
+
+  // Test isIdentity
+  BOOST_CHECK(SE3Quaternion::Identity().isIdentity());
+
+  // Test cast
+  typedef SE3QuaternionTpl<float> SE3Quaternionf;
+  SE3Quaternionf amb_float = amb_quat.cast<float>();
+  BOOST_CHECK(amb_float.isApprox(amb_quat.cast<float>()));
+}
+
 BOOST_AUTO_TEST_CASE ( test_Motion )
 {
   using namespace pinocchio;
@@ -721,6 +771,74 @@ BOOST_AUTO_TEST_CASE ( test_ActOnSet )
   BOOST_CHECK(jF.isApprox(jF_ref,1e-12));
 }
 
+BOOST_AUTO_TEST_CASE(test_ActOnSet_dynamic_width)
+{
+  using namespace pinocchio;
+  typedef Eigen::Matrix<double,6,Eigen::Dynamic> Matrix6x;
+  const SE3 jMi = SE3::Random();
+  const Motion v = Motion::Random();
+  const Inertia I(Inertia::Random());
+  const Force f = Force::Random();
+
+  // Widths around the size of the blocks processed at once
+  for(int N = 1; N <= 3*internal::ACTION_ON_SET_BLOCK_SIZE+1; ++N)
+  {
+    const Matrix6x iS = Matrix6x::Random(6,N+2);
+    const Matrix6x init = Matrix6x::Random(6,N+2);
+    Matrix6x jS(init), jS_ref(init), jS_inplace;
+
+    // Sets given by blocks of a larger matrix
+    motionSet::se3Action<ADDTO>(jMi,iS.middleCols(1,N),jS.middleCols(1,N));
+    jS_ref.middleCols(1,N) += jMi.toActionMatrix() * iS.middleCols(1,N);
+    BOOST_CHECK(jS.isApprox(jS_ref));
+
+    jS = jS_ref = init;
+    motionSet::se3ActionInverse<RMTO>(jMi,iS.middleCols(1,N),jS.middleCols(1,N));
+    jS_ref.middleCols(1,N) -= jMi.inverse().toActionMatrix() * iS.middleCols(1,N);
+    BOOST_CHECK(jS.isApprox(jS_ref));
+
+    jS = jS_ref = init;
+    forceSet::se3Action<ADDTO>(jMi,iS.middleCols(1,N),jS.middleCols(1,N));
+    jS_ref.middleCols(1,N) += jMi.toDualActionMatrix() * iS.middleCols(1,N);
+    BOOST_CHECK(jS.isApprox(jS_ref));
+
+    jS = jS_ref = init;
+    forceSet::se3ActionInverse<RMTO>(jMi,iS.middleCols(1,N),jS.middleCols(1,N));
+    jS_ref.middleCols(1,N) -= jMi.inverse().toDualActionMatrix() * iS.middleCols(1,N);
+    BOOST_CHECK(jS.isApprox(jS_ref));
+
+    jS = jS_ref = init;
+    motionSet::motionAction<ADDTO>(v,iS.middleCols(1,N),jS.middleCols(1,N));
+    jS_ref.middleCols(1,N) += v.toActionMatrix() * iS.middleCols(1,N);
+    BOOST_CHECK(jS.isApprox(jS_ref));
+
+    jS = jS_ref = init;
+    forceSet::motionAction<ADDTO>(v,iS.middleCols(1,N),jS.middleCols(1,N));
+    jS_ref.middleCols(1,N) += v.toDualActionMatrix() * iS.middleCols(1,N);
+    BOOST_CHECK(jS.isApprox(jS_ref));
+
+    jS = jS_ref = init;
+    motionSet::inertiaAction<ADDTO>(I,iS.middleCols(1,N),jS.middleCols(1,N));
+    jS_ref.middleCols(1,N) += I.matrix() * iS.middleCols(1,N);
+    BOOST_CHECK(jS.isApprox(jS_ref));
+
+    jS = jS_ref = init;
+    motionSet::act<ADDTO>(iS.middleCols(1,N),f,jS.middleCols(1,N));
+    for(int k = 0; k < N; ++k)
+      jS_ref.col(k+1) += Motion(iS.col(k+1)).cross(f).toVector();
+    BOOST_CHECK(jS.isApprox(jS_ref));
+
+    // The input and output sets may be the same matrix
+    jS_inplace = iS;
+    motionSet::se3Action(jMi,jS_inplace,jS_inplace);
+    BOOST_CHECK(jS_inplace.isApprox(jMi.toActionMatrix() * iS));
+
+    jS_inplace = iS;
+    forceSet::se3ActionInverse(jMi,jS_inplace,jS_inplace);
+    BOOST_CHECK(jS_inplace.isApprox(jMi.inverse().toDualActionMatrix() * iS));
+  }
+}
+
 BOOST_AUTO_TEST_CASE(test_skew)
 {
   using namespace pinocchio;
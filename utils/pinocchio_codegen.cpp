@@ -0,0 +1,209 @@
+//
+// Copyright (c) 2018 CNRS
+//
+// Generates ahead of time the C sources of the code-generated algorithms for a given URDF model,
+// together with a stable header, so that they can be compiled and linked statically without any
+// runtime compiler.
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+#include "pinocchio/parsers/urdf.hpp"
+#include "pinocchio/codegen/code-generator-algo.hpp"
+
+using namespace std;
+
+void usage (const char* application_name) {
+  cerr << "Usage: " << application_name << " [options] <model.urdf> <output_directory> <name> <algorithm> [<algorithm> ...]" << endl;
+  cerr << "  Writes <output_directory>/<name>.c and <output_directory>/<name>.hpp" << endl;
+  cerr << "  --free-flyer              adds a free flyer as root joint of the model" << endl;
+  cerr << "  --jacobian                also generates the Jacobian of the algorithms" << endl;
+  cerr << "  --batch                   also generates the batched evaluation of the algorithms" << endl;
+  cerr << "  -h | --help               print this help" << endl;
+  cerr << "  Algorithms: rnea, aba, crba, minv, partial_rnea, partial_aba," << endl;
+  cerr << "              frames_fk, frame_jacobians, ccrba, dccrba, jacobian_com, partial_centroidal" << endl;
+  exit (1);
+}
+
+struct GeneratedFunction
+{
+  std::string name;
+  std::string description;
+  Eigen::DenseIndex input_dim, output_dim;
+  bool jacobian, batch;
+};
+
+template<typename CodeGen>
+GeneratedFunction generate(CodeGen & code_gen,
+                           const std::string & c_name,
+                           const std::string & description,
+                           const bool jacobian, const bool batch,
+                           std::ostream & source, std::ostream & declarations)
+{
+  code_gen.setBuildJacobian(jacobian);
+  code_gen.setBuildBatch(batch);
+  code_gen.generateStandaloneSource(source,c_name);
+
+  declarations << "/* " << description << " */\n";
+  code_gen.generateStandaloneDeclarations(declarations,c_name);
+  declarations << "\n";
+
+  GeneratedFunction fun;
+  fun.name = c_name; fun.description = description;
+  fun.input_dim = code_gen.getInputDimension();
+  fun.output_dim = code_gen.getOutputDimension();
+  fun.jacobian = jacobian; fun.batch = batch;
+  return fun;
+}
+
+int main(int argc, char *argv[])
+{
+  using namespace pinocchio;
+
+  bool with_ff = false, jacobian = false, batch = false;
+  std::vector<std::string> arguments;
+
+  for (int i = 1; i < argc; i++) {
+    if (string(argv[i]) == "--free-flyer")
+      with_ff = true;
+    else if (string(argv[i]) == "--jacobian")
+      jacobian = true;
+    else if (string(argv[i]) == "--batch")
+      batch = true;
+    else if (string(argv[i]) == "-h" || string (argv[i]) == "--help")
+      usage(argv[0]);
+    else
+      arguments.push_back(argv[i]);
+  }
+
+  if (arguments.size() < 4)
+    usage(argv[0]);
+
+  const std::string & filename = arguments[0];
+  const std::string & output_directory = arguments[1];
+  const std::string & name = arguments[2];
+
+  Model model;
+  if(with_ff)
+    urdf::buildModel(filename,JointModelFreeFlyer(),model);
+  else
+    urdf::buildModel(filename,model);
+
+  std::vector<Model::FrameIndex> frame_ids;
+  std::ostringstream frame_names;
+  for(Model::FrameIndex k = 0; k < (Model::FrameIndex)model.nframes; ++k)
+  {
+    if(model.frames[k].type == BODY)
+    {
+      frame_ids.push_back(k);
+      frame_names << " " << model.frames[k].name;
+    }
+  }
+
+  std::ostringstream source, declarations;
+  std::vector<GeneratedFunction> functions;
+
+  for(size_t k = 3; k < arguments.size(); ++k)
+  {
+    const std::string & algo = arguments[k];
+    const std::string c_name = name + "_" + algo;
+
+#define PINOCCHIO_GENERATE(CodeGenType,description)                                           \
+    {                                                                                         \
+      CodeGenType<double> code_gen(model);                                                    \
+      functions.push_back(generate(code_gen,c_name,description,jacobian,batch,source,declarations)); \
+    }
+#define PINOCCHIO_GENERATE_FRAMES(CodeGenType,description)                                    \
+    {                                                                                         \
+      CodeGenType<double> code_gen(model,frame_ids);                                          \
+      functions.push_back(generate(code_gen,c_name,description,jacobian,batch,source,declarations)); \
+    }
+
+    if(algo == "rnea")
+      PINOCCHIO_GENERATE(CodeGenRNEA,"x = [q, v, a], y = tau")
+    else if(algo == "aba")
+      PINOCCHIO_GENERATE(CodeGenABA,"x = [q, v, tau], y = ddq")
+    else if(algo == "crba")
+      PINOCCHIO_GENERATE(CodeGenCRBA,"x = q, y = upper triangular part of M, stored row-wise")
+    else if(algo == "minv")
+      PINOCCHIO_GENERATE(CodeGenMinv,"x = q, y = upper triangular part of Minv, stored row-wise")
+    else if(algo == "partial_rnea")
+      PINOCCHIO_GENERATE(CodeGenRNEADerivatives,"x = [q, v, a], y = [dtau_dq, dtau_dv, dtau_da], each row-major")
+    else if(algo == "partial_aba")
+      PINOCCHIO_GENERATE(CodeGenABADerivatives,"x = [q, v, tau], y = [dddq_dq, dddq_dv, dddq_dtau], each row-major")
+    else if(algo == "frames_fk")
+      PINOCCHIO_GENERATE_FRAMES(CodeGenFramesForwardKinematics,"x = q, y = [translation, column-major rotation] of the frames" + frame_names.str())
+    else if(algo == "frame_jacobians")
+      PINOCCHIO_GENERATE_FRAMES(CodeGenFrameJacobians,"x = q, y = row-major 6xnv LOCAL Jacobians of the frames" + frame_names.str())
+    else if(algo == "ccrba")
+      PINOCCHIO_GENERATE(CodeGenCCRBA,"x = [q, v], y = row-major Ag")
+    else if(algo == "dccrba")
+      PINOCCHIO_GENERATE(CodeGenDCCRBA,"x = [q, v], y = [Ag, dAg], each row-major")
+    else if(algo == "jacobian_com")
+      PINOCCHIO_GENERATE(CodeGenJacobianCenterOfMass,"x = q, y = [com, row-major Jcom]")
+    else if(algo == "partial_centroidal")
+      PINOCCHIO_GENERATE(CodeGenCentroidalDynamicsDerivatives,"x = [q, v, a], y = [dhdot_dq, dhdot_dv, dhdot_da], each row-major")
+    else
+    {
+      cerr << "Unknown algorithm: " << algo << endl;
+      usage(argv[0]);
+    }
+
+#undef PINOCCHIO_GENERATE
+#undef PINOCCHIO_GENERATE_FRAMES
+  }
+
+  const std::string source_filename = output_directory + "/" + name + ".c";
+  std::ofstream source_file(source_filename.c_str());
+  source_file << "/* Generated by pinocchio_codegen from " << filename << ". Do not edit. */\n\n"
+              << "#include <math.h>\n\n"
+              << source.str();
+
+  const std::string header_filename = output_directory + "/" + name + ".hpp";
+  std::ofstream header(header_filename.c_str());
+  header << "//\n"
+         << "// Generated by pinocchio_codegen from " << filename << ". Do not edit.\n"
+         << "//\n\n"
+         << "#ifndef __" << name << "_hpp__\n"
+         << "#define __" << name << "_hpp__\n\n"
+         << "#ifdef __cplusplus\n"
+         << "extern \"C\" {\n"
+         << "#endif\n\n"
+         << declarations.str()
+         << "#ifdef __cplusplus\n"
+         << "}\n\n"
+         << "namespace " << name << "\n"
+         << "{\n"
+         << "  enum { nq = " << model.nq << ", nv = " << model.nv << " };\n";
+
+  for(size_t k = 0; k < functions.size(); ++k)
+  {
+    const GeneratedFunction & fun = functions[k];
+    header << "  \n"
+           << "  /// \\brief " << fun.description << "\n"
+           << "  struct " << fun.name.substr(name.size()+1) << "\n"
+           << "  {\n"
+           << "    enum { input_dim = " << fun.input_dim << ", output_dim = " << fun.output_dim << " };\n"
+           << "    static void eval(double const * x, double * y) { " << fun.name << "(x,y); }\n";
+    if(fun.jacobian)
+      header << "    static void jacobian(double const * x, double * jac) { " << fun.name << "_jacobian(x,jac); }\n";
+    if(fun.batch)
+      header << "    static void batch(double const * X, double * Y, unsigned long n) { " << fun.name << "_batch(X,Y,n); }\n";
+    header << "  };\n";
+  }
+
+  header << "}\n"
+         << "#endif // ifdef __cplusplus\n\n"
+         << "#endif // ifndef __" << name << "_hpp__\n";
+
+  if(!source_file.good() || !header.good())
+  {
+    cerr << "Unable to write " << source_filename << " and " << header_filename << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}